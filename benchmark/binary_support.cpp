@@ -0,0 +1,115 @@
+/* Benchmark the binary codec against iostreams serialisation
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++14 binary_support.cpp
+
+Prints a CSV of nanoseconds per record, and bytes per record, to serialise
+and deserialise RECORDS results with the binary codec into a preallocated
+buffer, and with the iostreams operators into a std::stringstream, as a
+write ahead log of per operation outcomes might.
+*/
+
+#include "../include/outcome/binary_support.hpp"
+#include "../include/outcome/iostream_support.hpp"
+
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+#define RECORDS 1000000
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+
+static double ns_per_record(std::chrono::high_resolution_clock::time_point begin)
+{
+  auto end = std::chrono::high_resolution_clock::now();
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / RECORDS;
+}
+
+// The iostreams operators cannot deserialise non-trivially copyable values, so that is skipped for them
+template <class T> static void decode_iostream(std::stringstream &ss, T &v, size_t &checksum, std::true_type /*unused*/)
+{
+  for(size_t n = 0; n < RECORDS; n++)
+  {
+    ss >> v;
+    checksum += v.has_value();
+  }
+}
+template <class T> static void decode_iostream(std::stringstream & /*unused*/, T & /*unused*/, size_t & /*unused*/, std::false_type /*unused*/) {}
+
+template <class T, bool decodable> static void benchmark(const char *name, const std::vector<T> &records)
+{
+  T v = records[0];
+  size_t checksum = 0;
+  // Binary
+  std::vector<char> buffer(RECORDS * 64);
+  auto begin = std::chrono::high_resolution_clock::now();
+  size_t length = 0;
+  for(const auto &r : records)
+  {
+    length += outcome::binary_encode(buffer.data() + length, buffer.size() - length, r);
+  }
+  const double binary_encode = ns_per_record(begin);
+  begin = std::chrono::high_resolution_clock::now();
+  for(size_t offset = 0; offset < length;)
+  {
+    offset += outcome::binary_decode(v, buffer.data() + offset, length - offset);
+    checksum += v.has_value();
+  }
+  const double binary_decode = ns_per_record(begin);
+  // iostreams
+  std::stringstream ss;
+  begin = std::chrono::high_resolution_clock::now();
+  for(const auto &r : records)
+  {
+    ss << r << " ";
+  }
+  const double iostream_encode = ns_per_record(begin);
+  const size_t iostream_length = ss.str().size();
+  begin = std::chrono::high_resolution_clock::now();
+  decode_iostream(ss, v, checksum, std::integral_constant<bool, decodable>());
+  const double iostream_decode = decodable ? ns_per_record(begin) : 0;
+  printf("%s,%f,%f,%f,%f,%f,%f,%zu\n", name, binary_encode, binary_decode, static_cast<double>(length) / RECORDS, iostream_encode, iostream_decode, static_cast<double>(iostream_length) / RECORDS, checksum);
+}
+
+int main()
+{
+  std::vector<outcome::result<unsigned, int>> ints;
+  std::vector<outcome::result<std::string, int>> strings;
+  std::vector<outcome::outcome<int, std::string, long>> outcomes;
+  for(int n = 0; n < RECORDS; n++)
+  {
+    const bool failed = (n % 16) == 0;
+    ints.push_back(failed ? outcome::result<unsigned, int>(outcome::failure(n)) : outcome::result<unsigned, int>(outcome::success(static_cast<unsigned>(n))));
+    strings.push_back(failed ? outcome::result<std::string, int>(outcome::failure(n)) : outcome::result<std::string, int>(std::to_string(n)));
+    outcomes.push_back(failed ? outcome::outcome<int, std::string, long>(outcome::failure("failed")) : outcome::outcome<int, std::string, long>(outcome::success(n)));
+  }
+  printf("type,binary encode ns,binary decode ns,binary bytes,iostream encode ns,iostream decode ns,iostream bytes,checksum\n");
+  benchmark<outcome::result<unsigned, int>, true>("result<unsigned, int>", ints);
+  benchmark<outcome::result<std::string, int>, false>("result<string, int>", strings);
+  benchmark<outcome::outcome<int, std::string, long>, true>("outcome<int, string, long>", outcomes);
+  return 0;
+}
@@ -0,0 +1,103 @@
+#!/usr/bin/python
+# Benchmark the compile time saved by the outcome_instantiations library
+# (C) 2019 Niall Douglas http://www.nedproductions.biz/
+# Created: Oct 2019
+#
+# Generates a synthetic project of SOURCES translation units (500 by default),
+# each of which uses the common results and outcomes in the same way typical
+# code does, and times compiling all of them with the instantiations declared
+# extern, and with OUTCOME_DISABLE_EXTERN_INSTANTIATIONS so each translation
+# unit instantiates them itself. Both include the same headers, so the
+# difference is purely the cost of instantiation and code generation.
+# Writes results-compile-instantiations.csv.
+#
+# Usage: compile_instantiations.py [SOURCES] [compiler] [jobs]
+
+from __future__ import print_function
+import sys, os, subprocess, shlex, time, shutil, tempfile
+from multiprocessing.pool import ThreadPool
+
+SOURCES = int(sys.argv[1]) if len(sys.argv) > 1 else 500
+COMPILER = sys.argv[2] if len(sys.argv) > 2 else 'g++'
+JOBS = int(sys.argv[3]) if len(sys.argv) > 3 else (os.cpu_count() if hasattr(os, 'cpu_count') else 1)
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+source = r'''#include "outcome/instantiations.hpp"
+#include "outcome/try.hpp"
+
+using namespace OUTCOME_V2_NAMESPACE;
+
+extern result<int> parse%(n)d(const std::string &s);
+extern result<void> check%(n)d(int v);
+
+outcome<std::string> funct%(n)d(const std::string &s)
+{
+  OUTCOME_TRY(v, parse%(n)d(s));
+  OUTCOME_TRYV(check%(n)d(v));
+  result<std::string> r(s + s);
+  if(r.has_error())
+  {
+    return r.error();
+  }
+  outcome<int> o(v);
+  if(!o)
+  {
+    return o.as_failure();
+  }
+  return std::move(r).value() + std::to_string(o.value());
+}
+
+experimental::status_result<int> status%(n)d(int v)
+{
+  if(v < 0)
+  {
+    return experimental::errc::invalid_argument;
+  }
+  experimental::status_result<void> r(experimental::success());
+  if(r.has_error())
+  {
+    return std::move(r).error();
+  }
+  return v;
+}
+'''
+
+configurations = [
+    ('extern', ''),
+    ('implicit', '-DOUTCOME_DISABLE_EXTERN_INSTANTIATIONS=1'),
+]
+optimisations = ['-O0', '-O2']
+
+def compile_all(workdir, args):
+    def one(n):
+        subprocess.check_call(args + ['-c', 'source%04d.cpp' % n, '-o', 'source%04d.o' % n], cwd=workdir)
+    begin = time.time()
+    pool = ThreadPool(JOBS)
+    try:
+        pool.map(one, range(0, SOURCES))
+    finally:
+        pool.close()
+    return time.time() - begin
+
+def object_bytes(workdir):
+    return sum(os.path.getsize(os.path.join(workdir, 'source%04d.o' % n)) for n in range(0, SOURCES))
+
+workdir = tempfile.mkdtemp()
+try:
+    for n in range(0, SOURCES):
+        with open(os.path.join(workdir, 'source%04d.cpp' % n), 'wt') as oh:
+            oh.write(source % {'n': n})
+    with open('results-compile-instantiations.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Optimisation","Configuration","Sources","Seconds","Object bytes"\n')
+        for opt in optimisations:
+            for name, defines in configurations:
+                args = shlex.split('%s -std=c++14 %s %s -I%s' % (COMPILER, opt, defines, os.path.join(HERE, '..', 'include')))
+                args += shlex.split(os.environ.get('CXXFLAGS', ''))
+                print("Compiling", SOURCES, "sources with", opt, name, "...")
+                secs = compile_all(workdir, args)
+                line = '"%s","%s","%s",%d,%f,%d' % (COMPILER, opt, name, SOURCES, secs, object_bytes(workdir))
+                print(line)
+                resultsh.write(line + '\n')
+                resultsh.flush()
+finally:
+    shutil.rmtree(workdir)
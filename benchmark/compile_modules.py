@@ -0,0 +1,117 @@
+#!/usr/bin/python
+# Benchmark the compile time of `#include <outcome.hpp>` against `import outcome;`
+# (C) 2019 Niall Douglas http://www.nedproductions.biz/
+# Created: Oct 2019
+#
+# Builds the C++ Module interface include/outcome.ixx once, then compiles each
+# test in test/tests twice: as it is, and with its includes of the Outcome
+# headers which the Module provides replaced by `import outcome;` and the
+# textual "outcome/try_macros.hpp". Tests including Outcome headers which are not
+# part of the Module are skipped. Tests which fail to compile are recorded as
+# such, as some compilers cannot yet import a Module after the standard library
+# has been included. Writes results-compile-modules.csv.
+#
+# Usage: compile_modules.py [compiler] [jobs]
+
+from __future__ import print_function
+import sys, os, re, subprocess, shlex, time, shutil, tempfile, glob
+from multiprocessing.pool import ThreadPool
+
+COMPILER = sys.argv[1] if len(sys.argv) > 1 else 'g++'
+JOBS = int(sys.argv[2]) if len(sys.argv) > 2 else (os.cpu_count() if hasattr(os, 'cpu_count') else 1)
+HERE = os.path.dirname(os.path.abspath(__file__))
+INCLUDE = os.path.abspath(os.path.join(HERE, '..', 'include'))
+TESTS = os.path.abspath(os.path.join(HERE, '..', 'test', 'tests'))
+
+# The headers include/outcome.ixx exports
+module_headers = ['outcome.hpp', 'outcome/outcome.hpp', 'outcome/result.hpp', 'outcome/try.hpp', 'outcome/iostream_support.hpp',
+                  'outcome/std_outcome.hpp', 'outcome/std_result.hpp', 'outcome/utils.hpp', 'outcome/experimental/status_outcome.hpp',
+                  'outcome/experimental/status_result.hpp']
+include_re = re.compile(r'^\s*#\s*include\s*[<"](?:\.\./)*(?:include/)?(outcome[./][^>"]*)[>"]')
+
+def as_import(text):
+    """Returns the source with the Module's headers imported, or None if it uses other Outcome headers"""
+    out, imported = [], False
+    for line in text.splitlines(True):
+        m = include_re.match(line)
+        if m:
+            if m.group(1) not in module_headers:
+                return None
+            if not imported:
+                out.append('import outcome;\n#include "outcome/try_macros.hpp"\n')
+                imported = True
+            continue
+        out.append(line)
+    return ''.join(out) if imported else None
+
+if COMPILER.endswith('cl') or COMPILER.endswith('cl.exe'):
+    interface_args = ['/interface', '/ifcOutput', 'outcome.ifc', '/TP']
+    import_args = ['/reference', 'outcome=outcome.ifc']
+    std, compile_only, output = '/std:c++latest', '/c', '/Fo'
+else:
+    interface_args = ['-x', 'c++']
+    import_args = ['-fmodules-ts', '-fmodule-mapper=outcome.map']
+    std, compile_only, output = '-std=c++20', '-c', '-o'
+    if 'clang' in COMPILER:
+        interface_args = ['--precompile', '-x', 'c++-module']
+        import_args = ['-fmodule-file=outcome=outcome.pcm']
+
+def compile_one(workdir, args, source, obj):
+    begin = time.time()
+    ok = subprocess.call(args + [compile_only, source] + ([output + obj] if output.startswith('/') else [output, obj]), cwd=workdir,
+                         stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL) == 0
+    return ok, time.time() - begin
+
+workdir = tempfile.mkdtemp()
+try:
+    args = shlex.split('%s %s -I%s' % (COMPILER, std, INCLUDE)) + shlex.split(os.environ.get('CXXFLAGS', ''))
+    with open(os.path.join(workdir, 'outcome.map'), 'wt') as oh:
+        oh.write('outcome %s\n' % os.path.join(workdir, 'outcome.gcm'))
+    print("Building the Outcome Module ...")
+    interface_obj = 'outcome.pcm' if 'clang' in COMPILER else 'outcome.o'
+    ok, module_secs = compile_one(workdir, args + import_args + interface_args, os.path.join(INCLUDE, 'outcome.ixx'), interface_obj)
+    if not ok:
+        print("FATAL: The Outcome Module failed to build with", COMPILER, file=sys.stderr)
+        sys.exit(1)
+    print("Module built in", module_secs, "seconds")
+    tests = []
+    for path in sorted(glob.glob(os.path.join(TESTS, '*.cpp'))):
+        with open(path, 'rt') as ih:
+            text = ih.read()
+        imported = as_import(text)
+        if imported is None:
+            continue
+        name = os.path.splitext(os.path.basename(path))[0]
+        # Relative includes of the tests must still resolve from the work directory
+        with open(os.path.join(workdir, name + '-include.cpp'), 'wt') as oh:
+            oh.write(text.replace('"../../include/', '"'))
+        with open(os.path.join(workdir, name + '-import.cpp'), 'wt') as oh:
+            oh.write(imported.replace('"../../include/', '"'))
+        tests.append(name)
+
+    def one(name):
+        inc = compile_one(workdir, args, name + '-include.cpp', name + '-include.o')
+        imp = compile_one(workdir, args + import_args, name + '-import.cpp', name + '-import.o')
+        return name, inc, imp
+
+    pool = ThreadPool(JOBS)
+    try:
+        results = pool.map(one, tests)
+    finally:
+        pool.close()
+    with open('results-compile-modules.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Test","Include seconds","Import seconds","Include compiled","Import compiled"\n')
+        resultsh.write('"%s","(module interface)",0,%f,1,1\n' % (COMPILER, module_secs))
+        totals = [0.0, 0.0]
+        for name, inc, imp in results:
+            line = '"%s","%s",%f,%f,%d,%d' % (COMPILER, name, inc[1], imp[1], inc[0], imp[0])
+            print(line)
+            resultsh.write(line + '\n')
+            if inc[0] and imp[0]:
+                totals[0] += inc[1]
+                totals[1] += imp[1]
+        line = '"%s","(total where both compiled)",%f,%f,1,1' % (COMPILER, totals[0], totals[1])
+        print(line)
+        resultsh.write(line + '\n')
+finally:
+    shutil.rmtree(workdir)
@@ -0,0 +1,242 @@
+#!/usr/bin/python
+# Break down the compile time cost of Outcome's headers and templates
+# (C) 2019 Niall Douglas http://www.nedproductions.biz/
+# Created: Oct 2019
+#
+# Generates a translation unit with VALUES x ERRORS distinct result<T_i, E_j>,
+# each constructed in every way the constructor predicates of basic_result and
+# basic_outcome have to choose between, and writes to results-compile-time-trace.csv
+# rows of:
+#
+#  - "header": the time to compile a translation unit including only that header.
+#  - "construct": the extra time each way of constructing adds to a translation
+#    unit which only instantiates the types.
+#  - "phase": each line of GCC's -ftime-report for the whole translation unit.
+#  - "template": for clang, the inclusive time -ftime-trace attributes to each
+#    template instantiated, summed over all its template arguments.
+#  - "source": for clang, the inclusive time -ftime-trace attributes to each header.
+#
+# Names are stable between commits (the namespace permutation hash and template
+# arguments are removed), so the CSVs of two commits can be compared with:
+#
+#   compile_time_trace.py diff old.csv new.csv
+#
+# Usage: compile_time_trace.py [VALUES] [ERRORS] [compiler] [repeats]
+
+from __future__ import print_function
+import sys, os, re, subprocess, shlex, time, shutil, tempfile, glob, json
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+INCLUDE = os.path.abspath(os.path.join(HERE, '..', 'include'))
+
+
+def diff(oldpath, newpath):
+    def load(path):
+        rows = {}
+        with open(path, 'rt') as ih:
+            next(ih)
+            for line in ih:
+                fields = [f.strip('"') for f in line.rstrip('\n').split(',')]
+                rows[(fields[1], fields[2])] = float(fields[4])
+        return rows
+    old, new = load(oldpath), load(newpath)
+    print('"Kind","Name","Old milliseconds","New milliseconds","Change milliseconds","Change percent"')
+    for key in sorted(set(old) | set(new), key=lambda k: (k[0], -abs(new.get(k, 0) - old.get(k, 0)))):
+        o, n = old.get(key, 0), new.get(key, 0)
+        print('"%s","%s",%f,%f,%f,%s' % (key[0], key[1], o, n, n - o, ('%f' % ((n - o) * 100 / o)) if o else ''))
+
+if len(sys.argv) > 1 and sys.argv[1] == 'diff':
+    diff(sys.argv[2], sys.argv[3])
+    sys.exit(0)
+
+VALUES = int(sys.argv[1]) if len(sys.argv) > 1 else 20
+ERRORS = int(sys.argv[2]) if len(sys.argv) > 2 else 10
+COMPILER = sys.argv[3] if len(sys.argv) > 3 else 'g++'
+REPEATS = int(sys.argv[4]) if len(sys.argv) > 4 else 3
+CLANG = 'clang' in COMPILER
+
+prologue = r'''#include "outcome/std_outcome.hpp"
+#include "outcome/std_result.hpp"
+#include "outcome/try.hpp"
+
+namespace oc = OUTCOME_V2_NAMESPACE;
+template <class T, class E> using res = oc::basic_result<T, E, oc::policy::terminate>;
+template <class T, class E> using out = oc::basic_outcome<T, E, std::exception_ptr, oc::policy::terminate>;
+'''
+
+types = r'''
+struct value%(n)d
+{
+  int v;
+  constexpr value%(n)d() noexcept : v(0) {}
+  constexpr value%(n)d(int x) noexcept : v(x) {}
+};
+struct error%(n)d
+{
+  const char *e;
+  constexpr error%(n)d() noexcept : e(nullptr) {}
+  constexpr error%(n)d(const char *x) noexcept : e(x) {}
+};
+'''
+
+# What each way of constructing result<value_i, error_j> adds, %(i)d and %(j)d substituted
+constructs = [
+    ('types', r'''static_assert(sizeof(res<value%(i)d, error%(j)d>) > 0, "");
+'''),
+    ('value_converting', r'''res<value%(i)d, error%(j)d> value_converting%(i)d_%(j)d(int x) { return x; }
+'''),
+    ('error_converting', r'''res<value%(i)d, error%(j)d> error_converting%(i)d_%(j)d(const char *x) { return x; }
+'''),
+    ('inplace', r'''res<value%(i)d, error%(j)d> inplace%(i)d_%(j)d(int x)
+{
+  if(x < 0)
+  {
+    return res<value%(i)d, error%(j)d>(oc::in_place_type<error%(j)d>, "negative");
+  }
+  return res<value%(i)d, error%(j)d>(oc::in_place_type<value%(i)d>, x);
+}
+'''),
+    ('success_failure', r'''res<value%(i)d, error%(j)d> success_failure%(i)d_%(j)d(int x)
+{
+  if(x < 0)
+  {
+    return oc::failure(error%(j)d("negative"));
+  }
+  return oc::success(value%(i)d(x));
+}
+'''),
+    ('compatible_conversion', r'''res<value%(i)d, error%(j)d> compatible_conversion%(i)d_%(j)d(res<int, const char *> r) { return res<value%(i)d, error%(j)d>(r); }
+'''),
+    ('outcome_from_result', r'''out<value%(i)d, error%(j)d> outcome_from_result%(i)d_%(j)d(res<value%(i)d, error%(j)d> r) { return out<value%(i)d, error%(j)d>(std::move(r)); }
+'''),
+    ('try', r'''res<int, error%(j)d> try%(i)d_%(j)d(res<value%(i)d, error%(j)d> r)
+{
+  OUTCOME_TRY(v, std::move(r));
+  return v.v;
+}
+'''),
+]
+
+
+def source(which):
+    parts = [prologue]
+    for n in range(0, max(VALUES, ERRORS)):
+        parts.append(types % {'n': n})
+    for i in range(0, VALUES):
+        for j in range(0, ERRORS):
+            for name, text in constructs:
+                if name in which:
+                    parts.append(text % {'i': i, 'j': j})
+    return ''.join(parts)
+
+
+def compile_one(workdir, args, text, name):
+    """Returns the fastest of REPEATS compiles in milliseconds, and the diagnostic output of the last, or None on failure"""
+    path = os.path.join(workdir, name + '.cpp')
+    with open(path, 'wt') as oh:
+        oh.write(text)
+    best, output = None, ''
+    for n in range(0, REPEATS):
+        begin = time.time()
+        p = subprocess.Popen(args + ['-c', path, '-o', os.path.join(workdir, name + '.o')], cwd=workdir, stdout=subprocess.PIPE,
+                             stderr=subprocess.STDOUT, universal_newlines=True)
+        output = p.communicate()[0]
+        if p.returncode != 0:
+            return None, output
+        secs = (time.time() - begin) * 1000
+        best = secs if best is None else min(best, secs)
+    return best, output
+
+
+def stable_name(name):
+    """Removes the namespace permutation hash and template arguments"""
+    name = re.sub(r'outcome_v2_[0-9a-f]+', 'outcome_v2', name)
+    out, depth = [], 0
+    for c in name:
+        if c == '<':
+            depth += 1
+            if depth == 1:
+                out.append('<>')
+        elif c == '>' and depth > 0:
+            depth -= 1
+        elif depth == 0:
+            out.append(c)
+    return ''.join(out).replace(',', ';')
+
+
+def time_trace(workdir, name):
+    """Sums the inclusive durations of the instantiation and source events of a clang -ftime-trace"""
+    with open(os.path.join(workdir, name + '.json'), 'rt') as ih:
+        events = json.load(ih)['traceEvents']
+    templates, sources = {}, {}
+    for event in events:
+        if event.get('ph') != 'X' or 'detail' not in event.get('args', {}):
+            continue
+        if event['name'] in ('InstantiateClass', 'InstantiateFunction'):
+            key = stable_name(event['args']['detail'])
+            templates[key] = templates.get(key, (0, 0))
+            templates[key] = (templates[key][0] + 1, templates[key][1] + event['dur'] / 1000.0)
+        elif event['name'] == 'Source':
+            path = event['args']['detail'].replace('\\', '/')
+            if '/include/outcome' in path:
+                path = 'include/outcome' + path.split('/include/outcome', 1)[1]
+            sources[path] = sources.get(path, (0, 0))
+            sources[path] = (sources[path][0] + 1, sources[path][1] + event['dur'] / 1000.0)
+    return templates, sources
+
+
+def time_report(output):
+    """Parses the phase lines of GCC's -ftime-report"""
+    phases = {}
+    for line in output.splitlines():
+        m = re.match(r'^\s*(\|?[A-Za-z][^:]*?)\s*:\s*[0-9.]+\s*\(\s*\d+%\)\s*[0-9.]+\s*\(\s*\d+%\)\s*([0-9.]+)', line)
+        if m:
+            phases[m.group(1).strip()] = (1, float(m.group(2)) * 1000)
+    return phases
+
+
+workdir = tempfile.mkdtemp()
+try:
+    args = shlex.split('%s -std=c++17 -O0 -I%s' % (COMPILER, INCLUDE)) + shlex.split(os.environ.get('CXXFLAGS', ''))
+    rows = []
+    headers = sorted(glob.glob(os.path.join(INCLUDE, 'outcome', '*.hpp')) + glob.glob(os.path.join(INCLUDE, 'outcome', 'experimental', '*.hpp')))
+    for n, path in enumerate(headers):
+        header = os.path.relpath(path, INCLUDE).replace('\\', '/')
+        print("Compiling", header, "...")
+        ms, output = compile_one(workdir, args, '#include "%s"\n' % header, 'header%d' % n)
+        if ms is None:
+            print("  failed to compile on its own, skipping")
+            continue
+        rows.append(('header', 'include/' + header, 1, ms))
+    print("Compiling", VALUES * ERRORS, "results constructed in each way ...")
+    baseline, output = compile_one(workdir, args, source(['types']), 'types')
+    if baseline is None:
+        print(output)
+        print("FATAL: The generated instantiations failed to compile", file=sys.stderr)
+        sys.exit(1)
+    rows.append(('construct', 'types', VALUES * ERRORS, baseline))
+    for name, text in constructs[1:]:
+        ms, output = compile_one(workdir, args, source(['types', name]), name)
+        if ms is None:
+            print(output)
+            print("FATAL: The generated instantiations failed to compile", file=sys.stderr)
+            sys.exit(1)
+        rows.append(('construct', name, VALUES * ERRORS, ms - baseline))
+    print("Compiling all", VALUES * ERRORS, "results with", '-ftime-trace' if CLANG else '-ftime-report', "...")
+    everything = [name for name, text in constructs]
+    if CLANG:
+        ms, output = compile_one(workdir, args + ['-ftime-trace', '-ftime-trace-granularity=0'], source(everything), 'all')
+        templates, sources = time_trace(workdir, 'all')
+        rows += [('template', k, v[0], v[1]) for k, v in templates.items()]
+        rows += [('source', k, v[0], v[1]) for k, v in sources.items()]
+    else:
+        ms, output = compile_one(workdir, args + ['-ftime-report'], source(everything), 'all')
+        rows += [('phase', k, v[0], v[1]) for k, v in time_report(output).items()]
+    with open('results-compile-time-trace.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Kind","Name","Count","Milliseconds"\n')
+        for kind, name, count, ms in sorted(rows, key=lambda r: (r[0], r[1])):
+            line = '"%s","%s","%s",%d,%f' % (COMPILER, kind, name, count, ms)
+            print(line)
+            resultsh.write(line + '\n')
+finally:
+    shutil.rmtree(workdir)
@@ -0,0 +1,87 @@
+/* Benchmark the throughput of results with error provenance against plain results
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+/* Build with something like:
+
+g++ -O3 -DNDEBUG -std=c++17 -o error_provenance_off error_provenance.cpp
+g++ -O3 -DNDEBUG -DOUTCOME_ENABLE_ERROR_PROVENANCE=1 -std=c++17 -o error_provenance_on error_provenance.cpp
+
+Prints a CSV of nanoseconds per call of a function which cannot be inlined returning a
+result through DEPTH frames of `OUTCOME_TRY`, for one failure in every 1, 16, 256 calls
+and none, so a failure records an origin and DEPTH - 1 hops. Compare the rows of the two
+builds, and add -DOUTCOME_ERROR_PROVENANCE_TRY_HOPS=0 to the second to record origins only.
+*/
+
+#include "../include/outcome/result.hpp"
+#include "../include/outcome/try.hpp"
+
+#include <chrono>
+#include <stdio.h>
+
+#define ITERATIONS 10000000
+#define DEPTH 4
+
+#ifdef _MSC_VER
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+using result = OUTCOME_V2_NAMESPACE::result<int, std::error_code>;
+
+static double ns_per_op(result (*f)(int), int failure_mask)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  size_t checksum = 0;
+  for(int n = 0; n < ITERATIONS; n++)
+  {
+    result r = f((failure_mask >= 0 && (n & failure_mask) == 0) ? -1 : n);
+    checksum += r ? r.assume_value() : r.assume_error().value();
+  }
+  volatile size_t sink = checksum;
+  (void) sink;
+  auto end = std::chrono::high_resolution_clock::now();
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / ITERATIONS;
+}
+
+template <int N> NOINLINE result frame(int n)
+{
+  OUTCOME_TRY(v, frame<N - 1>(n));
+  return v + 1;
+}
+template <> NOINLINE result frame<0>(int n)
+{
+  if(n < 0)
+  {
+    return std::make_error_code(std::errc::invalid_argument);
+  }
+  return n;
+}
+
+int main()
+{
+  printf("provenance,all fail ns,1 in 16 fail ns,1 in 256 fail ns,none fail ns\n");
+  printf("%s,%f,%f,%f,%f\n", OUTCOME_ENABLE_ERROR_PROVENANCE ? (OUTCOME_ERROR_PROVENANCE_TRY_HOPS ? "origins and hops" : "origins") : "disabled", ns_per_op(frame<DEPTH - 1>, 0), ns_per_op(frame<DEPTH - 1>, 15),
+         ns_per_op(frame<DEPTH - 1>, 255), ns_per_op(frame<DEPTH - 1>, -1));
+  return 0;
+}
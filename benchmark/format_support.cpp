@@ -0,0 +1,91 @@
+/* Benchmark formatting results with fmt against print()
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++14 -DFMT_HEADER_ONLY format_support.cpp
+
+Prints a CSV of nanoseconds per record to format ITERATIONS successful and
+failed results into text, using print(), which allocates a stringstream and
+a string each time, and using the fmt formatters, both into a reused
+fmt::memory_buffer and into a fixed size char array. Requires fmt; with a
+C++ 20 standard library std::format can be substituted.
+*/
+
+#include "../include/outcome/format_support.hpp"
+#include "../include/outcome/iostream_support.hpp"
+
+#include <chrono>
+#include <stdio.h>
+
+#if !OUTCOME_HAVE_FMT_SUPPORT
+#error This benchmark requires fmt
+#endif
+
+#define ITERATIONS 1000000
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+
+template <class F> static double ns_per_op(F &&f)
+{
+  size_t checksum = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int n = 0; n < ITERATIONS; n++)
+  {
+    checksum += f();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  volatile size_t sink = checksum;
+  (void) sink;
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / ITERATIONS;
+}
+
+template <class T> static void benchmark(const char *name, const T &v)
+{
+  fmt::memory_buffer buffer;
+  char fixed[256];
+  const double print_ns = ns_per_op([&] { return outcome::print(v).size(); });
+  const double fmt_ns = ns_per_op([&] {
+    buffer.clear();
+    fmt::format_to(fmt::appender(buffer), "{}", v);
+    return buffer.size();
+  });
+  const double fmt_verbose_ns = ns_per_op([&] {
+    buffer.clear();
+    fmt::format_to(fmt::appender(buffer), "{:#}", v);
+    return buffer.size();
+  });
+  const double fixed_ns = ns_per_op([&] { return static_cast<size_t>(fmt::format_to_n(fixed, sizeof(fixed), "{:#}", v).size); });
+  printf("%s,%f,%f,%f,%f\n", name, print_ns, fmt_ns, fmt_verbose_ns, fixed_ns);
+}
+
+int main()
+{
+  printf("record,print() ns,fmt {} ns,fmt {:#} ns,fmt {:#} into char array ns\n");
+  benchmark("result<int> value", outcome::result<int>(78));
+  benchmark("result<int> errno error", outcome::result<int>(make_error_code(std::errc::no_such_file_or_directory)));
+  benchmark("outcome<std::string> value", outcome::outcome<std::string>("a string value"));
+  benchmark("outcome<int> exception", outcome::outcome<int>(std::make_exception_ptr(std::runtime_error("failed"))));
+  return 0;
+}
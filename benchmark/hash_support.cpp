@@ -0,0 +1,154 @@
+/* Benchmark std::hash of results and status codes as unordered_map keys
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++17 hash_support.cpp
+
+Inserts ENTRIES distinct keys into, and then looks each up in, an unordered_map
+keyed by `result<uint64_t>`, one in sixteen of them errors, and then by type
+erased `system_code`, once with the `std::hash` of `<outcome/hash_support.hpp>`
+and once hashing the error's `message()` as is commonly done instead. Prints a
+CSV of nanoseconds per insert and per lookup, and of the collision statistics
+of the hashes: how many keys share a hash value with another, and the maximum
+and mean number of keys in the map's occupied buckets.
+*/
+
+#include "../include/outcome/experimental/status_hash_support.hpp"
+#include "../include/outcome/experimental/status_outcome.hpp"
+#include "../include/outcome/hash_support.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef ENTRIES
+#define ENTRIES 10000000
+#endif
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+using outcome::experimental::posix_code;
+using outcome::experimental::system_code;
+
+// What users do without std::hash of results: hash the value, or else the error's message
+struct result_message_hash
+{
+  size_t operator()(const outcome::result<uint64_t> &r) const { return r.has_value() ? std::hash<uint64_t>()(r.value()) : std::hash<std::string>()(r.error().message()); }
+};
+struct status_code_message_hash
+{
+  size_t operator()(const system_code &sc) const
+  {
+    auto msg = sc.message();
+    return std::hash<std::string>()(std::string(msg.data(), msg.size()));
+  }
+};
+
+// Type erased status codes cannot be copied, only cloned
+template <class T> static T copy_key(const T &v) { return v; }
+static system_code copy_key(const system_code &v) { return v.clone(); }
+
+template <class Key, class Hash, class Equal> static void benchmark(const char *name, const std::vector<Key> &keys)
+{
+  std::vector<size_t> hashes;
+  hashes.reserve(keys.size());
+  Hash hash;
+  for(const auto &k : keys)
+  {
+    hashes.push_back(hash(k));
+  }
+  std::sort(hashes.begin(), hashes.end());
+  const size_t distinct = std::unique(hashes.begin(), hashes.end()) - hashes.begin();
+  hashes = std::vector<size_t>();
+
+  std::unordered_map<Key, uint64_t, Hash, Equal> map;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(size_t n = 0; n < keys.size(); n++)
+  {
+    map.emplace(copy_key(keys[n]), n);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  const double insert_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / keys.size();
+  uint64_t checksum = 0;
+  begin = std::chrono::high_resolution_clock::now();
+  for(const auto &k : keys)
+  {
+    checksum += map.find(k)->second;
+  }
+  end = std::chrono::high_resolution_clock::now();
+  const double lookup_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / keys.size();
+  if(checksum != static_cast<uint64_t>(keys.size()) * (keys.size() - 1) / 2)
+  {
+    fprintf(stderr, "FATAL: %s lookups returned the wrong entries\n", name);
+    abort();
+  }
+
+  size_t occupied = 0, largest = 0;
+  for(size_t n = 0; n < map.bucket_count(); n++)
+  {
+    const size_t size = map.bucket_size(n);
+    occupied += (size > 0);
+    largest = std::max(largest, size);
+  }
+  printf("%s,%zu,%f,%f,%zu,%zu,%zu,%zu,%f\n", name, keys.size(), insert_ns, lookup_ns, keys.size() - distinct, map.bucket_count(), occupied, largest, static_cast<double>(map.size()) / occupied);
+  fflush(stdout);
+}
+
+int main()
+{
+  printf("keys,entries,insert ns,lookup ns,keys sharing a hash,buckets,occupied buckets,largest bucket,mean occupied bucket\n");
+  {
+    std::vector<outcome::result<uint64_t>> keys;
+    keys.reserve(ENTRIES);
+    for(size_t n = 0; n < ENTRIES; n++)
+    {
+      if(n % 16 == 0)
+      {
+        keys.emplace_back(std::error_code(static_cast<int>(n), std::generic_category()));
+      }
+      else
+      {
+        keys.emplace_back(static_cast<uint64_t>(n) * 4096);  // offsets or addresses, which differ only in their upper bits
+      }
+    }
+    // The first map built pays for faulting in the memory all later ones reuse
+    benchmark<outcome::result<uint64_t>, std::hash<outcome::result<uint64_t>>, std::equal_to<outcome::result<uint64_t>>>("(warm up)", keys);
+    benchmark<outcome::result<uint64_t>, std::hash<outcome::result<uint64_t>>, std::equal_to<outcome::result<uint64_t>>>("result std::hash", keys);
+    benchmark<outcome::result<uint64_t>, result_message_hash, std::equal_to<outcome::result<uint64_t>>>("result message hash", keys);
+  }
+  {
+    std::vector<system_code> keys;
+    keys.reserve(ENTRIES);
+    for(size_t n = 0; n < ENTRIES; n++)
+    {
+      keys.emplace_back(posix_code(static_cast<int>(n)));
+    }
+    benchmark<system_code, std::hash<system_code>, outcome::experimental::status_code_equal_to>("system_code std::hash", keys);
+    benchmark<system_code, status_code_message_hash, outcome::experimental::status_code_equal_to>("system_code message hash", keys);
+  }
+  return 0;
+}
@@ -0,0 +1,75 @@
+#!/usr/bin/python
+# Benchmark the preprocessed size and parse time of each public header
+# (C) 2019 Niall Douglas http://www.nedproductions.biz/
+# Created: Oct 2019
+#
+# For each public header listed in cmake/headers.cmake, compiles a translation
+# unit including only that header, and writes to results-header-cost.csv the
+# number of non-blank lines it preprocesses into, and the fastest of REPEATS
+# syntax only compiles of it. The standard library headers which
+# <outcome/minimal_result.hpp> is limited to are also measured on their own as
+# a baseline. Include paths for the submodules, if not the defaults, can be
+# supplied with CXXFLAGS.
+#
+# Usage: header_cost.py [compiler] [repeats]
+
+from __future__ import print_function
+import sys, os, re, subprocess, shlex, time, shutil, tempfile
+
+COMPILER = sys.argv[1] if len(sys.argv) > 1 else 'g++'
+REPEATS = int(sys.argv[2]) if len(sys.argv) > 2 else 5
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.abspath(os.path.join(HERE, '..'))
+INCLUDE = os.path.join(ROOT, 'include')
+
+if COMPILER.endswith('cl') or COMPILER.endswith('cl.exe'):
+    std, preprocess, syntax_only = '/std:c++17', ['/EP'], ['/Zs']
+else:
+    std, preprocess, syntax_only = '-std=c++17', ['-E', '-P'], ['-fsyntax-only']
+
+def public_headers():
+    """The headers in cmake/headers.cmake, less those of the submodules and the implementation details"""
+    with open(os.path.join(ROOT, 'cmake', 'headers.cmake'), 'rt') as ih:
+        paths = re.findall(r'"include/(outcome[^"]*\.hpp)"', ih.read())
+    return [p for p in paths if '/detail/' not in p and '/quickcpplib/' not in p and '/status-code/' not in p]
+
+def measure(workdir, args, text, name):
+    """Returns the preprocessed lines and the fastest compile in milliseconds, or None on failure"""
+    path = os.path.join(workdir, name + '.cpp')
+    with open(path, 'wt') as oh:
+        oh.write(text)
+    p = subprocess.Popen(args + preprocess + [path], cwd=workdir, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, universal_newlines=True)
+    output = p.communicate()[0]
+    if p.returncode != 0:
+        return None
+    lines = sum(1 for line in output.splitlines() if line.strip())
+    best = None
+    for n in range(0, REPEATS):
+        begin = time.time()
+        if subprocess.call(args + syntax_only + [path], cwd=workdir, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL) != 0:
+            return None
+        ms = (time.time() - begin) * 1000
+        best = ms if best is None else min(best, ms)
+    return lines, best
+
+workdir = tempfile.mkdtemp()
+try:
+    args = shlex.split('%s %s -I%s' % (COMPILER, std, INCLUDE)) + shlex.split(os.environ.get('CXXFLAGS', ''))
+    sources = [('(standard library baseline)', ''.join('#include <%s>\n' % h for h in ['cstdint', 'initializer_list', 'new', 'type_traits', 'utility']))]
+    sources += [('include/' + h, '#include "%s"\n' % h) for h in public_headers()]
+    rows = []
+    for n, (name, text) in enumerate(sources):
+        print("Compiling", name, "...")
+        result = measure(workdir, args, text, 'header%d' % n)
+        if result is None:
+            print("  failed to compile on its own, skipping")
+            continue
+        rows.append((name, result[0], result[1]))
+    with open('results-header-cost.csv', 'wt') as resultsh:
+        resultsh.write('"Compiler","Header","Preprocessed lines","Parse milliseconds"\n')
+        for name, lines, ms in sorted(rows, key=lambda r: r[1]):
+            line = '"%s","%s",%d,%f' % (COMPILER, name, lines, ms)
+            print(line)
+            resultsh.write(line + '\n')
+finally:
+    shutil.rmtree(workdir)
@@ -0,0 +1,177 @@
+/* Benchmark memo_cache under concurrent Zipfian lookups
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++14 memo_cache.cpp -lpthread
+
+Prints a CSV of lookups per microsecond, hit rates and backend invocations
+with 1 to N threads, each looking up LOOKUPS keys drawn from a Zipfian
+distribution over KEYS keys, for memo_cache and for a single mutex protected
+std::unordered_map which neither caches failures nor coalesces misses. One
+in ERROR_EVERY keys fails in the backend, which costs BACKEND_COST spins.
+*/
+
+#include "../include/outcome/memo_cache.hpp"
+#include "../include/outcome/result.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#define KEYS 100000
+#define LOOKUPS 500000
+#define ZIPF_S 0.99
+#define ERROR_EVERY 20
+#define BACKEND_COST 2000
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+
+static std::atomic<long> backend_calls;
+
+static outcome::result<long> backend(int k)
+{
+  backend_calls.fetch_add(1, std::memory_order_relaxed);
+  volatile long x = k;
+  for(int n = 0; n < BACKEND_COST; n++)
+  {
+    x = x + n;
+  }
+  if(k % ERROR_EVERY == 0)
+  {
+    return make_error_code(std::errc::no_such_file_or_directory);
+  }
+  return x;
+}
+
+static std::vector<int> zipf_keys(unsigned seed)
+{
+  static const std::vector<double> cdf = [] {
+    std::vector<double> ret(KEYS);
+    double sum = 0;
+    for(int n = 0; n < KEYS; n++)
+    {
+      ret[n] = (sum += 1.0 / std::pow(n + 1, ZIPF_S));
+    }
+    for(auto &c : ret)
+    {
+      c /= sum;
+    }
+    return ret;
+  }();
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist;
+  std::vector<int> ret(LOOKUPS);
+  for(auto &k : ret)
+  {
+    k = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), dist(gen)) - cdf.begin());
+    // Scatter popular keys, so they do not all share a shard
+    k = static_cast<int>((static_cast<unsigned>(k) * 2654435761u) % KEYS);
+  }
+  return ret;
+}
+
+struct mutex_map
+{
+  std::mutex lock;
+  std::unordered_map<int, long> map;
+  outcome::result<long> get(int k)
+  {
+    {
+      std::lock_guard<std::mutex> g(lock);
+      auto it = map.find(k);
+      if(it != map.end())
+      {
+        return it->second;
+      }
+    }
+    auto r = backend(k);
+    if(r)
+    {
+      std::lock_guard<std::mutex> g(lock);
+      map.emplace(k, r.value());
+    }
+    return r;
+  }
+};
+
+template <class F> double run(unsigned threads, const std::vector<std::vector<int>> &keys, F &&get)
+{
+  std::vector<std::thread> ts;
+  std::atomic<unsigned> ready{0};
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(unsigned t = 0; t < threads; t++)
+  {
+    ts.emplace_back([&, t] {
+      ready.fetch_add(1);
+      while(ready.load() < threads)
+      {
+        std::this_thread::yield();
+      }
+      long sum = 0;
+      for(int k : keys[t])
+      {
+        auto r = get(k);
+        sum += r ? r.value() : 0;
+      }
+      volatile long sink = sum;
+      (void) sink;
+    });
+  }
+  for(auto &t : ts)
+  {
+    t.join();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count());
+}
+
+int main()
+{
+  const unsigned max_threads = std::max(2u, std::thread::hardware_concurrency());
+  std::vector<std::vector<int>> keys;
+  for(unsigned t = 0; t < max_threads; t++)
+  {
+    keys.push_back(zipf_keys(78 + t));
+  }
+  printf("threads,memo_cache lookups/us,hit %%,negative hit %%,coalesced,backend calls,mutex map lookups/us,backend calls\n");
+  for(unsigned threads = 1; threads <= max_threads; threads++)
+  {
+    const double total = static_cast<double>(threads) * LOOKUPS;
+    outcome::memo_cache<int, outcome::result<long>> cache(std::chrono::hours(1), std::chrono::seconds(10));
+    backend_calls = 0;
+    const double memo_us = run(threads, keys, [&](int k) { return cache.get_or_compute(k, backend); });
+    const long memo_calls = backend_calls;
+    const auto stats = cache.stats();
+    mutex_map mm;
+    backend_calls = 0;
+    const double mutex_us = run(threads, keys, [&](int k) { return mm.get(k); });
+    printf("%u,%f,%f,%f,%llu,%ld,%f,%ld\n", threads, total / memo_us, 100.0 * stats.hits / total, 100.0 * stats.negative_hits / total, (unsigned long long) stats.coalesced, memo_calls, total / mutex_us, backend_calls.load());
+  }
+  return 0;
+}
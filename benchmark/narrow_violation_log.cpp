@@ -0,0 +1,117 @@
+/* Benchmark the all_narrow_logged policy against all_narrow
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -DNDEBUG -DOUTCOME_LOG_NARROW_VIOLATIONS=1 -std=c++17 narrow_violation_log.cpp
+
+Prints a CSV of nanoseconds per correct `.assume_value()` of ITERATIONS results
+with the `all_narrow` and `all_narrow_logged` policies, summed in a loop which the
+compiler can vectorise and through a function which cannot be inlined, and of
+nanoseconds per incorrect `.assume_value()` recorded into the log of the thread.
+Build without OUTCOME_LOG_NARROW_VIOLATIONS=1 to confirm that the two policies then
+cost the same.
+*/
+
+#include "../include/outcome/basic_result.hpp"
+#include "../include/outcome/policy/all_narrow_logged.hpp"
+
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+#define ITERATIONS 100000000
+#define RESULTS 1024
+
+#ifdef _MSC_VER
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+template <class Policy> using result = OUTCOME_V2_NAMESPACE::basic_result<int, long, Policy>;
+
+template <class F> static double ns_per_op(F &&f)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  volatile size_t sink = f();
+  (void) sink;
+  auto end = std::chrono::high_resolution_clock::now();
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / ITERATIONS;
+}
+
+template <class Policy> NOINLINE int observe(const result<Policy> &r)
+{
+  return r.assume_value();
+}
+
+template <class Policy> static void benchmark(const char *name, bool violations)
+{
+  using OUTCOME_V2_NAMESPACE::in_place_type;
+  std::vector<result<Policy>> values;
+  for(int n = 0; n < RESULTS; n++)
+  {
+    values.emplace_back(in_place_type<int>, n);
+  }
+  const double loop_ns = ns_per_op([&] {
+    size_t checksum = 0;
+    for(int n = 0; n < ITERATIONS; n++)
+    {
+      checksum += values[n % RESULTS].assume_value();
+    }
+    return checksum;
+  });
+  const double call_ns = ns_per_op([&] {
+    size_t checksum = 0;
+    for(int n = 0; n < ITERATIONS; n++)
+    {
+      checksum += observe(values[n % RESULTS]);
+    }
+    return checksum;
+  });
+  if(!violations)
+  {
+    printf("%s,%f,%f,\n", name, loop_ns, call_ns);
+    return;
+  }
+  const result<Policy> errored(in_place_type<long>, 1L);
+  const double violation_ns = ns_per_op([&] {
+    size_t checksum = 0;
+    for(int n = 0; n < ITERATIONS; n++)
+    {
+      checksum += observe(errored);
+    }
+    return checksum;
+  });
+  OUTCOME_V2_NAMESPACE::policy::this_thread_narrow_violations().clear();
+  printf("%s,%f,%f,%f\n", name, loop_ns, call_ns, violation_ns);
+}
+
+int main()
+{
+  printf("policy,loop ns,call ns,violation ns\n");
+  benchmark<OUTCOME_V2_NAMESPACE::policy::all_narrow>("all_narrow", false);  // incorrect observation is undefined behaviour
+  benchmark<OUTCOME_V2_NAMESPACE::policy::all_narrow_logged>("all_narrow_logged", OUTCOME_LOG_NARROW_VIOLATIONS);
+  return 0;
+}
@@ -0,0 +1,103 @@
+/* Benchmark parallel_traverse() scaling
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++14 parallel_traverse.cpp -lpthread
+
+Prints a CSV of wall clock time to validate ITEMS items with 1 to N threads,
+both when every item validates and when an item early in the input fails.
+*/
+
+#include "../include/outcome/parallel.hpp"
+#include "../include/outcome/result.hpp"
+
+#include <chrono>
+#include <stdio.h>
+
+#define ITEMS (1 << 20)
+#define WORK_PER_ITEM 256
+#define REPEATS 5
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+
+static outcome::result<uint32_t> validate(uint32_t v, uint32_t fail_at)
+{
+  // Some CPU bound work which the compiler cannot elide
+  uint32_t h = v;
+  for(int n = 0; n < WORK_PER_ITEM; n++)
+  {
+    h ^= h << 13;
+    h ^= h >> 17;
+    h ^= h << 5;
+  }
+  if(v == fail_at)
+  {
+    return std::errc::invalid_argument;
+  }
+  return h;
+}
+
+template <class F> static double time_it(F &&f)
+{
+  double best = 1e300;
+  for(int n = 0; n < REPEATS; n++)
+  {
+    auto begin = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() / 1000.0;
+    if(ms < best)
+    {
+      best = ms;
+    }
+  }
+  return best;
+}
+
+volatile size_t sink;
+
+int main(void)
+{
+  std::vector<uint32_t> inputs(ITEMS);
+  for(uint32_t n = 0; n < ITEMS; n++)
+  {
+    inputs[n] = n;
+  }
+  const unsigned maxthreads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+  printf("\"Threads\",\"all-success ms\",\"early-failure ms\"\n");
+  for(unsigned threads = 1; threads <= maxthreads; threads++)
+  {
+    double success = time_it([&] {
+      auto r = outcome::parallel_traverse(inputs.begin(), inputs.end(), [](uint32_t v) { return validate(v, UINT32_MAX); }, threads);
+      sink = r.value().size();
+    });
+    double failure = time_it([&] {
+      auto r = outcome::parallel_traverse(inputs.begin(), inputs.end(), [](uint32_t v) { return validate(v, ITEMS / 100); }, threads);
+      sink = r.has_error();
+    });
+    printf("%u,%f,%f\n", threads, success, failure);
+  }
+  return 0;
+}
@@ -0,0 +1,188 @@
+/* Benchmark result_channel against a mutex protected deque and a generic MPMC queue
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++14 result_channel.cpp -lpthread
+
+Prints a CSV of millions of items per second moved from 1 to 4 producer threads to
+one consumer thread, of `outcome<Record>`, for:
+
+1. result_channel, popping in batches of BATCH.
+2. result_channel, popping one at a time.
+3. std::deque protected by a std::mutex.
+4. A generic lock free MPMC queue, which like most such queues only holds trivially
+copyable items, so each outcome is heap allocated and a pointer to it is queued.
+*/
+
+#include "../include/outcome/channel.hpp"
+#include "../include/outcome/outcome.hpp"
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#define ITEMS (1 << 20)
+#define CAPACITY 1024
+#define BATCH 32
+#define REPEATS 3
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+
+struct Record
+{
+  uint64_t id;
+  char payload[40];
+};
+using item_type = outcome::outcome<Record>;
+
+static item_type make_item(uint64_t n)
+{
+  if(n % 1000 == 0)
+  {
+    return std::make_error_code(std::errc::invalid_argument);
+  }
+  Record r{n, {}};
+  return r;
+}
+
+volatile uint64_t sink;
+
+template <class Push, class Pop> static double run(unsigned producers, Push &&push, Pop &&pop)
+{
+  double best = 0;
+  for(int repeat = 0; repeat < REPEATS; repeat++)
+  {
+    const uint64_t per_producer = ITEMS / producers;
+    auto begin = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for(unsigned p = 0; p < producers; p++)
+    {
+      threads.emplace_back([&, p] {
+        for(uint64_t n = 0; n < per_producer; n++)
+        {
+          push(make_item(p * per_producer + n));
+        }
+      });
+    }
+    uint64_t consumed = 0, sum = 0;
+    while(consumed < per_producer * producers)
+    {
+      const size_t n = pop([&](item_type &&v) {
+        if(v)
+        {
+          sum += v.value().id;
+        }
+      });
+      if(n == 0)
+      {
+        std::this_thread::yield();
+      }
+      consumed += n;
+    }
+    sink = sum;
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const double rate = static_cast<double>(consumed) / static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count());
+    if(rate > best)
+    {
+      best = rate;
+    }
+  }
+  return best;
+}
+
+int main(void)
+{
+  printf("\"Producers\",\"result_channel batched\",\"result_channel\",\"mutex+deque\",\"generic MPMC of pointers\"\n");
+  for(unsigned producers = 1; producers <= 4; producers++)
+  {
+    double batched, single, locked, generic;
+    {
+      outcome::result_channel<item_type> ch(CAPACITY);
+      batched = run(producers, [&](item_type &&v) { ch.emplace(std::move(v)); }, [&](auto &&f) { return ch.try_consume_n(f, BATCH); });
+    }
+    {
+      outcome::result_channel<item_type> ch(CAPACITY);
+      single = run(producers, [&](item_type &&v) { ch.emplace(std::move(v)); }, [&](auto &&f) { return ch.try_consume_n(f, 1); });
+    }
+    {
+      std::mutex lock;
+      std::deque<item_type> q;
+      locked = run(producers,
+                   [&](item_type &&v) {
+                     for(;;)
+                     {
+                       {
+                         std::lock_guard<std::mutex> g(lock);
+                         if(q.size() < CAPACITY)
+                         {
+                           q.push_back(std::move(v));
+                           return;
+                         }
+                       }
+                       std::this_thread::yield();
+                     }
+                   },
+                   [&](auto &&f) -> size_t {
+                     std::lock_guard<std::mutex> g(lock);
+                     if(q.empty())
+                     {
+                       return 0;
+                     }
+                     f(std::move(q.front()));
+                     q.pop_front();
+                     return 1;
+                   });
+    }
+    {
+      outcome::detail::channel_ring<item_type *> q(CAPACITY);
+      generic = run(producers,
+                    [&](item_type &&v) {
+                      auto *p = new item_type(std::move(v));
+                      while(!q.try_emplace(p))
+                      {
+                        std::this_thread::yield();
+                      }
+                    },
+                    [&](auto &&f) {
+                      return q.try_consume_n(
+                      [&](item_type *&&p) {
+                        f(std::move(*p));
+                        delete p;
+                      },
+                      1);
+                    });
+    }
+    printf("%u,%f,%f,%f,%f\n", producers, batched, single, locked, generic);
+  }
+  return 0;
+}
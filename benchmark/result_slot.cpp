@@ -0,0 +1,213 @@
+/* Benchmark result_slot against std::promise and std::future
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++14 result_slot.cpp -lpthread
+
+Prints a CSV of nanoseconds per operation for:
+
+1. Handoff: set then get within one thread, i.e. the raw cost of the synchronisation object.
+2. Ping-pong: two threads alternately handing a result to one another.
+3. Fan-in: FANIN threads each handing one result to a single consumer.
+*/
+
+#include "../include/outcome/result_slot.hpp"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdio.h>
+#include <vector>
+
+#define HANDOFFS 1000000
+#define PINGPONGS 20000
+#define FANIN 8
+#define FANIN_ROUNDS 2000
+#define REPEATS 5
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+using result_type = outcome::result_slot<int>::result_type;
+
+template <class F> static double time_it(F &&f, size_t ops)
+{
+  double best = 1e300;
+  for(int n = 0; n < REPEATS; n++)
+  {
+    auto begin = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / ops;
+    if(ns < best)
+    {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile int sink;
+
+static double handoff_slot()
+{
+  return time_it(
+  [] {
+    outcome::result_slot<int> slot;
+    for(int n = 0; n < HANDOFFS; n++)
+    {
+      slot.emplace_value(n);
+      sink = slot.wait().value();
+      slot.reset();
+    }
+  },
+  HANDOFFS);
+}
+
+static double handoff_future()
+{
+  return time_it(
+  [] {
+    for(int n = 0; n < HANDOFFS; n++)
+    {
+      std::promise<result_type> p;
+      auto f = p.get_future();
+      p.set_value(n);
+      sink = f.get().value();
+    }
+  },
+  HANDOFFS);
+}
+
+static double pingpong_slot()
+{
+  return time_it(
+  [] {
+    // A fresh pair of slots per round trip, so no slot is ever reset whilst in use
+    std::unique_ptr<outcome::result_slot<int>[]> ping(new outcome::result_slot<int>[PINGPONGS]), pong(new outcome::result_slot<int>[PINGPONGS]);
+    std::thread other([&] {
+      for(int n = 0; n < PINGPONGS; n++)
+      {
+        pong[n].emplace_value(ping[n].wait().value() + 1);
+      }
+    });
+    for(int n = 0; n < PINGPONGS; n++)
+    {
+      ping[n].emplace_value(n);
+      sink = pong[n].wait().value();
+    }
+    other.join();
+  },
+  PINGPONGS);
+}
+
+static double pingpong_future()
+{
+  return time_it(
+  [] {
+    std::vector<std::promise<result_type>> ping(PINGPONGS), pong(PINGPONGS);
+    std::thread other([&] {
+      for(int n = 0; n < PINGPONGS; n++)
+      {
+        pong[n].set_value(ping[n].get_future().get().value() + 1);
+      }
+    });
+    for(int n = 0; n < PINGPONGS; n++)
+    {
+      auto f = pong[n].get_future();
+      ping[n].set_value(n);
+      sink = f.get().value();
+    }
+    other.join();
+  },
+  PINGPONGS);
+}
+
+static double fanin_slot()
+{
+  return time_it(
+  [] {
+    std::unique_ptr<outcome::result_slot<int>[]> slots(new outcome::result_slot<int>[FANIN * FANIN_ROUNDS]);
+    std::vector<std::thread> producers;
+    for(int t = 0; t < FANIN; t++)
+    {
+      producers.emplace_back([&, t] {
+        for(int n = 0; n < FANIN_ROUNDS; n++)
+        {
+          slots[n * FANIN + t].emplace_value(t);
+        }
+      });
+    }
+    for(int n = 0; n < FANIN * FANIN_ROUNDS; n++)
+    {
+      sink = slots[n].wait().value();
+    }
+    for(auto &t : producers)
+    {
+      t.join();
+    }
+  },
+  FANIN * FANIN_ROUNDS);
+}
+
+static double fanin_future()
+{
+  return time_it(
+  [] {
+    std::vector<std::promise<result_type>> promises(FANIN * FANIN_ROUNDS);
+    std::vector<std::future<result_type>> futures;
+    futures.reserve(promises.size());
+    for(auto &p : promises)
+    {
+      futures.push_back(p.get_future());
+    }
+    std::vector<std::thread> producers;
+    for(int t = 0; t < FANIN; t++)
+    {
+      producers.emplace_back([&, t] {
+        for(int n = 0; n < FANIN_ROUNDS; n++)
+        {
+          promises[n * FANIN + t].set_value(t);
+        }
+      });
+    }
+    for(auto &f : futures)
+    {
+      sink = f.get().value();
+    }
+    for(auto &t : producers)
+    {
+      t.join();
+    }
+  },
+  FANIN * FANIN_ROUNDS);
+}
+
+int main(void)
+{
+  printf("\"Benchmark\",\"result_slot ns/op\",\"std::promise/std::future ns/op\"\n");
+  printf("\"handoff\",%f,%f\n", handoff_slot(), handoff_future());
+  printf("\"ping-pong\",%f,%f\n", pingpong_slot(), pingpong_future());
+  printf("\"fan-in %d\",%f,%f\n", FANIN, fanin_slot(), fanin_future());
+  return 0;
+}
@@ -0,0 +1,153 @@
+/* Benchmark scanning a memory mapped file of results with result_view
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++14 result_view.cpp
+
+Writes a file of FILE_BYTES bytes of result_record<uint64_t, int>, one in
+every ERROR_EVERY of them a failure, then memory maps it and prints a CSV of
+the wall clock time and throughput of summing the values by viewing each
+record in place, by OUTCOME_TRY upon each view, and by first copying each
+record into a result. Pass a path as the first argument to use a file other
+than result_view.bin in the current directory, which is deleted afterwards.
+*/
+
+#include "../include/outcome/result.hpp"
+#include "../include/outcome/result_view.hpp"
+#include "../include/outcome/try.hpp"
+
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+#ifdef _WIN32
+#error This benchmark requires POSIX mmap
+#endif
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define FILE_BYTES (1ULL << 30)
+#define ERROR_EVERY 100
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+using record = outcome::result_record<uint64_t, int>;
+using view = outcome::result_view<uint64_t, int>;
+using result = outcome::checked<uint64_t, int>;
+
+static result sum_via_try(view v, uint64_t &sum)
+{
+  OUTCOME_TRY(x, v);
+  sum += x;
+  return outcome::success(x);
+}
+
+template <class F> static void benchmark(const char *name, F &&f)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  const uint64_t sum = f();
+  auto end = std::chrono::high_resolution_clock::now();
+  const double secs = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count()) / 1000000.0;
+  printf("%s,%f,%f,%llu\n", name, secs, static_cast<double>(FILE_BYTES) / secs / 1073741824.0, static_cast<unsigned long long>(sum));
+}
+
+int main(int argc, char *argv[])
+{
+  const char *path = (argc > 1) ? argv[1] : "result_view.bin";
+  const size_t records = FILE_BYTES / record::size;
+  int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if(fd < 0)
+  {
+    perror("open");
+    return 1;
+  }
+  {
+    // Write in chunks of aligned records, as a log writer would
+    std::vector<uint64_t> chunk(1 << 20);
+    const size_t per_chunk = chunk.size() * sizeof(uint64_t) / record::size;
+    for(size_t n = 0; n < records; n += per_chunk)
+    {
+      for(size_t i = 0; i < per_chunk; i++)
+      {
+        const uint64_t idx = n + i;
+        record::store(reinterpret_cast<char *>(chunk.data()) + i * record::size, (idx % ERROR_EVERY == 0) ? result(outcome::failure(static_cast<int>(idx % 1000))) : result(outcome::success(idx)));
+      }
+      if(::write(fd, chunk.data(), per_chunk * record::size) != static_cast<ssize_t>(per_chunk * record::size))
+      {
+        perror("write");
+        return 1;
+      }
+    }
+  }
+  void *mapped = ::mmap(nullptr, FILE_BYTES, PROT_READ, MAP_SHARED, fd, 0);
+  if(mapped == MAP_FAILED)
+  {
+    perror("mmap");
+    return 1;
+  }
+  outcome::result_view_span<uint64_t, int> span(mapped, FILE_BYTES);
+  printf("method,seconds,GB/sec,checksum\n");
+  for(int pass = 0; pass < 2; pass++)
+  {
+    benchmark("view in place", [&] {
+      uint64_t sum = 0;
+      for(auto v : span)
+      {
+        if(v)
+        {
+          sum += v.assume_value();
+        }
+      }
+      return sum;
+    });
+    benchmark("OUTCOME_TRY upon view", [&] {
+      uint64_t sum = 0;
+      for(auto v : span)
+      {
+        (void) sum_via_try(v, sum);
+      }
+      return sum;
+    });
+    benchmark("copy into result", [&] {
+      uint64_t sum = 0;
+      for(auto v : span)
+      {
+        const result r(v);
+        if(r)
+        {
+          sum += r.value();
+        }
+      }
+      return sum;
+    });
+  }
+  ::munmap(mapped, FILE_BYTES);
+  ::close(fd);
+  if(argc <= 1)
+  {
+    ::unlink(path);
+  }
+  return 0;
+}
@@ -0,0 +1,94 @@
+/* Benchmark the cost of the static tracepoints of sdt_probes.hpp with no tracer attached
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+/* Build with something like:
+
+g++ -O3 -DNDEBUG -std=c++17 -o sdt_probes_off sdt_probes.cpp
+g++ -O3 -DNDEBUG -DOUTCOME_ENABLE_SDT_PROBES=1 -std=c++17 -o sdt_probes_on sdt_probes.cpp
+
+Prints a CSV of nanoseconds per call of a function which cannot be inlined returning
+a successful and a failed result, and of one which passes either through `OUTCOME_TRY`,
+so the failures pass through the result_failure and try_failure probes. Run both builds
+without a tracer attached to confirm that the probes cost nothing measurable, and
+`readelf -n sdt_probes_on` to see the probes.
+*/
+
+#include "../include/outcome/result.hpp"
+#include "../include/outcome/try.hpp"
+
+#include <chrono>
+#include <stdio.h>
+
+#define ITERATIONS 100000000
+
+#ifdef _MSC_VER
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+using result = OUTCOME_V2_NAMESPACE::result<int, std::error_code>;
+
+template <class F> static double ns_per_op(F &&f)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  volatile size_t sink = f();
+  (void) sink;
+  auto end = std::chrono::high_resolution_clock::now();
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / ITERATIONS;
+}
+
+NOINLINE result produce(int n)
+{
+  if(n < 0)
+  {
+    return std::make_error_code(std::errc::invalid_argument);
+  }
+  return n;
+}
+
+NOINLINE result forward(int n)
+{
+  OUTCOME_TRY(v, produce(n));
+  return v + 1;
+}
+
+template <class F> static double benchmark(F &&f, int sign)
+{
+  return ns_per_op([&] {
+    size_t checksum = 0;
+    for(int n = 0; n < ITERATIONS; n++)
+    {
+      result r = f(sign * (n & 1023));
+      checksum += r ? r.assume_value() : r.assume_error().value();
+    }
+    return checksum;
+  });
+}
+
+int main()
+{
+  printf("probes,success ns,failure ns,try success ns,try failure ns\n");
+  printf("%s,%f,%f,%f,%f\n", (OUTCOME_ENABLE_SDT_PROBES && OUTCOME_SDT_PROBES_AVAILABLE) ? "enabled" : "disabled", benchmark(produce, 1), benchmark(produce, -1), benchmark(forward, 1), benchmark(forward, -1));
+  return 0;
+}
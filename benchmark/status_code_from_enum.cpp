@@ -0,0 +1,182 @@
+/* Benchmark status code domains generated from enum tables against a hand written domain
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++17 status_code_from_enum.cpp
+
+Prints a CSV of nanoseconds per call of ITERATIONS message and equivalence
+calls, for the hand written `_arithmetic_errc_domain` of
+test/tests/experimental-p0709a.cpp and for the same domain generated by
+`<outcome/experimental/status_code_from_enum.hpp>`, through codes of the
+domain and through type erased `system_code`s.
+*/
+
+#include "../include/outcome/experimental/status_code_from_enum.hpp"
+
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <stdio.h>
+
+#define ITERATIONS 10000000
+
+enum class arithmetic_errc
+{
+  success,
+  divide_by_zero,
+  integer_divide_overflows,
+  not_integer_division,
+};
+
+// The hand written domain from test/tests/experimental-p0709a.cpp, befriending status_code so it can call message()
+class _arithmetic_errc_domain;
+using arithmetic_errc_error = SYSTEM_ERROR2_NAMESPACE::status_code<_arithmetic_errc_domain>;
+
+class _arithmetic_errc_domain : public SYSTEM_ERROR2_NAMESPACE::status_code_domain
+{
+  template <class> friend class SYSTEM_ERROR2_NAMESPACE::status_code;
+  using _base = SYSTEM_ERROR2_NAMESPACE::status_code_domain;
+
+public:
+  using value_type = arithmetic_errc;
+
+  constexpr explicit _arithmetic_errc_domain(typename _base::unique_id_type id = 0x290f170194f0c6c7) noexcept : _base(id) {}
+  static inline constexpr const _arithmetic_errc_domain &get();
+
+  virtual _base::string_ref name() const noexcept override final  // NOLINT
+  {
+    static string_ref v("arithmetic error domain");
+    return v;  // NOLINT
+  }
+
+protected:
+  virtual bool _do_failure(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code) const noexcept override final  // NOLINT
+  {
+    assert(code.domain() == *this);                                     // NOLINT
+    const auto &c1 = static_cast<const arithmetic_errc_error &>(code);  // NOLINT
+    return c1.value() != arithmetic_errc::success;
+  }
+  virtual bool _do_equivalent(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &, const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const noexcept override final { return false; }  // NOLINT
+  virtual SYSTEM_ERROR2_NAMESPACE::generic_code _generic_code(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const noexcept override final { return {}; }                         // NOLINT
+  virtual _base::string_ref _do_message(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code) const noexcept override final                                                          // NOLINT
+  {
+    assert(code.domain() == *this);                                     // NOLINT
+    const auto &c1 = static_cast<const arithmetic_errc_error &>(code);  // NOLINT
+    switch(c1.value())
+    {
+    case arithmetic_errc::success:
+      return _base::string_ref("success");
+    case arithmetic_errc::divide_by_zero:
+      return _base::string_ref("divide by zero");
+    case arithmetic_errc::integer_divide_overflows:
+      return _base::string_ref("integer divide overflows");
+    case arithmetic_errc::not_integer_division:
+      return _base::string_ref("not integer division");
+    }
+    return _base::string_ref("unknown");
+  }
+  SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &) const override final { abort(); }  // NOLINT
+};
+
+constexpr _arithmetic_errc_domain arithmetic_errc_domain;
+inline constexpr const _arithmetic_errc_domain &_arithmetic_errc_domain::get()
+{
+  return arithmetic_errc_domain;
+}
+
+// The same domain, generated
+enum class generated_arithmetic_errc
+{
+  success,
+  divide_by_zero,
+  integer_divide_overflows,
+  not_integer_division,
+};
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace experimental
+{
+  template <> struct enum_status_code_traits<generated_arithmetic_errc>
+  {
+    static constexpr const char *domain_name = "arithmetic error domain";
+    static constexpr unsigned long long domain_id = 0x3d1f5b1e24c8b5d7;
+    static constexpr enum_status_code_mapping<generated_arithmetic_errc> mappings[] = {
+    {generated_arithmetic_errc::success, "success", errc::success},                                            //
+    {generated_arithmetic_errc::divide_by_zero, "divide by zero", errc::unknown},                              //
+    {generated_arithmetic_errc::integer_divide_overflows, "integer divide overflows", errc::unknown},          //
+    {generated_arithmetic_errc::not_integer_division, "not integer division", errc::unknown}                  //
+    };
+  };
+#if __cplusplus < 201700L && (!defined(_MSVC_LANG) || _MSVC_LANG < 201700L)
+  constexpr enum_status_code_mapping<generated_arithmetic_errc> enum_status_code_traits<generated_arithmetic_errc>::mappings[];
+#endif
+}  // namespace experimental
+OUTCOME_V2_NAMESPACE_END
+
+// Tell status code about the available implicit conversions
+inline arithmetic_errc_error make_status_code(arithmetic_errc e)
+{
+  return arithmetic_errc_error(SYSTEM_ERROR2_NAMESPACE::in_place, e);
+}
+inline OUTCOME_V2_NAMESPACE::experimental::enum_status_code<generated_arithmetic_errc> make_status_code(generated_arithmetic_errc e)
+{
+  return OUTCOME_V2_NAMESPACE::experimental::enum_status_code<generated_arithmetic_errc>(SYSTEM_ERROR2_NAMESPACE::in_place, e);
+}
+
+template <class F> static double ns_per_op(F &&f)
+{
+  size_t checksum = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int n = 0; n < ITERATIONS; n++)
+  {
+    checksum += f(n & 3);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  volatile size_t sink = checksum;
+  (void) sink;
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / ITERATIONS;
+}
+
+template <class Enum, class Code> static void benchmark(const char *name)
+{
+  using OUTCOME_V2_NAMESPACE::experimental::system_code;
+  Code codes[4] = {Code(static_cast<Enum>(0)), Code(static_cast<Enum>(1)), Code(static_cast<Enum>(2)), Code(static_cast<Enum>(3))};
+  system_code erased[4] = {system_code(codes[0]), system_code(codes[1]), system_code(codes[2]), system_code(codes[3])};
+  volatile int offset = 1;
+  const double message_ns = ns_per_op([&](int n) { return codes[n].message().size(); });
+  const double enum_ns = ns_per_op([&](int n) { return static_cast<size_t>(codes[n] == static_cast<Enum>((n + offset) & 3)); });
+  const double code_ns = ns_per_op([&](int n) { return static_cast<size_t>(codes[n] == codes[(n + offset) & 3]); });
+  const double erased_message_ns = ns_per_op([&](int n) { return erased[n].message().size(); });
+  const double erased_enum_ns = ns_per_op([&](int n) { return static_cast<size_t>(erased[n] == static_cast<Enum>((n + offset) & 3)); });
+  printf("%s,%f,%f,%f,%f,%f\n", name, message_ns, enum_ns, code_ns, erased_message_ns, erased_enum_ns);
+}
+
+int main()
+{
+  printf("domain,message() ns,== enum ns,== code ns,system_code message() ns,system_code == enum ns\n");
+  benchmark<arithmetic_errc, arithmetic_errc_error>("hand written");
+  benchmark<generated_arithmetic_errc, OUTCOME_V2_NAMESPACE::experimental::enum_status_code<generated_arithmetic_errc>>("generated");
+  return 0;
+}
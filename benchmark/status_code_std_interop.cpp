@@ -0,0 +1,129 @@
+/* Benchmark conversions between std::error_code and status_code against copies
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++17 status_code_std_interop.cpp
+
+Prints a CSV of nanoseconds per operation of ITERATIONS copies of a code or
+result, and of ITERATIONS conversions of the same into the other kind by
+`<outcome/experimental/status_code_std_interop.hpp>`, for codes of the generic,
+system and of some other domain. A conversion ought to cost no more than a copy.
+*/
+
+#include "../include/outcome/experimental/status_code_from_enum.hpp"
+#include "../include/outcome/experimental/status_code_std_interop.hpp"
+
+#include <chrono>
+#include <stdio.h>
+
+#define ITERATIONS 10000000
+
+enum class other_errc
+{
+  success,
+  failed
+};
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace experimental
+{
+  template <> struct enum_status_code_traits<other_errc>
+  {
+    static constexpr const char *domain_name = "other error domain";
+    static constexpr unsigned long long domain_id = 0x7b4e0d5c9a18f263;
+    static constexpr enum_status_code_mapping<other_errc> mappings[] = {
+    {other_errc::success, "success", errc::success},  //
+    {other_errc::failed, "failed", errc::io_error}    //
+    };
+  };
+#if __cplusplus < 201700L && (!defined(_MSVC_LANG) || _MSVC_LANG < 201700L)
+  constexpr enum_status_code_mapping<other_errc> enum_status_code_traits<other_errc>::mappings[];
+#endif
+}  // namespace experimental
+OUTCOME_V2_NAMESPACE_END
+
+template <class F> static double ns_per_op(F &&f)
+{
+  size_t checksum = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(int n = 0; n < ITERATIONS; n++)
+  {
+    checksum += f(n & 3);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  volatile size_t sink = checksum;
+  (void) sink;
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / ITERATIONS;
+}
+
+// The value, or the error value, of each so the work cannot be optimised out
+static size_t value_of(const std::error_code &ec) { return static_cast<size_t>(ec.value()); }
+static size_t value_of(const OUTCOME_V2_NAMESPACE::experimental::system_code &sc) { return static_cast<size_t>(sc.value()); }
+template <class T> static size_t value_of(const T &r) { return r.has_value() ? static_cast<size_t>(r.value()) : value_of(r.error()); }
+
+int main()
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  using OUTCOME_V2_NAMESPACE::std_result;
+  printf("conversion,copy ns,convert ns\n");
+
+  const std::error_code generic_ecs[4] = {std::make_error_code(std::errc::invalid_argument), std::make_error_code(std::errc::io_error),
+                                          std::make_error_code(std::errc::no_such_file_or_directory), std::make_error_code(std::errc::permission_denied)};
+  const std::error_code system_ecs[4] = {std::error_code(EINVAL, std::system_category()), std::error_code(EIO, std::system_category()),
+                                         std::error_code(ENOENT, std::system_category()), std::error_code(EACCES, std::system_category())};
+  const std::error_code other_ecs[4] = {to_error_code(enum_status_code<other_errc>(other_errc::failed)), to_error_code(enum_status_code<other_errc>(other_errc::success)),
+                                        to_error_code(enum_status_code<other_errc>(other_errc::failed)), to_error_code(enum_status_code<other_errc>(other_errc::success))};
+  const std::error_code *ecs[3] = {generic_ecs, system_ecs, other_ecs};
+  const char *names[3] = {"generic", "system", "other domain"};
+  for(int i = 0; i < 3; i++)
+  {
+    const std::error_code *e = ecs[i];
+    const double copy_ns = ns_per_op([&](int n) {
+      const std::error_code x(e[n]);
+      return value_of(x);
+    });
+    const double convert_ns = ns_per_op([&](int n) { return value_of(to_status_code(e[n])); });
+    printf("std::error_code to system_code (%s),%f,%f\n", names[i], copy_ns, convert_ns);
+  }
+  for(int i = 0; i < 3; i++)
+  {
+    system_code s[4] = {to_status_code(ecs[i][0]), to_status_code(ecs[i][1]), to_status_code(ecs[i][2]), to_status_code(ecs[i][3])};
+    const double copy_ns = ns_per_op([&](int n) { return value_of(s[n].clone()); });
+    const double convert_ns = ns_per_op([&](int n) { return value_of(to_error_code(s[n])); });
+    printf("system_code to std::error_code (%s),%f,%f\n", names[i], copy_ns, convert_ns);
+  }
+  {
+    const std_result<int> r[4] = {1, generic_ecs[1], 3, system_ecs[3]};
+    const double copy_ns = ns_per_op([&](int n) { return value_of(std_result<int>(r[n])); });
+    const double convert_ns = ns_per_op([&](int n) { return value_of(status_result<int>(r[n])); });
+    printf("std_result<int> to status_result<int>,%f,%f\n", copy_ns, convert_ns);
+  }
+  {
+    const status_result<int> r[4] = {1, generic_code(errc::io_error), 3, posix_code(EACCES)};
+    const double copy_ns = ns_per_op([&](int n) { return value_of(status_result<int>(r[n].has_value() ? status_result<int>(r[n].value()) : status_result<int>(r[n].error().clone()))); });
+    const double convert_ns = ns_per_op([&](int n) { return value_of(std_result<int>(r[n])); });
+    printf("status_result<int> to std_result<int>,%f,%f\n", copy_ns, convert_ns);
+  }
+  return 0;
+}
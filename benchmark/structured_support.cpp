@@ -0,0 +1,79 @@
+/* Benchmark of streaming JSON and CBOR encoding
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++14 structured_support.cpp
+
+Prints a CSV of records per second encoded into JSON lines and into a CBOR
+sequence, each into a reused fixed size buffer, for successful results, and
+for failed results of generic_code (whose domain name and message are
+written straight from their string_refs). The target is one million records
+per second per thread.
+*/
+
+#include "../include/outcome/experimental/status_result.hpp"
+#include "../include/outcome/experimental/structured_support.hpp"
+
+#include <chrono>
+#include <stdio.h>
+
+#define ITERATIONS 4000000
+
+using namespace OUTCOME_V2_NAMESPACE;
+using namespace OUTCOME_V2_NAMESPACE::experimental;
+
+static char buffer[1 << 20];
+
+template <class F> double records_per_sec(const char *desc, F &&f)
+{
+  size_t bytes = 0;
+  char *p = buffer;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(size_t n = 0; n < ITERATIONS; n++)
+  {
+    if(p - buffer > static_cast<ptrdiff_t>(sizeof(buffer) - 1024))
+    {
+      bytes += static_cast<size_t>(p - buffer);
+      p = buffer;
+    }
+    p = f(p, n);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  bytes += static_cast<size_t>(p - buffer);
+  const double secs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / 1000000000.0;
+  printf("%s,%f,%f\n", desc, ITERATIONS / secs, static_cast<double>(bytes) / ITERATIONS);
+  return ITERATIONS / secs;
+}
+
+int main()
+{
+  const SYSTEM_ERROR2_NAMESPACE::errc errcs[] = {SYSTEM_ERROR2_NAMESPACE::errc::invalid_argument, SYSTEM_ERROR2_NAMESPACE::errc::no_such_file_or_directory, SYSTEM_ERROR2_NAMESPACE::errc::permission_denied, SYSTEM_ERROR2_NAMESPACE::errc::timed_out};
+  printf("encoding,records per sec,bytes per record\n");
+  records_per_sec("JSON value", [](char *p, size_t n) { return json_encode(p, status_result<uint64_t>(n)); });
+  records_per_sec("CBOR value", [](char *p, size_t n) { return cbor_encode(p, status_result<uint64_t>(n)); });
+  records_per_sec("JSON generic_code", [&](char *p, size_t n) { return json_encode(p, status_result<uint64_t>(SYSTEM_ERROR2_NAMESPACE::generic_code(errcs[n & 3]))); });
+  records_per_sec("CBOR generic_code", [&](char *p, size_t n) { return cbor_encode(p, status_result<uint64_t>(SYSTEM_ERROR2_NAMESPACE::generic_code(errcs[n & 3]))); });
+  return 0;
+}
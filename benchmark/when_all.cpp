@@ -0,0 +1,200 @@
+/* Benchmark fan-out latency of when_all_group against std::future
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* Build with something like:
+
+g++ -O3 -std=c++14 when_all.cpp -lpthread
+
+Prints a CSV of the mean microseconds from issuing WIDTH operations to a small pool
+of worker threads until their aggregate result is available, both when every operation
+succeeds and when the operation half way through fails. when_all_group completes as soon
+as the failure is delivered, a vector of std::future must be waited upon in turn.
+*/
+
+#include "../include/outcome/result.hpp"
+#include "../include/outcome/when_all.hpp"
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#define ROUNDS 200
+#define WORK_PER_OPERATION 64
+
+namespace outcome = OUTCOME_V2_NAMESPACE;
+using result_type = outcome::result<int>;
+
+// Workers are started once, and each round deliver every index congruent to their own
+class worker_pool
+{
+  std::vector<std::thread> _threads;
+  std::atomic<unsigned> _epoch{0}, _done{0};
+  std::atomic<bool> _quit{false};
+  std::function<void(size_t)> _deliver;
+  size_t _width{0};
+
+public:
+  explicit worker_pool(unsigned n)
+  {
+    for(unsigned t = 0; t < n; t++)
+    {
+      _threads.emplace_back([this, t, n] {
+        unsigned seen = 0;
+        for(;;)
+        {
+          unsigned epoch;
+          while((epoch = _epoch.load(std::memory_order_acquire)) == seen && !_quit.load(std::memory_order_relaxed))
+          {
+            std::this_thread::yield();
+          }
+          if(_quit.load(std::memory_order_relaxed))
+          {
+            return;
+          }
+          seen = epoch;
+          for(size_t i = t; i < _width; i += n)
+          {
+            _deliver(i);
+          }
+          _done.fetch_add(1, std::memory_order_release);
+        }
+      });
+    }
+  }
+  ~worker_pool()
+  {
+    _quit = true;
+    for(auto &t : _threads)
+    {
+      t.join();
+    }
+  }
+  void issue(size_t width, std::function<void(size_t)> deliver)
+  {
+    _width = width;
+    _deliver = std::move(deliver);
+    _done.store(0, std::memory_order_relaxed);
+    _epoch.fetch_add(1, std::memory_order_release);
+  }
+  void drain()
+  {
+    while(_done.load(std::memory_order_acquire) != _threads.size())
+    {
+      std::this_thread::yield();
+    }
+  }
+};
+
+static result_type operation(size_t i, size_t fail_at)
+{
+  uint32_t h = static_cast<uint32_t>(i);
+  for(int n = 0; n < WORK_PER_OPERATION; n++)
+  {
+    h ^= h << 13;
+    h ^= h >> 17;
+    h ^= h << 5;
+  }
+  if(i == fail_at)
+  {
+    return std::make_error_code(std::errc::invalid_argument);
+  }
+  return static_cast<int>(h);
+}
+
+volatile size_t sink;
+
+static double fanout_group(worker_pool &pool, size_t width, size_t fail_at)
+{
+  double total = 0;
+  for(int round = 0; round < ROUNDS; round++)
+  {
+    auto begin = std::chrono::high_resolution_clock::now();
+    outcome::when_all_group<result_type> group(width);
+    auto producer = group.get_producer();
+    pool.issue(width, [=](size_t i) mutable {
+      if(producer.cancelled())
+      {
+        producer.discard();
+        return;
+      }
+      producer.set(i, operation(i, fail_at));
+    });
+    auto &r = group.wait();
+    sink = r.has_value();
+    auto end = std::chrono::high_resolution_clock::now();
+    total += static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+    pool.drain();
+  }
+  return total / ROUNDS / 1000.0;
+}
+
+static double fanout_futures(worker_pool &pool, size_t width, size_t fail_at)
+{
+  double total = 0;
+  for(int round = 0; round < ROUNDS; round++)
+  {
+    auto begin = std::chrono::high_resolution_clock::now();
+    std::vector<std::promise<result_type>> promises(width);
+    std::vector<std::future<result_type>> futures;
+    futures.reserve(width);
+    for(auto &p : promises)
+    {
+      futures.push_back(p.get_future());
+    }
+    pool.issue(width, [&](size_t i) { promises[i].set_value(operation(i, fail_at)); });
+    std::vector<int> values;
+    values.reserve(width);
+    for(auto &f : futures)
+    {
+      auto r = f.get();
+      if(!r)
+      {
+        break;
+      }
+      values.push_back(r.value());
+    }
+    sink = values.size();
+    auto end = std::chrono::high_resolution_clock::now();
+    total += static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+    pool.drain();
+  }
+  return total / ROUNDS / 1000.0;
+}
+
+int main(void)
+{
+  const unsigned hw = std::thread::hardware_concurrency();
+  worker_pool pool((hw > 4) ? 4 : (hw > 0 ? hw : 1));
+  printf("\"Width\",\"when_all_group success us\",\"std::future success us\",\"when_all_group failure us\",\"std::future failure us\"\n");
+  for(size_t width : {10, 100, 1000})
+  {
+    double gs = fanout_group(pool, width, SIZE_MAX), fs = fanout_futures(pool, width, SIZE_MAX);
+    double gf = fanout_group(pool, width, width / 2), ff = fanout_futures(pool, width, width / 2);
+    printf("%zu,%f,%f,%f,%f\n", width, gs, fs, gf, ff);
+  }
+  return 0;
+}
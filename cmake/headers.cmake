@@ -4,8 +4,10 @@ set(outcome_HEADERS
   "include/outcome/bad_access.hpp"
   "include/outcome/basic_outcome.hpp"
   "include/outcome/basic_result.hpp"
+  "include/outcome/binary_support.hpp"
   "include/outcome/boost_outcome.hpp"
   "include/outcome/boost_result.hpp"
+  "include/outcome/channel.hpp"
   "include/outcome/config.hpp"
   "include/outcome/convert.hpp"
   "include/outcome/detail/basic_outcome_exception_observers.hpp"
@@ -15,11 +17,15 @@ set(outcome_HEADERS
   "include/outcome/detail/basic_result_final.hpp"
   "include/outcome/detail/basic_result_storage.hpp"
   "include/outcome/detail/basic_result_value_observers.hpp"
+  "include/outcome/detail/coroutine_support.hpp"
+  "include/outcome/detail/namespace.hpp"
   "include/outcome/detail/revision.hpp"
+  "include/outcome/detail/spin_wait.hpp"
   "include/outcome/detail/trait_std_error_code.hpp"
   "include/outcome/detail/trait_std_exception.hpp"
   "include/outcome/detail/value_storage.hpp"
   "include/outcome/detail/version.hpp"
+  "include/outcome/error_provenance.hpp"
   "include/outcome/experimental/result.h"
   "include/outcome/experimental/status-code/include/com_code.hpp"
   "include/outcome/experimental/status-code/include/config.hpp"
@@ -42,12 +48,27 @@ set(outcome_HEADERS
   "include/outcome/experimental/status-code/include/system_error2.hpp"
   "include/outcome/experimental/status-code/include/win32_code.hpp"
   "include/outcome/experimental/status-code/single-header/system_error2.hpp"
+  "include/outcome/experimental/status_code_c_api.hpp"
+  "include/outcome/experimental/status_code_constant_domain.hpp"
+  "include/outcome/experimental/status_code_from_enum.hpp"
+  "include/outcome/experimental/status_code_std_interop.hpp"
+  "include/outcome/experimental/status_format_support.hpp"
+  "include/outcome/experimental/status_hash_support.hpp"
   "include/outcome/experimental/status_outcome.hpp"
   "include/outcome/experimental/status_result.hpp"
+  "include/outcome/experimental/status_result_batch.hpp"
+  "include/outcome/experimental/structured_support.hpp"
+  "include/outcome/format_support.hpp"
+  "include/outcome/hash_support.hpp"
+  "include/outcome/instantiations.hpp"
   "include/outcome/iostream_support.hpp"
+  "include/outcome/memo_cache.hpp"
+  "include/outcome/minimal_result.hpp"
   "include/outcome/outcome.hpp"
   "include/outcome/outcome.natvis"
+  "include/outcome/parallel.hpp"
   "include/outcome/policy/all_narrow.hpp"
+  "include/outcome/policy/all_narrow_logged.hpp"
   "include/outcome/policy/base.hpp"
   "include/outcome/policy/fail_to_compile_observers.hpp"
   "include/outcome/policy/outcome_error_code_throw_as_system_error.hpp"
@@ -57,10 +78,15 @@ set(outcome_HEADERS
   "include/outcome/policy/terminate.hpp"
   "include/outcome/policy/throw_bad_result_access.hpp"
   "include/outcome/result.hpp"
+  "include/outcome/result_slot.hpp"
+  "include/outcome/result_view.hpp"
+  "include/outcome/sdt_probes.hpp"
   "include/outcome/std_outcome.hpp"
   "include/outcome/std_result.hpp"
   "include/outcome/success_failure.hpp"
   "include/outcome/trait.hpp"
   "include/outcome/try.hpp"
+  "include/outcome/try_macros.hpp"
   "include/outcome/utils.hpp"
+  "include/outcome/when_all.hpp"
 )
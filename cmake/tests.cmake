@@ -4,14 +4,21 @@ set(outcome_TESTS
   "test/single-header-test.cpp"
   "test/tests/comparison.cpp"
   "test/tests/constexpr.cpp"
+  "test/tests/constructor-predicates.cpp"
   "test/tests/containers.cpp"
   "test/tests/core-outcome.cpp"
   "test/tests/core-result.cpp"
   "test/tests/default-construction.cpp"
+  "test/tests/error-provenance.cpp"
   "test/tests/experimental-core-outcome-status.cpp"
   "test/tests/experimental-core-result-status.cpp"
   "test/tests/experimental-p0709a.cpp"
+  "test/tests/experimental-result-batch.cpp"
+  "test/tests/experimental-status-code-from-enum.cpp"
+  "test/tests/experimental-status-code-std-interop.cpp"
   "test/tests/fileopen.cpp"
+  "test/tests/format-support.cpp"
+  "test/tests/hash-support.cpp"
   "test/tests/hooks.cpp"
   "test/tests/issue0007.cpp"
   "test/tests/issue0009.cpp"
@@ -29,13 +36,23 @@ set(outcome_TESTS
   "test/tests/issue0140.cpp"
   "test/tests/issue0182.cpp"
   "test/tests/issue0203.cpp"
+  "test/tests/memo-cache.cpp"
+  "test/tests/minimal-result.cpp"
+  "test/tests/narrow-violation-log.cpp"
   "test/tests/noexcept-propagation.cpp"
+  "test/tests/parallel-traverse.cpp"
   "test/tests/propagate.cpp"
+  "test/tests/result-channel.cpp"
+  "test/tests/result-slot.cpp"
+  "test/tests/result-view.cpp"
+  "test/tests/sdt-probes.cpp"
   "test/tests/serialisation.cpp"
+  "test/tests/structured-support.cpp"
   "test/tests/success-failure.cpp"
   "test/tests/swap.cpp"
   "test/tests/udts.cpp"
   "test/tests/value-or-error.cpp"
+  "test/tests/when-all.cpp"
 )
 # DO NOT EDIT, GENERATED BY SCRIPT
 set(outcome_COMPILE_TESTS
@@ -46,4 +63,5 @@ set(outcome_COMPILE_FAIL_TESTS
   "test/compile-fail/outcome-int-int-1.cpp"
   "test/compile-fail/result-int-int-1.cpp"
   "test/compile-fail/result-int-int-2.cpp"
+  "test/compile-fail/result-int-long-1.cpp"
 )
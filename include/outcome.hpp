@@ -22,8 +22,9 @@ Distributed under the Boost Software License, Version 1.0.
           http://www.boost.org/LICENSE_1_0.txt)
 */
 
-#if defined(__cpp_modules) && !defined(GENERATING_OUTCOME_MODULE_INTERFACE)
-import outcome_v2_0;
+#if defined(OUTCOME_USE_CXX_MODULE) && !defined(GENERATING_OUTCOME_MODULE_INTERFACE)
+import outcome;
+#include "outcome/try_macros.hpp"
 #else
 #include "outcome/iostream_support.hpp"
 #include "outcome/try.hpp"
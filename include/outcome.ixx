@@ -1,4 +1,63 @@
+// The C++ Module interface of Outcome, which `import outcome;` brings in.
+// As Modules cannot export macros, importers include "outcome/try_macros.hpp" for OUTCOME_TRY.
+// Nor is the standard library exported, so importers include the standard headers they use.
+module;
+
 // Tell the headers we are generating the interface for the library
 #define GENERATING_OUTCOME_MODULE_INTERFACE
-export module outcome_v2_0;  // OUTCOME_MODULE_NAME
-#include "outcome.hpp"
+
+// The global module fragment: everything which is not Outcome, so it is not attached to the module
+#include "outcome/detail/namespace.hpp"
+#include "quickcpplib/config.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <initializer_list>
+#include <iosfwd>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if !defined(OUTCOME_MODULE_DISABLE_EXPERIMENTAL)
+#include "outcome/experimental/status-code/include/system_error2.hpp"
+#endif
+
+export module outcome;
+
+#include "outcome/iostream_support.hpp"
+#include "outcome/std_outcome.hpp"
+#include "outcome/std_result.hpp"
+#include "outcome/try.hpp"
+#include "outcome/utils.hpp"
+
+#if !defined(OUTCOME_MODULE_DISABLE_EXPERIMENTAL)
+#include "outcome/experimental/status_outcome.hpp"
+
+// status_code lives in the global module fragment, so export the names importers need. These are
+// aliases rather than using declarations, which GCC 12 does not export for global module entities.
+export namespace OUTCOME_V2_NAMESPACE::experimental
+{
+  using errc = SYSTEM_ERROR2_NAMESPACE::errc;
+  template <class T> using erased = SYSTEM_ERROR2_NAMESPACE::erased<T>;
+  template <class DomainType> using errored_status_code = SYSTEM_ERROR2_NAMESPACE::errored_status_code<DomainType>;
+  using generic_code = SYSTEM_ERROR2_NAMESPACE::generic_code;
+  using posix_code = SYSTEM_ERROR2_NAMESPACE::posix_code;
+  template <class DomainType> using status_code = SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>;
+  using status_code_domain = SYSTEM_ERROR2_NAMESPACE::status_code_domain;
+  template <class DomainType> using status_error = SYSTEM_ERROR2_NAMESPACE::status_error<DomainType>;
+  using system_code = SYSTEM_ERROR2_NAMESPACE::system_code;
+}  // namespace OUTCOME_V2_NAMESPACE::experimental
+
+#endif
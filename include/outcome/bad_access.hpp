@@ -86,6 +86,18 @@ public:
   }
 };
 
+namespace detail
+{
+  /* The throws of the policies, out of line so each instantiation of each wide observer does
+  not carry its own copy of the construction of the exception. Only the error type is a
+  template parameter, so these are shared by all results with the same error type. They never
+  return, so the compiler need not keep the state of the caller alive across the call.
+  */
+  QUICKCPPLIB_NORETURN OUTCOME_COLD_NOINLINE inline void throw_bad_result_access(const char *what) { OUTCOME_THROW_EXCEPTION(bad_result_access(what)); }    // NOLINT
+  QUICKCPPLIB_NORETURN OUTCOME_COLD_NOINLINE inline void throw_bad_outcome_access(const char *what) { OUTCOME_THROW_EXCEPTION(bad_outcome_access(what)); }  // NOLINT
+  template <class S, class Error> QUICKCPPLIB_NORETURN OUTCOME_COLD_NOINLINE inline void throw_bad_result_access_with(Error &&error) { OUTCOME_THROW_EXCEPTION(bad_result_access_with<S>(static_cast<Error &&>(error))); }  // NOLINT
+}  // namespace detail
+
 OUTCOME_V2_NAMESPACE_END
 
 #endif
@@ -44,52 +44,89 @@ class basic_outcome;
 
 namespace detail
 {
+  /* The predicates of the converting constructors, which as per those of basic_result are concepts
+  under native C++ 20 Concepts. Each refines the corresponding predicate of basic_result, where
+  there is one, so subsumes it.
+  */
+  template <class value_type, class error_type, class exception_type>
+  OUTCOME_PREDICATE outcome_implicit_constructors_enabled =            //
+  result_implicit_constructors_enabled<value_type, error_type>         //
+  && !detail::is_implicitly_constructible<value_type, exception_type>  //
+  && !detail::is_implicitly_constructible<error_type, exception_type>  //
+  && !detail::is_implicitly_constructible<exception_type, value_type>  //
+  && !detail::is_implicitly_constructible<exception_type, error_type>;
+
+  template <class value_type, class error_type, class exception_type, class T>
+  OUTCOME_PREDICATE outcome_value_converting_constructible =            //
+  outcome_implicit_constructors_enabled<value_type, error_type, exception_type>  //
+  && result_value_converting_constructible<value_type, error_type, T>           //
+  && !detail::is_implicitly_constructible<exception_type, T>;                   // deliberately less tolerant of ambiguity than result's edition
+  template <class value_type, class error_type, class exception_type, class T>
+  OUTCOME_PREDICATE outcome_error_converting_constructible =            //
+  outcome_implicit_constructors_enabled<value_type, error_type, exception_type>  //
+  && result_error_converting_constructible<value_type, error_type, T>           //
+  && !detail::is_implicitly_constructible<exception_type, T>;                   // deliberately less tolerant of ambiguity than result's edition
+  template <class error_type, class exception_type, class ErrorCondEnum>
+  OUTCOME_PREDICATE outcome_error_condition_converting_constructible =  //
+  error_condition_converting_constructible<error_type, ErrorCondEnum> && !detail::is_implicitly_constructible<exception_type, ErrorCondEnum>;
+  template <class value_type, class error_type, class exception_type, class T>
+  OUTCOME_PREDICATE outcome_exception_converting_constructible =                 //
+  outcome_implicit_constructors_enabled<value_type, error_type, exception_type>  //
+  && !is_in_place_type_t<std::decay_t<T>>::value                                 // not in place construction
+  && !detail::is_implicitly_constructible<value_type, T> && !detail::is_implicitly_constructible<error_type, T> && detail::is_implicitly_constructible<exception_type, T>;
+  template <class value_type, class error_type, class exception_type, class T, class U>
+  OUTCOME_PREDICATE outcome_error_exception_converting_constructible =                                         //
+  outcome_implicit_constructors_enabled<value_type, error_type, exception_type>                                 //
+  && !is_in_place_type_t<std::decay_t<T>>::value                                                                // not in place construction
+  && !detail::is_implicitly_constructible<value_type, T> && detail::is_implicitly_constructible<error_type, T>  //
+  && !detail::is_implicitly_constructible<value_type, U> && detail::is_implicitly_constructible<exception_type, U>;
+
+  // Predicate for any constructors of a basic_outcome to be available at all
+  template <class value_type, class error_type, class exception_type>
+  OUTCOME_PREDICATE outcome_constructors_enabled =                                                                                                              //
+  (!std::is_same<std::decay_t<value_type>, std::decay_t<error_type>>::value || (std::is_void<value_type>::value && std::is_void<error_type>::value))             //
+  && (!std::is_same<std::decay_t<value_type>, std::decay_t<exception_type>>::value || (std::is_void<value_type>::value && std::is_void<exception_type>::value))  //
+  && (!std::is_same<std::decay_t<error_type>, std::decay_t<exception_type>>::value || (std::is_void<error_type>::value && std::is_void<exception_type>::value));
+
+  // As above, for a basic_outcome `Self` whose constructors are enabled, and which is not `T`
+  template <class Self, class value_type, class error_type, class exception_type, class T>
+  OUTCOME_PREDICATE basic_outcome_value_converting_constructible =  //
+  outcome_constructors_enabled<value_type, error_type, exception_type> && !std::is_same<std::decay_t<T>, Self>::value && outcome_value_converting_constructible<value_type, error_type, exception_type, T>;
+  template <class Self, class value_type, class error_type, class exception_type, class T>
+  OUTCOME_PREDICATE basic_outcome_error_converting_constructible =  //
+  outcome_constructors_enabled<value_type, error_type, exception_type> && !std::is_same<std::decay_t<T>, Self>::value && outcome_error_converting_constructible<value_type, error_type, exception_type, T>;
+  template <class Self, class value_type, class error_type, class exception_type, class ErrorCondEnum>
+  OUTCOME_PREDICATE basic_outcome_error_condition_converting_constructible =  //
+  outcome_constructors_enabled<value_type, error_type, exception_type> && !std::is_same<std::decay_t<ErrorCondEnum>, Self>::value && outcome_error_condition_converting_constructible<error_type, exception_type, ErrorCondEnum>;
+  template <class Self, class value_type, class error_type, class exception_type, class T>
+  OUTCOME_PREDICATE basic_outcome_exception_converting_constructible =  //
+  outcome_constructors_enabled<value_type, error_type, exception_type> && !std::is_same<std::decay_t<T>, Self>::value && outcome_exception_converting_constructible<value_type, error_type, exception_type, T>;
+  template <class Self, class value_type, class error_type, class exception_type, class T, class U>
+  OUTCOME_PREDICATE basic_outcome_error_exception_converting_constructible =  //
+  outcome_constructors_enabled<value_type, error_type, exception_type> && !std::is_same<std::decay_t<T>, Self>::value && outcome_error_exception_converting_constructible<value_type, error_type, exception_type, T, U>;
+
   // May be reused by basic_outcome subclasses to save load on the compiler
   template <class value_type, class error_type, class exception_type> struct outcome_predicates
   {
     using result = result_predicates<value_type, error_type>;
 
     // Predicate for the implicit constructors to be available
-    static constexpr bool implicit_constructors_enabled =                //
-    result::implicit_constructors_enabled                                //
-    && !detail::is_implicitly_constructible<value_type, exception_type>  //
-    && !detail::is_implicitly_constructible<error_type, exception_type>  //
-    && !detail::is_implicitly_constructible<exception_type, value_type>  //
-    && !detail::is_implicitly_constructible<exception_type, error_type>;
+    static constexpr bool implicit_constructors_enabled = outcome_implicit_constructors_enabled<value_type, error_type, exception_type>;
 
     // Predicate for the value converting constructor to be available.
-    template <class T>
-    static constexpr bool enable_value_converting_constructor =  //
-    implicit_constructors_enabled                                //
-    &&result::template enable_value_converting_constructor<T>    //
-    && !detail::is_implicitly_constructible<exception_type, T>;  // deliberately less tolerant of ambiguity than result's edition
+    template <class T> static constexpr bool enable_value_converting_constructor = outcome_value_converting_constructible<value_type, error_type, exception_type, T>;
 
     // Predicate for the error converting constructor to be available.
-    template <class T>
-    static constexpr bool enable_error_converting_constructor =  //
-    implicit_constructors_enabled                                //
-    &&result::template enable_error_converting_constructor<T>    //
-    && !detail::is_implicitly_constructible<exception_type, T>;  // deliberately less tolerant of ambiguity than result's edition
+    template <class T> static constexpr bool enable_error_converting_constructor = outcome_error_converting_constructible<value_type, error_type, exception_type, T>;
 
     // Predicate for the error condition converting constructor to be available.
-    template <class ErrorCondEnum>
-    static constexpr bool enable_error_condition_converting_constructor = result::template enable_error_condition_converting_constructor<ErrorCondEnum>  //
-                                                                          && !detail::is_implicitly_constructible<exception_type, ErrorCondEnum>;
+    template <class ErrorCondEnum> static constexpr bool enable_error_condition_converting_constructor = outcome_error_condition_converting_constructible<error_type, exception_type, ErrorCondEnum>;
 
     // Predicate for the exception converting constructor to be available.
-    template <class T>
-    static constexpr bool enable_exception_converting_constructor =  //
-    implicit_constructors_enabled                                    //
-    && !is_in_place_type_t<std::decay_t<T>>::value                   // not in place construction
-    && !detail::is_implicitly_constructible<value_type, T> && !detail::is_implicitly_constructible<error_type, T> && detail::is_implicitly_constructible<exception_type, T>;
+    template <class T> static constexpr bool enable_exception_converting_constructor = outcome_exception_converting_constructible<value_type, error_type, exception_type, T>;
 
     // Predicate for the error + exception converting constructor to be available.
-    template <class T, class U>
-    static constexpr bool enable_error_exception_converting_constructor =                                         //
-    implicit_constructors_enabled                                                                                 //
-    && !is_in_place_type_t<std::decay_t<T>>::value                                                                // not in place construction
-    && !detail::is_implicitly_constructible<value_type, T> && detail::is_implicitly_constructible<error_type, T>  //
-    && !detail::is_implicitly_constructible<value_type, U> && detail::is_implicitly_constructible<exception_type, U>;
+    template <class T, class U> static constexpr bool enable_error_exception_converting_constructor = outcome_error_exception_converting_constructible<value_type, error_type, exception_type, T, U>;
 
     // Predicate for the converting copy constructor from a compatible outcome to be available.
     template <class T, class U, class V, class W>
@@ -147,26 +184,40 @@ template <class T> using is_basic_outcome = detail::is_basic_outcome<std::decay_
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-template <class T> static constexpr bool is_basic_outcome_v = detail::is_basic_outcome<std::decay_t<T>>::value;
+template <class T> OUTCOME_INLINE_CONSTEXPR bool is_basic_outcome_v = detail::is_basic_outcome<std::decay_t<T>>::value;
 
 namespace hooks
 {
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class... U> constexpr inline void hook_outcome_construction(T * /*unused*/, U &&... /*unused*/) noexcept {}
+  template <class T, class... U> constexpr inline void hook_outcome_construction(T *o, U &&... /*unused*/) noexcept
+  {
+    OUTCOME_SDT_FAILURE(outcome_failure, o);
+    OUTCOME_ERROR_PROVENANCE_ORIGIN(o);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U> constexpr inline void hook_outcome_copy_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_outcome_copy_construction(T *o, U && /*unused*/) noexcept
+  {
+    OUTCOME_ERROR_PROVENANCE_ORIGIN(o);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U> constexpr inline void hook_outcome_move_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_outcome_move_construction(T *o, U && /*unused*/) noexcept
+  {
+    OUTCOME_ERROR_PROVENANCE_ORIGIN(o);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U, class... Args> constexpr inline void hook_outcome_in_place_construction(T * /*unused*/, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept {}
+  template <class T, class U, class... Args> constexpr inline void hook_outcome_in_place_construction(T *o, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept
+  {
+    OUTCOME_SDT_FAILURE(outcome_failure, o);
+    OUTCOME_ERROR_PROVENANCE_ORIGIN(o);
+  }
 
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
@@ -249,48 +300,25 @@ protected:
     using base = detail::outcome_predicates<value_type, error_type, exception_type>;
 
     // Predicate for any constructors to be available at all
-    static constexpr bool constructors_enabled = (!std::is_same<std::decay_t<value_type>, std::decay_t<error_type>>::value || (std::is_void<value_type>::value && std::is_void<error_type>::value))             //
-                                                 && (!std::is_same<std::decay_t<value_type>, std::decay_t<exception_type>>::value || (std::is_void<value_type>::value && std::is_void<exception_type>::value))  //
-                                                 && (!std::is_same<std::decay_t<error_type>, std::decay_t<exception_type>>::value || (std::is_void<error_type>::value && std::is_void<exception_type>::value))  //
-    ;
+    static constexpr bool constructors_enabled = detail::outcome_constructors_enabled<value_type, error_type, exception_type>;
 
     // Predicate for implicit constructors to be available at all
     static constexpr bool implicit_constructors_enabled = constructors_enabled && base::implicit_constructors_enabled;
 
     // Predicate for the value converting constructor to be available.
-    template <class T>
-    static constexpr bool enable_value_converting_constructor =  //
-    constructors_enabled                                         //
-    && !std::is_same<std::decay_t<T>, basic_outcome>::value      // not my type
-    && base::template enable_value_converting_constructor<T>;
+    template <class T> static constexpr bool enable_value_converting_constructor = detail::basic_outcome_value_converting_constructible<basic_outcome, value_type, error_type, exception_type, T>;
 
     // Predicate for the error converting constructor to be available.
-    template <class T>
-    static constexpr bool enable_error_converting_constructor =  //
-    constructors_enabled                                         //
-    && !std::is_same<std::decay_t<T>, basic_outcome>::value      // not my type
-    && base::template enable_error_converting_constructor<T>;
+    template <class T> static constexpr bool enable_error_converting_constructor = detail::basic_outcome_error_converting_constructible<basic_outcome, value_type, error_type, exception_type, T>;
 
     // Predicate for the error condition converting constructor to be available.
-    template <class ErrorCondEnum>
-    static constexpr bool enable_error_condition_converting_constructor =  //
-    constructors_enabled                                                   //
-    && !std::is_same<std::decay_t<ErrorCondEnum>, basic_outcome>::value    // not my type
-    && base::template enable_error_condition_converting_constructor<ErrorCondEnum>;
+    template <class ErrorCondEnum> static constexpr bool enable_error_condition_converting_constructor = detail::basic_outcome_error_condition_converting_constructible<basic_outcome, value_type, error_type, exception_type, ErrorCondEnum>;
 
     // Predicate for the exception converting constructor to be available.
-    template <class T>
-    static constexpr bool enable_exception_converting_constructor =  //
-    constructors_enabled                                             //
-    && !std::is_same<std::decay_t<T>, basic_outcome>::value          // not my type
-    && base::template enable_exception_converting_constructor<T>;
+    template <class T> static constexpr bool enable_exception_converting_constructor = detail::basic_outcome_exception_converting_constructible<basic_outcome, value_type, error_type, exception_type, T>;
 
     // Predicate for the error + exception converting constructor to be available.
-    template <class T, class U>
-    static constexpr bool enable_error_exception_converting_constructor =  //
-    constructors_enabled                                                   //
-    && !std::is_same<std::decay_t<T>, basic_outcome>::value                // not my type
-    && base::template enable_error_exception_converting_constructor<T, U>;
+    template <class T, class U> static constexpr bool enable_error_exception_converting_constructor = detail::basic_outcome_error_exception_converting_constructible<basic_outcome, value_type, error_type, exception_type, T, U>;
 
     // Predicate for the converting constructor from a compatible input to be available.
     template <class T, class U, class V, class W>
@@ -356,7 +384,7 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class T)
-  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_value_converting_constructor<T>))
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::basic_outcome_value_converting_constructible<basic_outcome, value_type, error_type, exception_type, T>))
   constexpr basic_outcome(T &&t, value_converting_constructor_tag /*unused*/ = value_converting_constructor_tag()) noexcept(std::is_nothrow_constructible<value_type, T>::value)  // NOLINT
       : base{in_place_type<typename base::_value_type>, static_cast<T &&>(t)}
       , _ptr()
@@ -368,7 +396,7 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class T)
-  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_error_converting_constructor<T>))
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::basic_outcome_error_converting_constructible<basic_outcome, value_type, error_type, exception_type, T>))
   constexpr basic_outcome(T &&t, error_converting_constructor_tag /*unused*/ = error_converting_constructor_tag()) noexcept(std::is_nothrow_constructible<error_type, T>::value)  // NOLINT
       : base{in_place_type<typename base::_error_type>, static_cast<T &&>(t)}
       , _ptr()
@@ -381,7 +409,7 @@ SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class ErrorCondEnum)
   OUTCOME_TREQUIRES(OUTCOME_TEXPR(error_type(make_error_code(ErrorCondEnum()))),  //
-                    OUTCOME_TPRED(predicate::template enable_error_condition_converting_constructor<ErrorCondEnum>))
+                    OUTCOME_TPRED(detail::basic_outcome_error_condition_converting_constructible<basic_outcome, value_type, error_type, exception_type, ErrorCondEnum>))
   constexpr basic_outcome(ErrorCondEnum &&t, error_condition_converting_constructor_tag /*unused*/ = error_condition_converting_constructor_tag()) noexcept(noexcept(error_type(make_error_code(static_cast<ErrorCondEnum &&>(t)))))  // NOLINT
       : base{in_place_type<typename base::_error_type>, make_error_code(t)}
   {
@@ -392,7 +420,7 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class T)
-  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_exception_converting_constructor<T>))
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::basic_outcome_exception_converting_constructible<basic_outcome, value_type, error_type, exception_type, T>))
   constexpr basic_outcome(T &&t, exception_converting_constructor_tag /*unused*/ = exception_converting_constructor_tag()) noexcept(std::is_nothrow_constructible<exception_type, T>::value)  // NOLINT
       : base()
       , _ptr(static_cast<T &&>(t))
@@ -405,7 +433,7 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class T, class U)
-  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_error_exception_converting_constructor<T, U>))
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::basic_outcome_error_exception_converting_constructible<basic_outcome, value_type, error_type, exception_type, T, U>))
   constexpr basic_outcome(T &&a, U &&b, error_exception_converting_constructor_tag /*unused*/ = error_exception_converting_constructor_tag()) noexcept(std::is_nothrow_constructible<error_type, T>::value &&std::is_nothrow_constructible<exception_type, U>::value)  // NOLINT
       : base{in_place_type<typename base::_error_type>, static_cast<T &&>(a)}
       , _ptr(static_cast<U &&>(b))
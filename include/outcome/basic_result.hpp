@@ -28,9 +28,11 @@ Distributed under the Boost Software License, Version 1.0.
 #include "config.hpp"
 #include "convert.hpp"
 #include "detail/basic_result_final.hpp"
+#include "error_provenance.hpp"
 
 #include "policy/all_narrow.hpp"
 #include "policy/terminate.hpp"
+#include "sdt_probes.hpp"
 
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -47,44 +49,67 @@ class basic_result;
 
 namespace detail
 {
+  /* The predicates of the converting constructors, which are concepts under native C++ 20 Concepts,
+  so the constraints of the constructors name them directly, the predicates of basic_outcome
+  subsume those of basic_result, and the compiler caches the satisfaction of each. Their
+  conjunctions short circuit, so the cheapest and most discriminating tests are first.
+  */
+  template <class value_type, class error_type>
+  OUTCOME_PREDICATE result_implicit_constructors_enabled =                                                                      //
+  !(trait::is_error_type<std::decay_t<value_type>>::value && trait::is_error_type<std::decay_t<error_type>>::value)            // both value and error types are not whitelisted error types
+  && ((!detail::is_implicitly_constructible<value_type, error_type> && !detail::is_implicitly_constructible<error_type, value_type>)  // if value and error types cannot be constructed into one another
+      || (trait::is_error_type<std::decay_t<error_type>>::value                                                                // if error type is a whitelisted error type
+          && !detail::is_implicitly_constructible<error_type, value_type>                                                      // AND which cannot be constructed from the value type
+          && std::is_integral<value_type>::value));                                                                            // AND the value type is some integral type
+
+  // Weakened to allow result<int, C enum>.
+  template <class value_type, class error_type, class T>
+  OUTCOME_PREDICATE value_converting_constructible =                                                                           //
+  !is_in_place_type_t<std::decay_t<T>>::value                                                                                  // not in place construction
+  && !trait::is_error_type_enum<error_type, std::decay_t<T>>::value                                                            // not an enum valid for my error type
+  && ((detail::is_implicitly_constructible<value_type, T> && !detail::is_implicitly_constructible<error_type, T>)              // is unambiguously for value type
+      || (std::is_same<value_type, std::decay_t<T>>::value && detail::is_implicitly_constructible<value_type, T>) );           // OR is my value type exactly, and constructible from this ref form of T
+  template <class value_type, class error_type, class T>
+  OUTCOME_PREDICATE error_converting_constructible =                                                                           //
+  !is_in_place_type_t<std::decay_t<T>>::value                                                                                  // not in place construction
+  && !trait::is_error_type_enum<error_type, std::decay_t<T>>::value                                                            // not an enum valid for my error type
+  && ((!detail::is_implicitly_constructible<value_type, T> && detail::is_implicitly_constructible<error_type, T>)              // is unambiguously for error type
+      || (std::is_same<error_type, std::decay_t<T>>::value && detail::is_implicitly_constructible<error_type, T>) );           // OR is my error type exactly, and constructible from this ref form of T
+  template <class error_type, class ErrorCondEnum>
+  OUTCOME_PREDICATE error_condition_converting_constructible =                                                                 //
+  !is_in_place_type_t<std::decay_t<ErrorCondEnum>>::value                                                                      // not in place construction
+  && trait::is_error_type_enum<error_type, std::decay_t<ErrorCondEnum>>::value;                                                // is an error condition enum
+
+  template <class value_type, class error_type, class T>
+  OUTCOME_PREDICATE result_value_converting_constructible = result_implicit_constructors_enabled<value_type, error_type> && value_converting_constructible<value_type, error_type, T>;
+  template <class value_type, class error_type, class T>
+  OUTCOME_PREDICATE result_error_converting_constructible = result_implicit_constructors_enabled<value_type, error_type> && error_converting_constructible<value_type, error_type, T>;
+
+  // As above, for a basic_result `Self` whose constructors are enabled, and which is not `T`
+  template <class Self, class value_type, class error_type, class T>
+  OUTCOME_PREDICATE basic_result_value_converting_constructible =  //
+  !std::is_same<std::decay_t<value_type>, std::decay_t<error_type>>::value && !std::is_same<std::decay_t<T>, Self>::value && result_value_converting_constructible<value_type, error_type, T>;
+  template <class Self, class value_type, class error_type, class T>
+  OUTCOME_PREDICATE basic_result_error_converting_constructible =  //
+  !std::is_same<std::decay_t<value_type>, std::decay_t<error_type>>::value && !std::is_same<std::decay_t<T>, Self>::value && result_error_converting_constructible<value_type, error_type, T>;
+  template <class Self, class value_type, class error_type, class ErrorCondEnum>
+  OUTCOME_PREDICATE basic_result_error_condition_converting_constructible =  //
+  !std::is_same<std::decay_t<value_type>, std::decay_t<error_type>>::value && !std::is_same<std::decay_t<ErrorCondEnum>, Self>::value && error_condition_converting_constructible<error_type, ErrorCondEnum>;
+
   // These are reused by basic_outcome to save load on the compiler
   template <class value_type, class error_type> struct result_predicates
   {
     // Predicate for the implicit constructors to be available
-    static constexpr bool implicit_constructors_enabled =                                                                               //
-    !(trait::is_error_type<std::decay_t<value_type>>::value && trait::is_error_type<std::decay_t<error_type>>::value)                   // both value and error types are not whitelisted error types
-    && ((!detail::is_implicitly_constructible<value_type, error_type> && !detail::is_implicitly_constructible<error_type, value_type>)  // if value and error types cannot be constructed into one another
-        || (trait::is_error_type<std::decay_t<error_type>>::value                                                                       // if error type is a whitelisted error type
-            && !detail::is_implicitly_constructible<error_type, value_type>                                                             // AND which cannot be constructed from the value type
-            && std::is_integral<value_type>::value));                                                                                   // AND the value type is some integral type
-
-    // Predicate for the value converting constructor to be available. Weakened to allow result<int, C enum>.
-    template <class T>
-    static constexpr bool enable_value_converting_constructor =                                                      //
-    implicit_constructors_enabled                                                                                    //
-    && !is_in_place_type_t<std::decay_t<T>>::value                                                                   // not in place construction
-    && !trait::is_error_type_enum<error_type, std::decay_t<T>>::value                                                // not an enum valid for my error type
-    && ((detail::is_implicitly_constructible<value_type, T> && !detail::is_implicitly_constructible<error_type, T>)  // is unambiguously for value type
-        || (std::is_same<value_type, std::decay_t<T>>::value                                                         // OR is my value type exactly
-            && detail::is_implicitly_constructible<value_type, T>) );                                                // and my value type is constructible from this ref form of T
-
-
-    // Predicate for the error converting constructor to be available. Weakened to allow result<int, C enum>.
-    template <class T>
-    static constexpr bool enable_error_converting_constructor =                                                      //
-    implicit_constructors_enabled                                                                                    //
-    && !is_in_place_type_t<std::decay_t<T>>::value                                                                   // not in place construction
-    && !trait::is_error_type_enum<error_type, std::decay_t<T>>::value                                                // not an enum valid for my error type
-    && ((!detail::is_implicitly_constructible<value_type, T> && detail::is_implicitly_constructible<error_type, T>)  // is unambiguously for error type
-        || (std::is_same<error_type, std::decay_t<T>>::value                                                         // OR is my error type exactly
-            && detail::is_implicitly_constructible<error_type, T>) );                                                // and my error type is constructible from this ref form of T
+    static constexpr bool implicit_constructors_enabled = result_implicit_constructors_enabled<value_type, error_type>;
+
+    // Predicate for the value converting constructor to be available.
+    template <class T> static constexpr bool enable_value_converting_constructor = result_value_converting_constructible<value_type, error_type, T>;
+
+    // Predicate for the error converting constructor to be available.
+    template <class T> static constexpr bool enable_error_converting_constructor = result_error_converting_constructible<value_type, error_type, T>;
 
     // Predicate for the error condition converting constructor to be available.
-    template <class ErrorCondEnum>
-    static constexpr bool enable_error_condition_converting_constructor =                                                                       //
-    !is_in_place_type_t<std::decay_t<ErrorCondEnum>>::value                                                                                     // not in place construction
-    && trait::is_error_type_enum<error_type, std::decay_t<ErrorCondEnum>>::value                                                                // is an error condition enum
-    /*&& !detail::is_implicitly_constructible<value_type, ErrorCondEnum> && !detail::is_implicitly_constructible<error_type, ErrorCondEnum>*/;  // not constructible via any other means
+    template <class ErrorCondEnum> static constexpr bool enable_error_condition_converting_constructor = error_condition_converting_constructible<error_type, ErrorCondEnum>;
 
     // Predicate for the converting copy constructor from a compatible input to be available.
     template <class T, class U, class V>
@@ -136,7 +161,7 @@ template <class T> using is_basic_result = detail::is_basic_result<std::decay_t<
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-template <class T> static constexpr bool is_basic_result_v = detail::is_basic_result<std::decay_t<T>>::value;
+template <class T> OUTCOME_INLINE_CONSTEXPR bool is_basic_result_v = detail::is_basic_result<std::decay_t<T>>::value;
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
@@ -146,19 +171,33 @@ namespace hooks
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U> constexpr inline void hook_result_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_result_construction(T *r, U && /*unused*/) noexcept
+  {
+    OUTCOME_SDT_FAILURE(result_failure, r);
+    OUTCOME_ERROR_PROVENANCE_ORIGIN(r);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U> constexpr inline void hook_result_copy_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_result_copy_construction(T *r, U && /*unused*/) noexcept
+  {
+    OUTCOME_ERROR_PROVENANCE_ORIGIN(r);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U> constexpr inline void hook_result_move_construction(T * /*unused*/, U && /*unused*/) noexcept {}
+  template <class T, class U> constexpr inline void hook_result_move_construction(T *r, U && /*unused*/) noexcept
+  {
+    OUTCOME_ERROR_PROVENANCE_ORIGIN(r);
+  }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class T, class U, class... Args> constexpr inline void hook_result_in_place_construction(T * /*unused*/, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept {}
+  template <class T, class U, class... Args> constexpr inline void hook_result_in_place_construction(T *r, in_place_type_t<U> /*unused*/, Args &&... /*unused*/) noexcept
+  {
+    OUTCOME_SDT_FAILURE(result_failure, r);
+    OUTCOME_ERROR_PROVENANCE_ORIGIN(r);
+  }
 
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
@@ -226,25 +265,13 @@ protected:
     static constexpr bool implicit_constructors_enabled = constructors_enabled && base::implicit_constructors_enabled;
 
     // Predicate for the value converting constructor to be available.
-    template <class T>
-    static constexpr bool enable_value_converting_constructor =  //
-    constructors_enabled                                         //
-    && !std::is_same<std::decay_t<T>, basic_result>::value       // not my type
-    && base::template enable_value_converting_constructor<T>;
+    template <class T> static constexpr bool enable_value_converting_constructor = detail::basic_result_value_converting_constructible<basic_result, value_type, error_type, T>;
 
     // Predicate for the error converting constructor to be available.
-    template <class T>
-    static constexpr bool enable_error_converting_constructor =  //
-    constructors_enabled                                         //
-    && !std::is_same<std::decay_t<T>, basic_result>::value       // not my type
-    && base::template enable_error_converting_constructor<T>;
+    template <class T> static constexpr bool enable_error_converting_constructor = detail::basic_result_error_converting_constructible<basic_result, value_type, error_type, T>;
 
     // Predicate for the error condition converting constructor to be available.
-    template <class ErrorCondEnum>
-    static constexpr bool enable_error_condition_converting_constructor =  //
-    constructors_enabled                                                   //
-    && !std::is_same<std::decay_t<ErrorCondEnum>, basic_result>::value     // not my type
-    && base::template enable_error_condition_converting_constructor<ErrorCondEnum>;
+    template <class ErrorCondEnum> static constexpr bool enable_error_condition_converting_constructor = detail::basic_result_error_condition_converting_constructible<basic_result, value_type, error_type, ErrorCondEnum>;
 
     // Predicate for the converting copy constructor from a compatible input to be available.
     template <class T, class U, class V>
@@ -317,7 +344,7 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class T)
-  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_value_converting_constructor<T>))
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::basic_result_value_converting_constructible<basic_result, value_type, error_type, T>))
   constexpr basic_result(T &&t, value_converting_constructor_tag /*unused*/ = value_converting_constructor_tag()) noexcept(std::is_nothrow_constructible<value_type, T>::value)  // NOLINT
   : base{in_place_type<typename base::value_type>, static_cast<T &&>(t)}
   {
@@ -328,7 +355,7 @@ SIGNATURE NOT RECOGNISED
 SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class T)
-  OUTCOME_TREQUIRES(OUTCOME_TPRED(predicate::template enable_error_converting_constructor<T>))
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(detail::basic_result_error_converting_constructible<basic_result, value_type, error_type, T>))
   constexpr basic_result(T &&t, error_converting_constructor_tag /*unused*/ = error_converting_constructor_tag()) noexcept(std::is_nothrow_constructible<error_type, T>::value)  // NOLINT
   : base{in_place_type<typename base::error_type>, static_cast<T &&>(t)}
   {
@@ -340,7 +367,7 @@ SIGNATURE NOT RECOGNISED
 */
   OUTCOME_TEMPLATE(class ErrorCondEnum)
   OUTCOME_TREQUIRES(OUTCOME_TEXPR(error_type(make_error_code(ErrorCondEnum()))),  //
-                    OUTCOME_TPRED(predicate::template enable_error_condition_converting_constructor<ErrorCondEnum>))
+                    OUTCOME_TPRED(detail::basic_result_error_condition_converting_constructible<basic_result, value_type, error_type, ErrorCondEnum>))
   constexpr basic_result(ErrorCondEnum &&t, error_condition_converting_constructor_tag /*unused*/ = error_condition_converting_constructor_tag()) noexcept(noexcept(error_type(make_error_code(static_cast<ErrorCondEnum &&>(t)))))  // NOLINT
   : base{in_place_type<typename base::error_type>, make_error_code(t)}
   {
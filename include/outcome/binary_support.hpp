@@ -0,0 +1,408 @@
+/* Compact binary serialisation of results and outcomes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_BINARY_SUPPORT_HPP
+#define OUTCOME_BINARY_SUPPORT_HPP
+
+#include "outcome.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+/*! The binary encoding of `T` used by `binary_encode()` and `binary_decode()`.
+
+Trivially copyable types other than pointers and `std::error_code` are encoded as their
+`sizeof(T)` bytes, little endian for arithmetic and enum types. Specialise this for any other
+type with the static member functions:
+
+- `size_t encoded_size(const T &v)`, the number of bytes `encode()` will write.
+- `bool encode(char *out, const T &v)`, writing exactly that many bytes, or returning false if `v`
+cannot be encoded.
+- `bool decode(T &v, const char *in, size_t length)`, decoding the `length` bytes previously written
+by `encode()` into `v`, or returning false if they are malformed.
+
+Such encodings are prefixed with their length, so decoders always know where they end.
+*/
+template <class T, class Enable = void> struct binary_codec
+{
+};
+
+namespace detail
+{
+  template <class T>
+  struct binary_is_raw : std::integral_constant<bool, std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value && !std::is_member_pointer<T>::value && !std::is_same<T, std::error_code>::value && !std::is_same<T, std::error_condition>::value && !std::is_same<T, void_type>::value>
+  {
+  };
+
+  template <class T> inline void binary_byteswap(T &v, std::true_type /*arithmetic*/) noexcept
+  {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    char *p = reinterpret_cast<char *>(&v);  // NOLINT
+    for(size_t n = 0; n < sizeof(T) / 2; n++)
+    {
+      const char t = p[n];
+      p[n] = p[sizeof(T) - 1 - n];
+      p[sizeof(T) - 1 - n] = t;
+    }
+#else
+    (void) v;
+#endif
+  }
+  template <class T> inline void binary_byteswap(T & /*unused*/, std::false_type /*arithmetic*/) noexcept {}
+
+  // LEB128, seven bits per byte, least significant first
+  inline size_t binary_varint_size(uint64_t v) noexcept
+  {
+    size_t ret = 1;
+    for(; v >= 0x80; v >>= 7)
+    {
+      ++ret;
+    }
+    return ret;
+  }
+  inline char *binary_put_varint(char *out, uint64_t v) noexcept
+  {
+    for(; v >= 0x80; v >>= 7)
+    {
+      *out++ = static_cast<char>((v & 0x7f) | 0x80);
+    }
+    *out++ = static_cast<char>(v);
+    return out;
+  }
+  inline const char *binary_get_varint(const char *in, const char *end, uint64_t &v) noexcept
+  {
+    v = 0;
+    for(unsigned shift = 0; in != end && shift < 64; shift += 7)
+    {
+      const auto c = static_cast<unsigned char>(*in++);
+      v |= static_cast<uint64_t>(c & 0x7f) << shift;
+      if((c & 0x80) == 0)
+      {
+        return in;
+      }
+    }
+    return nullptr;
+  }
+
+  template <class C> struct binary_is_fixed
+  {
+    template <class U> static std::true_type test(decltype(U::fixed_size) *);
+    template <class U> static std::false_type test(...);
+    static constexpr bool value = decltype(test<C>(nullptr))::value;
+  };
+
+  // Encodes a value, error or exception field, using fixed size codecs raw and length prefixing the rest
+  template <class T, bool fixed = binary_is_fixed<binary_codec<T>>::value> struct binary_field
+  {
+    using codec = binary_codec<T>;
+    static size_t size(const T & /*unused*/) noexcept { return codec::fixed_size; }
+    static char *put(char *out, const T &v) noexcept
+    {
+      codec::encode(out, v);
+      return out + codec::fixed_size;
+    }
+    static const char *get(T &v, const char *in, const char *end) noexcept
+    {
+      if(static_cast<size_t>(end - in) < codec::fixed_size)
+      {
+        return nullptr;
+      }
+      codec::decode(v, in);
+      return in + codec::fixed_size;
+    }
+  };
+  template <class T> struct binary_field<T, false>
+  {
+    using codec = binary_codec<T>;
+    static size_t size(const T &v)
+    {
+      const size_t length = codec::encoded_size(v);
+      return binary_varint_size(length) + length;
+    }
+    static char *put(char *out, const T &v)
+    {
+      const size_t length = codec::encoded_size(v);
+      out = binary_put_varint(out, length);
+      return codec::encode(out, v) ? out + length : nullptr;
+    }
+    static const char *get(T &v, const char *in, const char *end)
+    {
+      uint64_t length = 0;
+      in = binary_get_varint(in, end, length);
+      if(in == nullptr || length > static_cast<uint64_t>(end - in) || !codec::decode(v, in, static_cast<size_t>(length)))
+      {
+        return nullptr;
+      }
+      return in + length;
+    }
+  };
+  // void values, errors and exceptions occupy no bytes
+  template <> struct binary_field<void_type, false>
+  {
+    static constexpr size_t size(void_type /*unused*/) noexcept { return 0; }
+    static char *put(char *out, void_type /*unused*/) noexcept { return out; }
+    static const char *get(void_type /*unused*/, const char *in, const char * /*unused*/) noexcept { return in; }
+  };
+
+  struct binary_error_access
+  {
+    template <class Res> static auto &get(Res &v, std::false_type /*void*/) noexcept { return v.assume_error(); }
+    template <class Res> static void_type get(Res & /*unused*/, std::true_type /*void*/) noexcept { return {}; }
+  };
+  template <class Res> inline decltype(auto) binary_error(Res &v) noexcept { return binary_error_access::get(v, std::is_void<typename Res::error_type>()); }
+  struct binary_exception_access
+  {
+    template <class Res> static auto &get(Res &v, std::false_type /*void*/) noexcept { return v.assume_exception(); }
+    template <class Res> static void_type get(Res & /*unused*/, std::true_type /*void*/) noexcept { return {}; }
+  };
+  template <class Res> inline decltype(auto) binary_exception(Res &v) noexcept { return binary_exception_access::get(v, std::is_void<typename Res::exception_type>()); }
+
+  template <class T> using binary_field_for = binary_field<std::decay_t<T>>;
+
+  template <class Res> inline size_t binary_result_size(const Res &v)
+  {
+    const auto &state = v._iostreams_state();
+    size_t ret = binary_varint_size(state._status);
+    if(v.has_value())
+    {
+      ret += binary_field_for<decltype(state._value)>::size(state._value);  // NOLINT
+    }
+    if(v.has_error())
+    {
+      ret += binary_field_for<decltype(binary_error(v))>::size(binary_error(v));
+    }
+    return ret;
+  }
+  template <class Res> inline char *binary_result_put(char *out, const Res &v)
+  {
+    const auto &state = v._iostreams_state();
+    out = binary_put_varint(out, state._status);
+    if(v.has_value())
+    {
+      out = binary_field_for<decltype(state._value)>::put(out, state._value);  // NOLINT
+    }
+    if(out != nullptr && v.has_error())
+    {
+      out = binary_field_for<decltype(binary_error(v))>::put(out, binary_error(v));
+    }
+    return out;
+  }
+  // Exactly one of a value, an error or an exception, or for an outcome an error and an exception
+  constexpr inline bool binary_status_valid(uint64_t s, bool outcome) noexcept
+  {
+    const bool value = (s & status_have_value) != 0, error = (s & status_have_error) != 0, exception = (s & status_have_exception) != 0;
+    if(exception && !outcome)
+    {
+      return false;
+    }
+    return value ? (!error && !exception) : (error || exception);
+  }
+  template <class Res> inline const char *binary_result_get(Res &v, const char *in, const char *end, status_bitfield_type &status, bool outcome)
+  {
+    uint64_t s = 0;
+    in = binary_get_varint(in, end, s);
+    if(in == nullptr || s > 0xffffffffU || !binary_status_valid(s, outcome))
+    {
+      return nullptr;
+    }
+    status = static_cast<status_bitfield_type>(s);
+    // As per the iostreams support, rebuild the value storage in place
+    auto &state = v._iostreams_state();
+    using state_type = std::decay_t<decltype(state)>;
+    state = state_type();
+    state._status = status & ~status_have_value;
+    if((status & status_have_value) != 0)
+    {
+      new(&state._value) std::decay_t<decltype(state._value)>();  // NOLINT
+      state._status |= status_have_value;
+      in = binary_field_for<decltype(state._value)>::get(state._value, in, end);  // NOLINT
+    }
+    if(in != nullptr && (status & status_have_error) != 0)
+    {
+      in = binary_field_for<decltype(binary_error(v))>::get(binary_error(v), in, end);
+    }
+    return in;
+  }
+}  // namespace detail
+
+//! Raw encoding of trivially copyable types.
+template <class T> struct binary_codec<T, std::enable_if_t<detail::binary_is_raw<T>::value>>
+{
+  static constexpr size_t fixed_size = sizeof(T);
+  static void encode(char *out, T v) noexcept
+  {
+    detail::binary_byteswap(v, std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value>());
+    memcpy(out, &v, sizeof(T));
+  }
+  static void decode(T &v, const char *in) noexcept
+  {
+    memcpy(&v, in, sizeof(T));
+    detail::binary_byteswap(v, std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value>());
+  }
+};
+
+//! Narrow strings are encoded as their characters.
+template <class Traits, class Alloc> struct binary_codec<std::basic_string<char, Traits, Alloc>>
+{
+  static size_t encoded_size(const std::basic_string<char, Traits, Alloc> &v) noexcept { return v.size(); }
+  static bool encode(char *out, const std::basic_string<char, Traits, Alloc> &v) noexcept
+  {
+    memcpy(out, v.data(), v.size());
+    return true;
+  }
+  // Reuses the capacity of `v`
+  static bool decode(std::basic_string<char, Traits, Alloc> &v, const char *in, size_t length)
+  {
+    v.assign(in, length);
+    return true;
+  }
+};
+
+/*! Error codes of the generic and system categories are encoded as a byte identifying the
+category, and the value. Error codes of any other category cannot be encoded, as categories
+have no identity which survives the process.
+*/
+template <> struct binary_codec<std::error_code>
+{
+  static unsigned char category_id(const std::error_category &cat) noexcept
+  {
+    if(cat == std::generic_category())
+    {
+      return 0;
+    }
+    if(cat == std::system_category())
+    {
+      return 1;
+    }
+    return 255;
+  }
+  static size_t encoded_size(const std::error_code &v) noexcept { return 1 + detail::binary_varint_size(static_cast<uint32_t>(v.value())); }
+  static bool encode(char *out, const std::error_code &v) noexcept
+  {
+    const unsigned char id = category_id(v.category());
+    if(id == 255)
+    {
+      return false;
+    }
+    *out++ = static_cast<char>(id);
+    detail::binary_put_varint(out, static_cast<uint32_t>(v.value()));
+    return true;
+  }
+  static bool decode(std::error_code &v, const char *in, size_t length) noexcept
+  {
+    uint64_t value = 0;
+    if(length < 2 || detail::binary_get_varint(in + 1, in + length, value) != in + length || value > 0xffffffffU)
+    {
+      return false;
+    }
+    const int ec = static_cast<int>(static_cast<uint32_t>(value));
+    switch(static_cast<unsigned char>(in[0]))
+    {
+    case 0:
+      v = std::error_code(ec, std::generic_category());
+      return true;
+    case 1:
+      v = std::error_code(ec, std::system_category());
+      return true;
+    default:
+      return false;
+    }
+  }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P> inline size_t binary_encoded_size(const basic_result<R, S, P> &v) { return detail::binary_result_size(v); }
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P> inline size_t binary_encode(char *buffer, size_t length, const basic_result<R, S, P> &v)
+{
+  if(length < binary_encoded_size(v))
+  {
+    return 0;
+  }
+  char *end = detail::binary_result_put(buffer, v);
+  return (end != nullptr) ? static_cast<size_t>(end - buffer) : 0;
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P> inline size_t binary_decode(basic_result<R, S, P> &v, const char *buffer, size_t length)
+{
+  detail::status_bitfield_type status = 0;
+  const char *end = detail::binary_result_get(v, buffer, buffer + length, status, false);
+  return (end != nullptr) ? static_cast<size_t>(end - buffer) : 0;
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N> inline size_t binary_encoded_size(const basic_outcome<R, S, P, N> &v)
+{
+  size_t ret = detail::binary_result_size(v);
+  if(v.has_exception())
+  {
+    ret += detail::binary_field_for<decltype(detail::binary_exception(v))>::size(detail::binary_exception(v));
+  }
+  return ret;
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N> inline size_t binary_encode(char *buffer, size_t length, const basic_outcome<R, S, P, N> &v)
+{
+  if(length < binary_encoded_size(v))
+  {
+    return 0;
+  }
+  char *end = detail::binary_result_put(buffer, v);
+  if(end != nullptr && v.has_exception())
+  {
+    end = detail::binary_field_for<decltype(detail::binary_exception(v))>::put(end, detail::binary_exception(v));
+  }
+  return (end != nullptr) ? static_cast<size_t>(end - buffer) : 0;
+}
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class R, class S, class P, class N> inline size_t binary_decode(basic_outcome<R, S, P, N> &v, const char *buffer, size_t length)
+{
+  detail::status_bitfield_type status = 0;
+  const char *end = detail::binary_result_get(v, buffer, buffer + length, status, true);
+  if(end != nullptr && (status & detail::status_have_exception) != 0)
+  {
+    end = detail::binary_field_for<decltype(detail::binary_exception(v))>::get(detail::binary_exception(v), end, buffer + length);
+  }
+  return (end != nullptr) ? static_cast<size_t>(end - buffer) : 0;
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
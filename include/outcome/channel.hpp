@@ -0,0 +1,357 @@
+/* A bounded multi producer multi consumer channel of results
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_CHANNEL_HPP
+#define OUTCOME_CHANNEL_HPP
+
+#include "basic_result.hpp"
+#include "detail/spin_wait.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  static constexpr size_t channel_cache_line_size = 64;
+
+  /* A bounded MPMC ring after Dmitry Vyukov's design. Each cell carries a
+  sequence number which says whose turn it is: a producer at position `pos`
+  may construct into the cell when it equals `pos`, and a consumer at `pos`
+  may move out of it when it equals `pos + 1`. Cells are constructed into
+  in place and destroyed as they are consumed.
+
+  A claimed cell must always be published, so construction into a cell must
+  not throw, and every cell claimed by a consumer is destroyed and released
+  even if the consumer throws.
+  */
+  template <class T> class channel_ring
+  {
+    struct _cell
+    {
+      std::atomic<size_t> seq;
+      alignas(T) unsigned char storage[sizeof(T)];
+      T &value() noexcept { return *reinterpret_cast<T *>(storage); }  // NOLINT
+    };
+
+    // Padded rather than aligned, so rings can be heap allocated before C++ 17
+    std::atomic<size_t> _enqueue_pos{0};
+    char _pad1[channel_cache_line_size - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> _dequeue_pos{0};
+    char _pad2[channel_cache_line_size - sizeof(std::atomic<size_t>)];
+    size_t _mask;
+    std::unique_ptr<_cell[]> _cells;
+
+    static size_t _round_up(size_t capacity) noexcept
+    {
+      size_t ret = 2;
+      while(ret < capacity)
+      {
+        ret <<= 1;
+      }
+      return ret;
+    }
+
+  public:
+    explicit channel_ring(size_t capacity)
+        : _mask(_round_up(capacity) - 1)
+        , _cells(new _cell[_mask + 1])
+    {
+      for(size_t i = 0; i <= _mask; i++)
+      {
+        _cells[i].seq.store(i, std::memory_order_relaxed);
+      }
+    }
+    channel_ring(const channel_ring &) = delete;
+    channel_ring &operator=(const channel_ring &) = delete;
+    ~channel_ring()
+    {
+      // Destroy anything never consumed
+      for(size_t pos = _dequeue_pos.load(std::memory_order_relaxed), end = _enqueue_pos.load(std::memory_order_relaxed); pos != end; ++pos)
+      {
+        _cells[pos & _mask].value().~T();
+      }
+    }
+
+    size_t capacity() const noexcept { return _mask + 1; }
+    // Only approximate when racing producers or consumers
+    size_t size() const noexcept { return _enqueue_pos.load(std::memory_order_relaxed) - _dequeue_pos.load(std::memory_order_relaxed); }
+
+    template <class... Args> bool try_emplace(Args &&... args)
+    {
+      static_assert(std::is_nothrow_constructible<T, Args &&...>::value, "construction into a claimed cell must not throw");
+      size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+      for(;;)
+      {
+        _cell &cell = _cells[pos & _mask];
+        const size_t seq = cell.seq.load(std::memory_order_acquire);
+        const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if(diff == 0)
+        {
+          if(_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          {
+            new(cell.storage) T(static_cast<Args &&>(args)...);  // NOLINT
+            cell.seq.store(pos + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if(diff < 0)
+        {
+          return false;  // full
+        }
+        else
+        {
+          pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    // Claims up to `max` consecutive ready cells, and calls `f` with each moved out in order
+    template <class F> size_t try_consume_n(F &&f, size_t max)
+    {
+      size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+      for(;;)
+      {
+        size_t n = 0;
+        for(; n < max && n <= _mask; n++)
+        {
+          const size_t seq = _cells[(pos + n) & _mask].seq.load(std::memory_order_acquire);
+          if(static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + n + 1) != 0)
+          {
+            break;
+          }
+        }
+        if(n == 0)
+        {
+          const size_t seq = _cells[pos & _mask].seq.load(std::memory_order_acquire);
+          if(static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0)
+          {
+            return 0;  // empty
+          }
+          pos = _dequeue_pos.load(std::memory_order_relaxed);
+          continue;
+        }
+        if(_dequeue_pos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed))
+        {
+          // If f throws, the cells not yet consumed are still destroyed and released, losing their elements
+          struct release_claimed
+          {
+            channel_ring *self;
+            size_t pos, done, n;
+            void release_one() noexcept
+            {
+              _cell &cell = self->_cells[(pos + done) & self->_mask];
+              cell.value().~T();
+              cell.seq.store(pos + done + self->_mask + 1, std::memory_order_release);
+              ++done;
+            }
+            ~release_claimed()
+            {
+              while(done < n)
+              {
+                release_one();
+              }
+            }
+          } claimed{this, pos, 0, n};
+          while(claimed.done < n)
+          {
+            f(static_cast<T &&>(_cells[(pos + claimed.done) & _mask].value()));
+            claimed.release_one();
+          }
+          return n;
+        }
+      }
+    }
+  };
+
+  template <class T> inline void channel_tap(channel_ring<T> &tap, T &&v, std::atomic<size_t> &dropped)
+  {
+    if(!tap.try_emplace(static_cast<T &&>(v)))
+    {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  // Pushes v, waiting for space if asked to. Only reached untapped, as a tap requires copyable T.
+  template <class T> inline bool channel_push_tapped(channel_ring<T> &ring, channel_ring<T> & /*unused*/, T &&v, std::atomic<size_t> & /*unused*/, bool wait, std::false_type /*copyable*/)
+  {
+    // try_emplace() only moves from v if it succeeds
+    while(!ring.try_emplace(static_cast<T &&>(v)))
+    {
+      if(!wait)
+      {
+        return false;
+      }
+      spin_pause();
+      std::this_thread::yield();
+    }
+    return true;
+  }
+  // As above, but copying v into the tap if it is a failure and was pushed
+  template <class T> inline bool channel_push_tapped(channel_ring<T> &ring, channel_ring<T> &tap, T &&v, std::atomic<size_t> &dropped, bool wait, std::true_type /*copyable*/)
+  {
+    if(!v.has_failure())
+    {
+      return channel_push_tapped(ring, tap, static_cast<T &&>(v), dropped, wait, std::false_type());
+    }
+    T copy(v);
+    if(!channel_push_tapped(ring, tap, static_cast<T &&>(v), dropped, wait, std::false_type()))
+    {
+      return false;
+    }
+    channel_tap(tap, static_cast<T &&>(copy), dropped);
+    return true;
+  }
+}  // namespace detail
+
+/*! A bounded, lock free, multi producer multi consumer channel of `T`, which is a `basic_result`
+or `basic_outcome`. Elements are constructed in place in the channel's storage by `try_emplace()`,
+and moved out by `try_pop()` or, in batches claimed by a single atomic operation, by `try_pop_n()`.
+
+Elements are constructed directly into the channel's storage only if that cannot throw. Otherwise they
+are first constructed outside the channel, and then moved in, which requires `T` to be nothrow move
+constructible; then the arguments are consumed even if the channel turns out to be full.
+
+If constructed with an `error_capacity`, which requires `T` to be copy constructible, then
+a copy of every failure pushed into the channel is also pushed into a separate, lossy, error tap.
+Monitoring threads may drain the tap with `try_pop_error()` and `try_pop_errors()` without ever
+seeing, or competing with the consumers for, successes. Failures which do not fit into the tap are
+dropped and counted by `dropped_errors()`, so a slow monitor never holds up the channel.
+*/
+template <class T> class result_channel
+{
+  detail::channel_ring<T> _ring;
+  std::unique_ptr<detail::channel_ring<T>> _errors;
+  std::atomic<size_t> _dropped_errors{0};
+
+  template <class OutputIt> struct _assign_to
+  {
+    OutputIt &out;
+    void operator()(T &&v) { *out++ = static_cast<T &&>(v); }
+  };
+
+  template <class... Args> bool _try_emplace(std::true_type /*nothrow*/, Args &&... args) { return _ring.try_emplace(static_cast<Args &&>(args)...); }
+  template <class... Args> bool _try_emplace(std::false_type /*nothrow*/, Args &&... args) { return _ring.try_emplace(T(static_cast<Args &&>(args)...)); }
+  template <class... Args> void _emplace(std::true_type /*nothrow*/, Args &&... args)
+  {
+    // try_emplace() only consumes args if it succeeds
+    while(!_ring.try_emplace(static_cast<Args &&>(args)...))
+    {
+      detail::spin_pause();
+      std::this_thread::yield();
+    }
+  }
+  template <class... Args> void _emplace(std::false_type /*nothrow*/, Args &&... args)
+  {
+    T v(static_cast<Args &&>(args)...);
+    _emplace(std::true_type(), static_cast<T &&>(v));
+  }
+
+public:
+  using value_type = T;
+
+  /*! Constructs a channel able to hold at least `capacity` elements, and an error tap able to hold
+  at least `error_capacity` failures if that is not zero. Capacities are rounded up to a power of two.
+  */
+  explicit result_channel(size_t capacity)
+      : _ring(capacity)
+  {
+  }
+  //! \overload
+  OUTCOME_TEMPLATE(class U = T)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_copy_constructible<U>::value))
+  result_channel(size_t capacity, size_t error_capacity)
+      : _ring(capacity)
+  {
+    if(error_capacity > 0)
+    {
+      _errors.reset(new detail::channel_ring<T>(error_capacity));
+    }
+  }
+
+  //! The maximum number of elements the channel can hold.
+  size_t capacity() const noexcept { return _ring.capacity(); }
+  //! The number of elements in the channel, which is approximate if producers or consumers are active.
+  size_t size() const noexcept { return _ring.size(); }
+
+  //! Constructs an element in place from `args` if the channel is not full, returning false if it is.
+  template <class... Args> bool try_emplace(Args &&... args)
+  {
+    if(!_errors)
+    {
+      return _try_emplace(std::is_nothrow_constructible<T, Args &&...>(), static_cast<Args &&>(args)...);
+    }
+    // Elements must be inspected before they become visible to consumers, so cannot be constructed in place
+    return detail::channel_push_tapped(_ring, *_errors, T(static_cast<Args &&>(args)...), _dropped_errors, false, std::is_copy_constructible<T>());
+  }
+  //! Moves `v` into the channel if the channel is not full, returning false if it is.
+  bool try_push(T &&v) { return try_emplace(static_cast<T &&>(v)); }
+  //! Copies `v` into the channel if the channel is not full, returning false if it is.
+  bool try_push(const T &v) { return try_emplace(v); }
+  //! Constructs an element in place from `args`, waiting for space if the channel is full.
+  template <class... Args> void emplace(Args &&... args)
+  {
+    if(_errors)
+    {
+      detail::channel_push_tapped(_ring, *_errors, T(static_cast<Args &&>(args)...), _dropped_errors, true, std::is_copy_constructible<T>());
+      return;
+    }
+    _emplace(std::is_nothrow_constructible<T, Args &&...>(), static_cast<Args &&>(args)...);
+  }
+
+  //! Move assigns the oldest element into `out`, returning false if the channel is empty.
+  bool try_pop(T &out)
+  {
+    T *o = &out;
+    return _ring.try_consume_n(_assign_to<T *>{o}, 1) == 1;
+  }
+  /*! Move assigns up to `max` of the oldest elements through the output iterator `out`, which
+  are claimed from the channel in a single atomic operation.
+  \returns The number of elements popped.
+  */
+  template <class OutputIt> size_t try_pop_n(OutputIt out, size_t max) { return _ring.try_consume_n(_assign_to<OutputIt>{out}, max); }
+  /*! Calls `f` with each of up to `max` of the oldest elements, as an rvalue, which are claimed
+  from the channel in a single atomic operation.
+  \returns The number of elements consumed.
+  */
+  template <class F> size_t try_consume_n(F &&f, size_t max) { return _ring.try_consume_n(f, max); }
+
+  //! True if this channel has an error tap.
+  bool has_error_tap() const noexcept { return _errors != nullptr; }
+  //! Move assigns the oldest failure in the error tap into `out`, returning false if there is none.
+  bool try_pop_error(T &out)
+  {
+    T *o = &out;
+    return _errors && _errors->try_consume_n(_assign_to<T *>{o}, 1) == 1;
+  }
+  //! Move assigns up to `max` of the oldest failures in the error tap through the output iterator `out`.
+  template <class OutputIt> size_t try_pop_errors(OutputIt out, size_t max) { return _errors ? _errors->try_consume_n(_assign_to<OutputIt>{out}, max) : 0; }
+  //! The number of failures which were not copied into the error tap, because it was full.
+  size_t dropped_errors() const noexcept { return _dropped_errors.load(std::memory_order_relaxed); }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -69,6 +69,85 @@ SIGNATURE NOT RECOGNISED
 #ifndef OUTCOME_THREAD_LOCAL
 #define OUTCOME_THREAD_LOCAL QUICKCPPLIB_THREAD_LOCAL
 #endif
+/* Marks the functions which throw on behalf of the wide observers. They are never inlined, and
+calls to them are laid out away from the hot path, so `.value()` inlines to a test and a branch.
+*/
+#ifndef OUTCOME_COLD_NOINLINE
+#if defined(__GNUC__) || defined(__clang__)
+#define OUTCOME_COLD_NOINLINE __attribute__((noinline, cold))
+#else
+#define OUTCOME_COLD_NOINLINE QUICKCPPLIB_NOINLINE
+#endif
+#endif
+/* Whether `policy::all_narrow_logged` checks and records incorrect observations, or is
+`policy::all_narrow`. Defaults to not, as recording forces the observers of every policy
+inline. Debug builds, or a canary build of release code, can define it to 1.
+*/
+#ifndef OUTCOME_LOG_NARROW_VIOLATIONS
+#define OUTCOME_LOG_NARROW_VIOLATIONS 0
+#endif
+/* Marks the observers, and the checks of `policy::all_narrow_logged`, when it records incorrect
+observations. They are then inlined even without optimisation, so the return address recorded is
+into the code which observed, not into an outlined observer shared by every call site.
+*/
+#ifndef OUTCOME_NARROW_VIOLATION_FORCEINLINE
+#if OUTCOME_LOG_NARROW_VIOLATIONS && (defined(__GNUC__) || defined(__clang__))
+#define OUTCOME_NARROW_VIOLATION_FORCEINLINE __attribute__((always_inline))
+#elif OUTCOME_LOG_NARROW_VIOLATIONS && defined(_MSC_VER)
+#define OUTCOME_NARROW_VIOLATION_FORCEINLINE __forceinline
+#else
+#define OUTCOME_NARROW_VIOLATION_FORCEINLINE
+#endif
+#endif
+/* True if the enclosing constexpr function is being constant evaluated, so that instrumentation
+which cannot be, such as inline assembly, can be skipped. Where the compiler cannot tell, it is
+false, and results constructed with instrumentation enabled cannot be constant evaluated.
+*/
+#ifndef OUTCOME_IS_CONSTANT_EVALUATED
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9
+#define OUTCOME_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define OUTCOME_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#endif
+#ifndef OUTCOME_IS_CONSTANT_EVALUATED
+#define OUTCOME_IS_CONSTANT_EVALUATED() false
+#endif
+// Use native C++ 20 Concepts for constraints, whatever quickcpplib chose, but never the Concepts TS
+#ifndef OUTCOME_USE_CXX_CONCEPTS
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L && !defined(DOXYGEN_IS_IN_THE_HOUSE)
+#define OUTCOME_USE_CXX_CONCEPTS 1
+#else
+#define OUTCOME_USE_CXX_CONCEPTS 0
+#endif
+#endif
+#if OUTCOME_USE_CXX_CONCEPTS
+#define OUTCOME_TREQUIRES_EXPAND8(a, b, c, d, e, f, g, h) a &&OUTCOME_TREQUIRES_EXPAND7(b, c, d, e, f, g, h)
+#define OUTCOME_TREQUIRES_EXPAND7(a, b, c, d, e, f, g) a &&OUTCOME_TREQUIRES_EXPAND6(b, c, d, e, f, g)
+#define OUTCOME_TREQUIRES_EXPAND6(a, b, c, d, e, f) a &&OUTCOME_TREQUIRES_EXPAND5(b, c, d, e, f)
+#define OUTCOME_TREQUIRES_EXPAND5(a, b, c, d, e) a &&OUTCOME_TREQUIRES_EXPAND4(b, c, d, e)
+#define OUTCOME_TREQUIRES_EXPAND4(a, b, c, d) a &&OUTCOME_TREQUIRES_EXPAND3(b, c, d)
+#define OUTCOME_TREQUIRES_EXPAND3(a, b, c) a &&OUTCOME_TREQUIRES_EXPAND2(b, c)
+#define OUTCOME_TREQUIRES_EXPAND2(a, b) a &&OUTCOME_TREQUIRES_EXPAND1(b)
+#define OUTCOME_TREQUIRES_EXPAND1(a) a
+#ifndef OUTCOME_TEMPLATE
+#define OUTCOME_TEMPLATE(...) template <__VA_ARGS__>
+#endif
+#ifndef OUTCOME_TREQUIRES
+#define OUTCOME_TREQUIRES(...) requires QUICKCPPLIB_CALL_OVERLOAD(OUTCOME_TREQUIRES_EXPAND, __VA_ARGS__)
+#endif
+#ifndef OUTCOME_TEXPR
+#define OUTCOME_TEXPR(...) requires { (__VA_ARGS__); }
+#endif
+#ifndef OUTCOME_TPRED
+#define OUTCOME_TPRED(...) (__VA_ARGS__)
+#endif
+#ifndef OUTCOME_REQUIRES
+#define OUTCOME_REQUIRES(...) requires __VA_ARGS__
+#endif
+#endif
 #ifndef OUTCOME_TEMPLATE
 #define OUTCOME_TEMPLATE(...) QUICKCPPLIB_TEMPLATE(__VA_ARGS__)
 #endif
@@ -84,33 +163,31 @@ SIGNATURE NOT RECOGNISED
 #ifndef OUTCOME_REQUIRES
 #define OUTCOME_REQUIRES(...) QUICKCPPLIB_REQUIRES(__VA_ARGS__)
 #endif
-
-#include "quickcpplib/import.h"
-
-
-#if defined(OUTCOME_UNSTABLE_VERSION)
-#include "detail/revision.hpp"
-#define OUTCOME_V2 (QUICKCPPLIB_BIND_NAMESPACE_VERSION(outcome_v2, OUTCOME_PREVIOUS_COMMIT_UNIQUE))
+// Namespace scope constants need external linkage to be usable from a C++ Module
+#ifndef OUTCOME_INLINE_CONSTEXPR
+#ifdef __cpp_inline_variables
+#define OUTCOME_INLINE_CONSTEXPR inline constexpr
 #else
-#define OUTCOME_V2 (QUICKCPPLIB_BIND_NAMESPACE_VERSION(outcome_v2))
+#define OUTCOME_INLINE_CONSTEXPR static constexpr
+#endif
 #endif
 
-#if defined(GENERATING_OUTCOME_MODULE_INTERFACE)
-#define OUTCOME_V2_NAMESPACE QUICKCPPLIB_BIND_NAMESPACE(OUTCOME_V2)
-#define OUTCOME_V2_NAMESPACE_BEGIN QUICKCPPLIB_BIND_NAMESPACE_BEGIN(OUTCOME_V2)
-#define OUTCOME_V2_NAMESPACE_EXPORT_BEGIN QUICKCPPLIB_BIND_NAMESPACE_EXPORT_BEGIN(OUTCOME_V2)
-#define OUTCOME_V2_NAMESPACE_END QUICKCPPLIB_BIND_NAMESPACE_END(OUTCOME_V2)
-#else
-#define OUTCOME_V2_NAMESPACE QUICKCPPLIB_BIND_NAMESPACE(OUTCOME_V2)
-#define OUTCOME_V2_NAMESPACE_BEGIN QUICKCPPLIB_BIND_NAMESPACE_BEGIN(OUTCOME_V2)
-#define OUTCOME_V2_NAMESPACE_EXPORT_BEGIN QUICKCPPLIB_BIND_NAMESPACE_BEGIN(OUTCOME_V2)
-#define OUTCOME_V2_NAMESPACE_END QUICKCPPLIB_BIND_NAMESPACE_END(OUTCOME_V2)
+#include "detail/namespace.hpp"
+
+/* If true, the headers <outcome/minimal_result.hpp> includes avoid every standard header beyond
+<cstdint>, <initializer_list>, <new>, <type_traits> and <utility>. Defined to true by that header
+if it is included first.
+*/
+#ifndef OUTCOME_MINIMAL_INCLUDES
+#define OUTCOME_MINIMAL_INCLUDES 0
 #endif
 
 #include <cstdint>  // for uint32_t etc
 #include <initializer_list>
+#if !OUTCOME_MINIMAL_INCLUDES
 #include <iosfwd>  // for future serialisation
-#include <new>     // for placement in moves etc
+#endif
+#include <new>  // for placement in moves etc
 #include <type_traits>
 
 #ifndef OUTCOME_USE_STD_IN_PLACE_TYPE
@@ -205,9 +282,22 @@ namespace detail
   // static_assert(std::is_same_v<rebind_type<int, volatile const double &&>, volatile const int &&>, "");
 
 
+  // Declares a predicate of the constructors, which is a concept under native C++ 20 Concepts
+#if OUTCOME_USE_CXX_CONCEPTS
+#define OUTCOME_PREDICATE concept
+#else
+#define OUTCOME_PREDICATE OUTCOME_INLINE_CONSTEXPR bool
+#endif
+
   /* True if type is the same or constructible. Works around a bug where clang + libstdc++
   pukes on std::is_constructible<filesystem::path, void> (this bug is fixed upstream).
   */
+#if OUTCOME_USE_CXX_CONCEPTS
+  // As concepts these need no class template instantiated, the compiler caches their satisfaction,
+  // and the conjunctions of constraints using them short circuit.
+  template <class T, class U> concept is_explicitly_constructible = !std::is_void<U>::value && std::is_constructible<T, U>::value;
+  template <class T, class U> concept is_implicitly_constructible = !std::is_void<U>::value && std::is_convertible<U, T>::value;
+#else
   template <class T, class U> struct _is_explicitly_constructible
   {
     static constexpr bool value = std::is_constructible<T, U>::value;
@@ -220,7 +310,7 @@ namespace detail
   {
     static constexpr bool value = false;
   };
-  template <class T, class U> static constexpr bool is_explicitly_constructible = _is_explicitly_constructible<T, U>::value;
+  template <class T, class U> OUTCOME_INLINE_CONSTEXPR bool is_explicitly_constructible = _is_explicitly_constructible<T, U>::value;
 
   template <class T, class U> struct _is_implicitly_constructible
   {
@@ -234,7 +324,8 @@ namespace detail
   {
     static constexpr bool value = false;
   };
-  template <class T, class U> static constexpr bool is_implicitly_constructible = _is_implicitly_constructible<T, U>::value;
+  template <class T, class U> OUTCOME_INLINE_CONSTEXPR bool is_implicitly_constructible = _is_implicitly_constructible<T, U>::value;
+#endif
 
 #ifndef OUTCOME_USE_STD_IS_NOTHROW_SWAPPABLE
 #if defined(_MSC_VER) && _HAS_CXX17
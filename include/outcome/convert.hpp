@@ -42,10 +42,8 @@ namespace convert
   */
   template <class U> concept OUTCOME_GCC6_CONCEPT_BOOL ValueOrNone = requires(U a)
   {
-    {
-      a.has_value()
-    }
-    ->bool;
+    {a.has_value()};
+    requires std::is_convertible<decltype(a.has_value()), bool>::value;  // Concepts TS `->bool` is not C++ 20
     {a.value()};
   };
   /* The `ValueOrError` concept.
@@ -54,10 +52,8 @@ namespace convert
   */
   template <class U> concept OUTCOME_GCC6_CONCEPT_BOOL ValueOrError = requires(U a)
   {
-    {
-      a.has_value()
-    }
-    ->bool;
+    {a.has_value()};
+    requires std::is_convertible<decltype(a.has_value()), bool>::value;  // Concepts TS `->bool` is not C++ 20
     {a.value()};
     {a.error()};
   };
@@ -76,18 +72,18 @@ namespace convert
     OUTCOME_TREQUIRES(OUTCOME_TEXPR(std::declval<U>().has_value()), OUTCOME_TEXPR(std::declval<U>().value()), OUTCOME_TEXPR(std::declval<U>().error()))
     inline U match_value_or_error(U &&);
 
-    template <class U> static constexpr bool ValueOrNone = !std::is_same<no_match, decltype(match_value_or_none(std::declval<OUTCOME_V2_NAMESPACE::detail::devoid<U>>()))>::value;
-    template <class U> static constexpr bool ValueOrError = !std::is_same<no_match, decltype(match_value_or_error(std::declval<OUTCOME_V2_NAMESPACE::detail::devoid<U>>()))>::value;
+    template <class U> OUTCOME_INLINE_CONSTEXPR bool ValueOrNone = !std::is_same<no_match, decltype(match_value_or_none(std::declval<OUTCOME_V2_NAMESPACE::detail::devoid<U>>()))>::value;
+    template <class U> OUTCOME_INLINE_CONSTEXPR bool ValueOrError = !std::is_same<no_match, decltype(match_value_or_error(std::declval<OUTCOME_V2_NAMESPACE::detail::devoid<U>>()))>::value;
   }  // namespace detail
   /* The `ValueOrNone` concept.
   \requires That `U::value_type` exists and that `std::declval<U>().has_value()` returns a `bool` and `std::declval<U>().value()` exists.
   */
-  template <class U> static constexpr bool ValueOrNone = detail::ValueOrNone<U>;
+  template <class U> OUTCOME_INLINE_CONSTEXPR bool ValueOrNone = detail::ValueOrNone<U>;
   /* The `ValueOrError` concept.
   \requires That `U::value_type` and `U::error_type` exist;
   that `std::declval<U>().has_value()` returns a `bool`, `std::declval<U>().value()` and  `std::declval<U>().error()` exists.
   */
-  template <class U> static constexpr bool ValueOrError = detail::ValueOrError<U>;
+  template <class U> OUTCOME_INLINE_CONSTEXPR bool ValueOrError = detail::ValueOrError<U>;
 #endif
 
   namespace detail
@@ -37,15 +37,15 @@ namespace detail
     using exception_type = P;
     using Base::Base;
 
-    constexpr inline exception_type &assume_exception() & noexcept;
-    constexpr inline const exception_type &assume_exception() const &noexcept;
-    constexpr inline exception_type &&assume_exception() && noexcept;
-    constexpr inline const exception_type &&assume_exception() const &&noexcept;
-
-    constexpr inline exception_type &exception() &;
-    constexpr inline const exception_type &exception() const &;
-    constexpr inline exception_type &&exception() &&;
-    constexpr inline const exception_type &&exception() const &&;
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr inline exception_type &assume_exception() & noexcept;
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr inline const exception_type &assume_exception() const &noexcept;
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr inline exception_type &&assume_exception() && noexcept;
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr inline const exception_type &&assume_exception() const &&noexcept;
+
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr inline exception_type &exception() &;
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr inline const exception_type &exception() const &;
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr inline exception_type &&exception() &&;
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr inline const exception_type &&exception() const &&;
   };
 
   // Exception observers not present
@@ -53,8 +53,8 @@ namespace detail
   {
   public:
     using Base::Base;
-    constexpr void assume_exception() const noexcept { NoValuePolicy::narrow_exception_check(this); }
-    constexpr void exception() const { NoValuePolicy::wide_exception_check(this); }
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr void assume_exception() const noexcept { NoValuePolicy::narrow_exception_check(this); }
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr void exception() const { NoValuePolicy::wide_exception_check(this); }
   };
 
 }  // namespace detail
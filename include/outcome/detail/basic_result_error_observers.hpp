@@ -37,43 +37,43 @@ namespace detail
     using error_type = EC;
     using Base::Base;
 
-    constexpr error_type &assume_error() & noexcept
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr error_type &assume_error() & noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<basic_result_error_observers &>(*this));
       return this->_error;
     }
-    constexpr const error_type &assume_error() const &noexcept
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr const error_type &assume_error() const &noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<const basic_result_error_observers &>(*this));
       return this->_error;
     }
-    constexpr error_type &&assume_error() && noexcept
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr error_type &&assume_error() && noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<basic_result_error_observers &&>(*this));
       return static_cast<error_type &&>(this->_error);
     }
-    constexpr const error_type &&assume_error() const &&noexcept
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr const error_type &&assume_error() const &&noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<const basic_result_error_observers &&>(*this));
       return static_cast<const error_type &&>(this->_error);
     }
 
-    constexpr error_type &error() &
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr error_type &error() &
     {
       NoValuePolicy::wide_error_check(static_cast<basic_result_error_observers &>(*this));
       return this->_error;
     }
-    constexpr const error_type &error() const &
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr const error_type &error() const &
     {
       NoValuePolicy::wide_error_check(static_cast<const basic_result_error_observers &>(*this));
       return this->_error;
     }
-    constexpr error_type &&error() &&
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr error_type &&error() &&
     {
       NoValuePolicy::wide_error_check(static_cast<basic_result_error_observers &&>(*this));
       return static_cast<error_type &&>(this->_error);
     }
-    constexpr const error_type &&error() const &&
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr const error_type &&error() const &&
     {
       NoValuePolicy::wide_error_check(static_cast<const basic_result_error_observers &&>(*this));
       return static_cast<const error_type &&>(this->_error);
@@ -83,8 +83,8 @@ namespace detail
   {
   public:
     using Base::Base;
-    constexpr void assume_error() const noexcept { NoValuePolicy::narrow_error_check(*this); }
-    constexpr void error() const { NoValuePolicy::wide_error_check(*this); }
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr void assume_error() const noexcept { NoValuePolicy::narrow_error_check(*this); }
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr void error() const { NoValuePolicy::wide_error_check(*this); }
   };
 }  // namespace detail
 OUTCOME_V2_NAMESPACE_END
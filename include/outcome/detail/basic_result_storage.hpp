@@ -29,6 +29,11 @@ Distributed under the Boost Software License, Version 1.0.
 #include "../trait.hpp"
 #include "value_storage.hpp"
 
+// The builtin needs no declaration, so <cstring> can be avoided on GCC and clang
+#if !defined(__GNUC__) && !defined(__clang__)
+#include <cstring>  // for memcpy
+#endif
+
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace detail
@@ -161,6 +166,25 @@ namespace detail
     }
   };
 
+  // True if T is trivially relocatable but not trivially copyable, so swapping its bytes is faster than swapping it
+  template <class T> using use_relocating_swap = std::integral_constant<bool, !std::is_trivially_copyable<T>::value && trait::is_trivially_relocatable<T>::value>;
+  // Swaps the bytes of two objects of a trivially relocatable type
+  template <class T> inline void relocating_swap(T &a, T &b) noexcept
+  {
+    auto *pa = reinterpret_cast<unsigned char *>(&reinterpret_cast<unsigned char &>(a));  // NOLINT
+    auto *pb = reinterpret_cast<unsigned char *>(&reinterpret_cast<unsigned char &>(b));  // NOLINT
+    alignas(T) unsigned char temp[sizeof(T)];
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_memcpy(temp, pa, sizeof(T));
+    __builtin_memcpy(pa, pb, sizeof(T));
+    __builtin_memcpy(pb, temp, sizeof(T));
+#else
+    memcpy(temp, pa, sizeof(T));
+    memcpy(pa, pb, sizeof(T));
+    memcpy(pb, temp, sizeof(T));
+#endif
+  }
+
 // Neither value nor error type can throw during swap
 #ifdef __cpp_exceptions
   template <> struct basic_result_storage_swap<false, false>
@@ -169,11 +193,21 @@ namespace detail
 #endif
   {
     template <class R, class EC, class NoValuePolicy> constexpr basic_result_storage_swap(basic_result_storage<R, EC, NoValuePolicy> &a, basic_result_storage<R, EC, NoValuePolicy> &b)
+    {
+      using state_type = std::decay_t<decltype(a._msvc_nonpermissive_state())>;
+      using error_type = std::decay_t<decltype(a._msvc_nonpermissive_error())>;
+      _swap_state(a._msvc_nonpermissive_state(), b._msvc_nonpermissive_state(), use_relocating_swap<typename state_type::value_type>());
+      _swap_error(a._msvc_nonpermissive_error(), b._msvc_nonpermissive_error(), use_relocating_swap<error_type>());
+    }
+    template <class T> static constexpr void _swap_state(T &a, T &b, std::false_type /*unused*/) { a.swap(b); }
+    template <class T> static constexpr void _swap_error(T &a, T &b, std::false_type /*unused*/)
     {
       using std::swap;
-      a._msvc_nonpermissive_state().swap(b._msvc_nonpermissive_state());
-      swap(a._msvc_nonpermissive_error(), b._msvc_nonpermissive_error());
+      swap(a, b);
     }
+    // Status, union of value and empty, and error are trivially relocatable, so swap their bytes
+    template <class T> static void _swap_state(T &a, T &b, std::true_type /*unused*/) noexcept { relocating_swap(a, b); }
+    template <class T> static void _swap_error(T &a, T &b, std::true_type /*unused*/) noexcept { relocating_swap(a, b); }
   };
 #ifdef __cpp_exceptions
   // Swap potentially throwing value first
@@ -37,43 +37,43 @@ namespace detail
     using value_type = R;
     using Base::Base;
 
-    constexpr value_type &assume_value() & noexcept
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr value_type &assume_value() & noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<basic_result_value_observers &>(*this));
       return this->_state._value;  // NOLINT
     }
-    constexpr const value_type &assume_value() const &noexcept
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr const value_type &assume_value() const &noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<const basic_result_value_observers &>(*this));
       return this->_state._value;  // NOLINT
     }
-    constexpr value_type &&assume_value() && noexcept
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr value_type &&assume_value() && noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<basic_result_value_observers &&>(*this));
       return static_cast<value_type &&>(this->_state._value);  // NOLINT
     }
-    constexpr const value_type &&assume_value() const &&noexcept
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr const value_type &&assume_value() const &&noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<const basic_result_value_observers &&>(*this));
       return static_cast<const value_type &&>(this->_state._value);  // NOLINT
     }
 
-    constexpr value_type &value() &
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr value_type &value() &
     {
       NoValuePolicy::wide_value_check(static_cast<basic_result_value_observers &>(*this));
       return this->_state._value;  // NOLINT
     }
-    constexpr const value_type &value() const &
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr const value_type &value() const &
     {
       NoValuePolicy::wide_value_check(static_cast<const basic_result_value_observers &>(*this));
       return this->_state._value;  // NOLINT
     }
-    constexpr value_type &&value() &&
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr value_type &&value() &&
     {
       NoValuePolicy::wide_value_check(static_cast<basic_result_value_observers &&>(*this));
       return static_cast<value_type &&>(this->_state._value);  // NOLINT
     }
-    constexpr const value_type &&value() const &&
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr const value_type &&value() const &&
     {
       NoValuePolicy::wide_value_check(static_cast<const basic_result_value_observers &&>(*this));
       return static_cast<const value_type &&>(this->_state._value);  // NOLINT
@@ -84,8 +84,8 @@ namespace detail
   public:
     using Base::Base;
 
-    constexpr void assume_value() const noexcept { NoValuePolicy::narrow_value_check(*this); }
-    constexpr void value() const { NoValuePolicy::wide_value_check(*this); }
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr void assume_value() const noexcept { NoValuePolicy::narrow_value_check(*this); }
+    OUTCOME_NARROW_VIOLATION_FORCEINLINE constexpr void value() const { NoValuePolicy::wide_value_check(*this); }
   };
 }  // namespace detail
 
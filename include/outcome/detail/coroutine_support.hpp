@@ -0,0 +1,56 @@
+/* Detects and selects which coroutine support to use
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_DETAIL_COROUTINE_SUPPORT_HPP
+#define OUTCOME_DETAIL_COROUTINE_SUPPORT_HPP
+
+#include "../config.hpp"
+
+#ifndef OUTCOME_HAVE_COROUTINES
+#if defined(__has_include)
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define OUTCOME_HAVE_COROUTINES 1
+#define OUTCOME_COROUTINE_NAMESPACE std
+#elif defined(__cpp_coroutines) && __has_include(<experimental/coroutine>)
+#include <experimental/coroutine>
+#define OUTCOME_HAVE_COROUTINES 1
+#define OUTCOME_COROUTINE_NAMESPACE std::experimental
+#endif
+#endif
+#ifndef OUTCOME_HAVE_COROUTINES
+#define OUTCOME_HAVE_COROUTINES 0
+#endif
+#endif
+
+#if OUTCOME_HAVE_COROUTINES
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace detail
+{
+  template <class Promise = void> using coroutine_handle = OUTCOME_COROUTINE_NAMESPACE::coroutine_handle<Promise>;
+}  // namespace detail
+OUTCOME_V2_NAMESPACE_END
+#endif
+
+#endif
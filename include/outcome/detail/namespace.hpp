@@ -0,0 +1,70 @@
+/* Declares the macros naming Outcome's namespace
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_DETAIL_NAMESPACE_HPP
+#define OUTCOME_DETAIL_NAMESPACE_HPP
+
+/* Only macros are defined here, so this header can be included textually by translation units
+which import Outcome as a C++ Module, such as through try_macros.hpp.
+*/
+
+#include "version.hpp"
+
+#include "quickcpplib/config.hpp"
+#include "quickcpplib/import.h"
+
+
+/* The headers define some inline functions differently if OUTCOME_MINIMAL_INCLUDES is true,
+such as by <outcome/minimal_result.hpp> being included first, so they are then in a namespace
+of their own. Results and outcomes cannot be passed between translation units which differ in
+this, as they are different types.
+*/
+#if defined(OUTCOME_MINIMAL_INCLUDES) && OUTCOME_MINIMAL_INCLUDES
+#if defined(OUTCOME_UNSTABLE_VERSION)
+#include "revision.hpp"
+#define OUTCOME_V2 (QUICKCPPLIB_BIND_NAMESPACE_VERSION(outcome_v2, OUTCOME_PREVIOUS_COMMIT_UNIQUE, minimal))
+#else
+#define OUTCOME_V2 (QUICKCPPLIB_BIND_NAMESPACE_VERSION(outcome_v2, minimal))
+#endif
+#elif defined(OUTCOME_UNSTABLE_VERSION)
+#include "revision.hpp"
+#define OUTCOME_V2 (QUICKCPPLIB_BIND_NAMESPACE_VERSION(outcome_v2, OUTCOME_PREVIOUS_COMMIT_UNIQUE))
+#else
+#define OUTCOME_V2 (QUICKCPPLIB_BIND_NAMESPACE_VERSION(outcome_v2))
+#endif
+
+#if defined(GENERATING_OUTCOME_MODULE_INTERFACE)
+#define OUTCOME_V2_NAMESPACE QUICKCPPLIB_BIND_NAMESPACE(OUTCOME_V2)
+#define OUTCOME_V2_NAMESPACE_BEGIN QUICKCPPLIB_BIND_NAMESPACE_BEGIN(OUTCOME_V2)
+#define OUTCOME_V2_NAMESPACE_EXPORT_BEGIN QUICKCPPLIB_BIND_NAMESPACE_EXPORT_BEGIN(OUTCOME_V2)
+#define OUTCOME_V2_NAMESPACE_END QUICKCPPLIB_BIND_NAMESPACE_END(OUTCOME_V2)
+#else
+#define OUTCOME_V2_NAMESPACE QUICKCPPLIB_BIND_NAMESPACE(OUTCOME_V2)
+#define OUTCOME_V2_NAMESPACE_BEGIN QUICKCPPLIB_BIND_NAMESPACE_BEGIN(OUTCOME_V2)
+#define OUTCOME_V2_NAMESPACE_EXPORT_BEGIN QUICKCPPLIB_BIND_NAMESPACE_BEGIN(OUTCOME_V2)
+#define OUTCOME_V2_NAMESPACE_END QUICKCPPLIB_BIND_NAMESPACE_END(OUTCOME_V2)
+#endif
+
+#endif
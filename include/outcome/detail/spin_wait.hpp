@@ -0,0 +1,98 @@
+/* Waiting upon an atomic to change
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_DETAIL_SPIN_WAIT_HPP
+#define OUTCOME_DETAIL_SPIN_WAIT_HPP
+
+#include "../config.hpp"
+
+#include <atomic>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  // Tell the CPU we are in a spin loop
+  inline void spin_pause() noexcept
+  {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_pause();
+#elif(defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_ia32_pause();
+#elif(defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+  }
+
+  /* Waits until `v` no longer holds `old`, returning the new value. Spins
+  for `spins` iterations first, after which it sleeps in the kernel if
+  the standard library offers atomic waits, otherwise yields.
+  */
+  template <class T> inline T spin_wait_while_equal(const std::atomic<T> &v, T old, unsigned spins = 4096) noexcept
+  {
+    // Spinning on a uniprocessor only delays the thread we are waiting upon
+    static const bool uniprocessor = std::thread::hardware_concurrency() == 1;
+    if(uniprocessor)
+    {
+      spins = 0;
+    }
+    T ret;
+    for(unsigned n = 0; n < spins; n++)
+    {
+      if((ret = v.load(std::memory_order_acquire)) != old)
+      {
+        return ret;
+      }
+      spin_pause();
+    }
+    while((ret = v.load(std::memory_order_acquire)) == old)
+    {
+#ifdef __cpp_lib_atomic_wait
+      v.wait(old, std::memory_order_acquire);
+#else
+      std::this_thread::yield();
+#endif
+    }
+    return ret;
+  }
+
+  // Wakes any threads blocked in spin_wait_while_equal()
+  template <class T> inline void spin_wait_notify_all(std::atomic<T> &v) noexcept
+  {
+#ifdef __cpp_lib_atomic_wait
+    v.notify_all();
+#else
+    (void) v;
+#endif
+  }
+}  // namespace detail
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
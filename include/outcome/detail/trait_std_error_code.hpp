@@ -26,10 +26,11 @@ Distributed under the Boost Software License, Version 1.0.
 #define OUTCOME_TRAIT_STD_ERROR_CODE_HPP
 
 #include "../config.hpp"
+#include "../sdt_probes.hpp"
 
 #include <system_error>
 
-OUTCOME_V2_NAMESPACE_BEGIN
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace detail
 {
@@ -58,6 +59,13 @@ namespace detail
   }
   template <class State> constexpr inline void _set_error_is_errno(State &state, const std::errc & /*unused*/) { state._status |= status_error_is_errno; }
 
+  // The probes report the address of the category of a std::error_code as its domain id
+  template <> struct sdt_error_info<std::error_code>
+  {
+    static uint64_t domain(const std::error_code &v) noexcept { return reinterpret_cast<uintptr_t>(&v.category()); }  // NOLINT
+    static int64_t value(const std::error_code &v) noexcept { return v.value(); }
+  };
+
 }  // namespace detail
 
 namespace policy
@@ -113,6 +121,17 @@ namespace trait
     static constexpr bool value = std::is_error_condition_enum<Enum>::value;
   };
 
+#if defined(_LIBCPP_VERSION) || (defined(_ITERATOR_DEBUG_LEVEL) && _ITERATOR_DEBUG_LEVEL == 0)
+  /* std::string, which <system_error> declares, can be swapped by swapping its bytes in the
+  libc++ and non-debug MSVC STL, as their short strings do not point into themselves, unlike
+  those of libstdc++.
+  */
+  template <class CharT, class Traits> struct is_trivially_relocatable<std::basic_string<CharT, Traits, std::allocator<CharT>>>
+  {
+    static constexpr bool value = true;
+  };
+#endif
+
 }  // namespace trait
 
 OUTCOME_V2_NAMESPACE_END
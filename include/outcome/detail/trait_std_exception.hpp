@@ -29,7 +29,7 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include <exception>
 
-OUTCOME_V2_NAMESPACE_BEGIN
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace policy
 {
@@ -83,6 +83,11 @@ namespace trait
   {
     static constexpr bool value = true;
   };
+  // std::exception_ptr is a reference counted pointer, so it can be swapped by swapping its bytes
+  template <> struct is_trivially_relocatable<std::exception_ptr>
+  {
+    static constexpr bool value = true;
+  };
 
 }  // namespace trait
 
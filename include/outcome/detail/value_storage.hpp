@@ -27,7 +27,7 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include "../config.hpp"
 
-OUTCOME_V2_NAMESPACE_BEGIN
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace detail
 {
@@ -108,16 +108,16 @@ namespace detail
   using status_bitfield_type = uint32_t;
 
   // WARNING: These bits are not tracked by abi-dumper, but changing them will break ABI!
-  static constexpr status_bitfield_type status_have_value = (1U << 0U);
-  static constexpr status_bitfield_type status_have_error = (1U << 1U);
-  static constexpr status_bitfield_type status_have_exception = (1U << 2U);
-  static constexpr status_bitfield_type status_lost_consistency = (1U << 3U);  // failed to complete a strong swap
-  static constexpr status_bitfield_type status_error_is_errno = (1U << 4U);    // can errno be set from this error?
+  OUTCOME_INLINE_CONSTEXPR status_bitfield_type status_have_value = (1U << 0U);
+  OUTCOME_INLINE_CONSTEXPR status_bitfield_type status_have_error = (1U << 1U);
+  OUTCOME_INLINE_CONSTEXPR status_bitfield_type status_have_exception = (1U << 2U);
+  OUTCOME_INLINE_CONSTEXPR status_bitfield_type status_lost_consistency = (1U << 3U);  // failed to complete a strong swap
+  OUTCOME_INLINE_CONSTEXPR status_bitfield_type status_error_is_errno = (1U << 4U);    // can errno be set from this error?
   // bit 7 unused
   // bits 8-15 unused
   // bits 16-31 used for user supplied 16 bit value
-  static constexpr status_bitfield_type status_2byte_shift = 16;
-  static constexpr status_bitfield_type status_2byte_mask = (0xffffU << status_2byte_shift);
+  OUTCOME_INLINE_CONSTEXPR status_bitfield_type status_2byte_shift = 16;
+  OUTCOME_INLINE_CONSTEXPR status_bitfield_type status_2byte_mask = (0xffffU << status_2byte_shift);
 
   // Used if T is trivial
   template <class T> struct value_storage_trivial
@@ -0,0 +1,250 @@
+/* Synthetic backtraces of where errors originated and which OUTCOME_TRY they passed through
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_ERROR_PROVENANCE_HPP
+#define OUTCOME_ERROR_PROVENANCE_HPP
+
+#include "detail/basic_result_storage.hpp"
+
+/* If OUTCOME_ENABLE_ERROR_PROVENANCE is 1, the default construction hooks of `basic_result` and
+`basic_outcome` record the call site of each failure into a global table, and store the index
+of its entry in the spare storage of the object (see `hooks::set_spare_storage()`). Each failure
+which `OUTCOME_TRY` returns appends an entry for its call site linked to the entry of its operand,
+and the failure constructed from it takes the index of that entry. So `error_provenance_backtrace()`
+of a failure lists the `OUTCOME_TRY` it passed through and where it originated, without unwinding.
+
+Successful construction costs one branch, failed construction and a failed `OUTCOME_TRY` an
+atomic increment. The table is a ring, so entries of failures older than the last
+OUTCOME_ERROR_PROVENANCE_ENTRIES are overwritten. The hop of an `OUTCOME_TRY` is taken by
+the failure it returns, and is discarded at the end of its return statement if that is not a
+result or outcome, or one whose construction hooks are customised. Call sites are
+only precise in optimised builds, where the constructors are inlined. The index means nothing
+outside the process, though the serialisations of the status of a result or outcome include it.
+*/
+#ifndef OUTCOME_ENABLE_ERROR_PROVENANCE
+#define OUTCOME_ENABLE_ERROR_PROVENANCE 0
+#endif
+
+/* Whether OUTCOME_TRY appends its call site to the provenance of the failures it returns. If
+not, they keep the provenance of its operand, so only where failures originated is recorded.
+*/
+#ifndef OUTCOME_ERROR_PROVENANCE_TRY_HOPS
+#define OUTCOME_ERROR_PROVENANCE_TRY_HOPS 1
+#endif
+
+// How many entries the table has, at most 65536 as the index must fit into the spare storage
+#ifndef OUTCOME_ERROR_PROVENANCE_ENTRIES
+#define OUTCOME_ERROR_PROVENANCE_ENTRIES 4096
+#endif
+
+/* The functions between the construction of a failure, or the failure branch of OUTCOME_TRY,
+and the out of line function recording its provenance are forced inline, so the return address
+of the latter is into the function which constructed or returned the failure. Otherwise compilers
+outline them on the cold path, and every call site would be within them.
+*/
+#if OUTCOME_ENABLE_ERROR_PROVENANCE && (defined(__GNUC__) || defined(__clang__))
+#define OUTCOME_ERROR_PROVENANCE_FORCEINLINE __attribute__((always_inline))
+#elif OUTCOME_ENABLE_ERROR_PROVENANCE && defined(_MSC_VER)
+#define OUTCOME_ERROR_PROVENANCE_FORCEINLINE __forceinline
+#else
+#define OUTCOME_ERROR_PROVENANCE_FORCEINLINE
+#endif
+
+#if OUTCOME_ENABLE_ERROR_PROVENANCE
+//! Records the provenance of the failure of the result or outcome at `ptr`, if it is one and has none
+#define OUTCOME_ERROR_PROVENANCE_ORIGIN(ptr) OUTCOME_V2_NAMESPACE::detail::error_provenance_origin(ptr)
+#else
+#define OUTCOME_ERROR_PROVENANCE_ORIGIN(ptr) ((void) (ptr))
+#endif
+#if OUTCOME_ENABLE_ERROR_PROVENANCE
+//! Records that `OUTCOME_TRY` is returning the failure of the object at `ptr`
+#define OUTCOME_ERROR_PROVENANCE_HOP(ptr) OUTCOME_V2_NAMESPACE::detail::error_provenance_hop(ptr)
+#else
+#define OUTCOME_ERROR_PROVENANCE_HOP(ptr) ((void) (ptr))
+#endif
+
+#if OUTCOME_ENABLE_ERROR_PROVENANCE
+/* The last parameter of `try_operation_return_as()`, whose default argument discards the hop of
+the `OUTCOME_TRY` once the failure it returns is constructed, at the end of the return statement.
+*/
+#define OUTCOME_ERROR_PROVENANCE_HOP_SCOPE , const OUTCOME_V2_NAMESPACE::detail::error_provenance_hop_scope & /*unused*/ = OUTCOME_V2_NAMESPACE::detail::error_provenance_hop_scope()
+#else
+#define OUTCOME_ERROR_PROVENANCE_HOP_SCOPE
+#endif
+
+#if OUTCOME_ENABLE_ERROR_PROVENANCE
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+//! An entry of the table of error provenance
+struct error_provenance_entry
+{
+  const void *call_site;  // the return address into the function which constructed or returned the failure
+  uint16_t previous;      // the index of the entry of the failure this one was returned from, or zero
+};
+
+/*! The global table of error provenance. Entries are claimed by an atomic increment, so recording
+takes no lock, never allocates and never fails, overwriting the oldest entry when full. Index zero
+means no entry.
+*/
+class error_provenance_table
+{
+  static_assert(OUTCOME_ERROR_PROVENANCE_ENTRIES >= 2 && OUTCOME_ERROR_PROVENANCE_ENTRIES <= 65536, "OUTCOME_ERROR_PROVENANCE_ENTRIES must be between 2 and 65536");
+  struct _entry
+  {
+    std::atomic<const void *> call_site;
+    std::atomic<uint16_t> previous;
+  };
+  // Zero initialised by being static, so there is no guard on first use
+  _entry _entries[OUTCOME_ERROR_PROVENANCE_ENTRIES];
+  std::atomic<uint32_t> _next;
+
+public:
+  //! Appends an entry, returning its index
+  uint16_t push_back(const void *call_site, uint16_t previous) noexcept
+  {
+    const auto idx = static_cast<uint16_t>(_next.fetch_add(1, std::memory_order_relaxed) % (OUTCOME_ERROR_PROVENANCE_ENTRIES - 1) + 1);
+    _entries[idx].call_site.store(call_site, std::memory_order_relaxed);
+    _entries[idx].previous.store(previous, std::memory_order_relaxed);
+    return idx;
+  }
+  //! The entry at `idx`, which is empty for index zero
+  error_provenance_entry operator[](uint16_t idx) const noexcept
+  {
+    if(idx == 0 || idx >= OUTCOME_ERROR_PROVENANCE_ENTRIES)
+    {
+      return {nullptr, 0};
+    }
+    return {_entries[idx].call_site.load(std::memory_order_relaxed), _entries[idx].previous.load(std::memory_order_relaxed)};
+  }
+  //! How many entries have ever been appended, modulo 2^32
+  uint32_t recorded() const noexcept { return _next.load(std::memory_order_relaxed); }
+};
+
+//! The table of error provenance of the process
+inline error_provenance_table &error_provenance() noexcept
+{
+  static error_provenance_table table;
+  return table;
+}
+
+namespace detail
+{
+  // The hop of the OUTCOME_TRY of this thread whose failure is being returned
+  inline uint16_t &error_provenance_pending() noexcept
+  {
+    static OUTCOME_THREAD_LOCAL uint16_t pending;
+    return pending;
+  }
+
+  /* Lives until the end of the return statement of an OUTCOME_TRY, after the failure it returns
+  has been constructed. If that failure did not take the hop, because it is not a result or outcome,
+  or its construction hooks are customised, no later failure of the thread does.
+  */
+  struct error_provenance_hop_scope
+  {
+    error_provenance_hop_scope() = default;
+    error_provenance_hop_scope(const error_provenance_hop_scope &) = delete;
+    error_provenance_hop_scope &operator=(const error_provenance_hop_scope &) = delete;
+    ~error_provenance_hop_scope() { error_provenance_pending() = 0; }
+  };
+
+  // Out of line, so the return address is into the function which constructed or returned the failure
+  OUTCOME_COLD_NOINLINE inline uint16_t error_provenance_record_origin() noexcept
+  {
+    uint16_t &pending = error_provenance_pending();
+    if(pending != 0)
+    {
+      const uint16_t ret = pending;
+      pending = 0;
+      return ret;
+    }
+#ifdef _MSC_VER
+    return error_provenance().push_back(_ReturnAddress(), 0);
+#else
+    return error_provenance().push_back(__builtin_return_address(0), 0);
+#endif
+  }
+  OUTCOME_COLD_NOINLINE inline void error_provenance_record_hop(uint16_t previous) noexcept
+  {
+#if !OUTCOME_ERROR_PROVENANCE_TRY_HOPS
+    // The failure returned takes the provenance of the operand
+    error_provenance_pending() = previous;
+#elif defined(_MSC_VER)
+    error_provenance_pending() = error_provenance().push_back(_ReturnAddress(), previous);
+#else
+    error_provenance_pending() = error_provenance().push_back(__builtin_return_address(0), previous);
+#endif
+  }
+
+  // The provenance of a result or outcome, and none for anything else OUTCOME_TRY can return from
+  template <class R, class S, class NoValuePolicy> constexpr inline uint16_t error_provenance_index(const basic_result_final<R, S, NoValuePolicy> *r) noexcept { return hooks::spare_storage(r); }
+  constexpr inline uint16_t error_provenance_index(const void * /*unused*/) noexcept { return 0; }
+
+  template <class T> OUTCOME_ERROR_PROVENANCE_FORCEINLINE constexpr inline void error_provenance_origin(T *r) noexcept
+  {
+    if(r->has_failure() && !OUTCOME_IS_CONSTANT_EVALUATED() && hooks::spare_storage(r) == 0)
+    {
+      hooks::set_spare_storage(r, error_provenance_record_origin());
+    }
+  }
+  template <class T> OUTCOME_ERROR_PROVENANCE_FORCEINLINE constexpr inline void error_provenance_hop(const T *x) noexcept
+  {
+    if(!OUTCOME_IS_CONSTANT_EVALUATED())
+    {
+      error_provenance_record_hop(error_provenance_index(x));
+    }
+  }
+}  // namespace detail
+
+/*! Fills `call_sites` with at most `max` call sites of the provenance of `r`, the most recent
+`OUTCOME_TRY` first and where its failure originated last, returning how many. Entries of failures
+which have since been overwritten in the table give a truncated or wrong backtrace.
+*/
+template <class R, class S, class NoValuePolicy> inline size_t error_provenance_backtrace(const detail::basic_result_final<R, S, NoValuePolicy> &r, const void **call_sites, size_t max) noexcept
+{
+  size_t n = 0;
+  for(uint16_t idx = hooks::spare_storage(&r); idx != 0 && n < max; n++)
+  {
+    const error_provenance_entry entry = error_provenance()[idx];
+    if(entry.call_site == nullptr)
+    {
+      break;
+    }
+    call_sites[n] = entry.call_site;
+    idx = entry.previous;
+  }
+  return n;
+}
+
+OUTCOME_V2_NAMESPACE_END
+#endif
+
+#endif
@@ -25,6 +25,7 @@ Distributed under the Boost Software License, Version 1.0.
 #ifndef OUTCOME_EXPERIMENTAL_RESULT_H
 #define OUTCOME_EXPERIMENTAL_RESULT_H
 
+#include <stddef.h>  // for size_t
 #include <stdint.h>  // for intptr_t
 
 #define CXX_DECLARE_RESULT(ident, R, S)                                                                                                                                                                                                                                                                                        \
@@ -73,4 +74,100 @@ struct cxx_status_code_system
 #define CXX_DECLARE_RESULT_SYSTEM(ident, R) CXX_DECLARE_RESULT(system_##ident, R, struct cxx_status_code_system)
 #define CXX_RESULT_SYSTEM(ident) CXX_RESULT(system_##ident)
 
+/* The functions below are implemented by <outcome/experimental/status_code_c_api.hpp>, which
+one C++ translation unit of the program must include.
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returns a number uniquely and stably identifying the domain of `code`, which is the same in
+every process and build, or zero if `code` is empty.
+*/
+extern uint64_t cxx_status_code_system_domain_id(const struct cxx_status_code_system *code);
+
+/* Writes the name of the domain of `code` into `buffer`, truncating it if necessary to fit
+`bufferlen` bytes including the terminating zero.
+Returns the length of the whole name, as snprintf() does.
+*/
+extern size_t cxx_status_code_system_domain_name(const struct cxx_status_code_system *code, char *buffer, size_t bufferlen);
+
+/* Writes the message of `code` into `buffer`, truncating it if necessary to fit `bufferlen`
+bytes including the terminating zero. Messages are cached per thread, so after the first time
+writing the message of a code does not allocate.
+Returns the length of the whole message, as snprintf() does.
+*/
+extern size_t cxx_status_code_system_message(const struct cxx_status_code_system *code, char *buffer, size_t bufferlen);
+
+/* Returns 1 (true) if `code` is semantically equivalent to the `errno` value `errcode`, which
+works for codes of any domain, not just the POSIX one.
+*/
+extern int cxx_status_code_system_equivalent_errno(const struct cxx_status_code_system *code, int errcode);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/***************************** Batches of results ******************************/
+
+#define CXX_DECLARE_RESULT_BATCH(ident, R, S)                                                                                                                                                                                                                                                                                  \
+  struct cxx_result_batch_##ident                                                                                                                                                                                                                                                                                              \
+  {                                                                                                                                                                                                                                                                                                                            \
+    R *values;                                                                                                                                                                                                                                                                                                                 \
+    const uint64_t *success;                                                                                                                                                                                                                                                                                                   \
+    S *errors;                                                                                                                                                                                                                                                                                                                 \
+    const uint64_t *errors_are_errno;                                                                                                                                                                                                                                                                                          \
+    size_t count;                                                                                                                                                                                                                                                                                                              \
+    size_t error_count;                                                                                                                                                                                                                                                                                                        \
+  }
+
+#define CXX_RESULT_BATCH(ident) struct cxx_result_batch_##ident
+
+#define CXX_RESULT_BATCH_HAS_VALUE(b, idx) ((((b).success[(idx) / 64U] >> ((idx) % 64U)) & 1U) == 1U)
+
+#define CXX_RESULT_BATCH_ERROR_IS_ERRNO(b, erroridx) ((((b).errors_are_errno[(erroridx) / 64U] >> ((erroridx) % 64U)) & 1U) == 1U)
+
+#define CXX_DECLARE_RESULT_BATCH_SYSTEM(ident, R) CXX_DECLARE_RESULT_BATCH(system_##ident, R, struct cxx_status_code_system)
+#define CXX_RESULT_BATCH_SYSTEM(ident) CXX_RESULT_BATCH(system_##ident)
+
+/* Returns the index of the first failed result at or after `idx`, or `count` if there are none.
+Failures are found a bitmap word at a time, so successes cost almost nothing to skip.
+*/
+static inline size_t cxx_result_batch_next_failure(const uint64_t *success, size_t count, size_t idx)
+{
+  size_t word = idx / 64U;
+  uint64_t failed;
+  if(idx >= count)
+  {
+    return count;
+  }
+  failed = ~success[word] & (~(uint64_t) 0 << (idx % 64U));
+  while(failed == 0)
+  {
+    if(++word * 64U >= count)
+    {
+      return count;
+    }
+    failed = ~success[word];
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  idx = word * 64U + (size_t) __builtin_ctzll(failed);
+#else
+  idx = word * 64U;
+  while((failed & 1U) == 0)
+  {
+    failed >>= 1U;
+    ++idx;
+  }
+#endif
+  return (idx < count) ? idx : count;
+}
+
+/* Loops over the failed results in batch `b`, setting `idx` to the index of each and `erroridx`
+to the index of its error within `b.errors`. Both are declared by the loop.
+*/
+#define CXX_RESULT_BATCH_FOR_EACH_FAILURE(b, idx, erroridx)                                                                                                                                                                                                                                                                    \
+  for(size_t idx = cxx_result_batch_next_failure((b).success, (b).count, 0), erroridx = 0; idx < (b).count; idx = cxx_result_batch_next_failure((b).success, (b).count, idx + 1), ++erroridx)
+
 #endif
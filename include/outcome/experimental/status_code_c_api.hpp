@@ -0,0 +1,137 @@
+/* The C API for status codes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXPERIMENTAL_STATUS_CODE_C_API_HPP
+#define OUTCOME_EXPERIMENTAL_STATUS_CODE_C_API_HPP
+
+/* This header only declares the extern "C" functions of result.h for C++. They are defined by
+src/status_code_c_api.cpp, which includes this header with OUTCOME_C_API_IMPLEMENTATION
+defined, and is built into the outcome_c_api library.
+*/
+
+#include "status_result.hpp"
+
+#include "result.h"
+
+#include <cstring>
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace experimental
+{
+  namespace detail
+  {
+    static_assert(sizeof(system_code) == sizeof(cxx_status_code_system) && alignof(system_code) == alignof(cxx_status_code_system), "system_code does not have the layout of cxx_status_code_system");
+
+    inline const system_code &c_api_code(const cxx_status_code_system *code) noexcept { return *reinterpret_cast<const system_code *>(code); }  // NOLINT
+
+    // Writes as much of `s` as fits into the buffer, always zero terminating it
+    inline size_t c_api_copy(const char *s, size_t len, char *buffer, size_t bufferlen) noexcept
+    {
+      if(bufferlen > 0)
+      {
+        const size_t tocopy = (len < bufferlen) ? len : bufferlen - 1;
+        memcpy(buffer, s, tocopy);
+        buffer[tocopy] = 0;
+      }
+      return len;
+    }
+
+    /* A direct mapped per thread cache of messages, so logging the same few codes over and over
+    neither calls the domain nor allocates, as the POSIX domain's strerror_r() does. Messages too
+    long for an entry are never cached.
+    */
+    struct c_api_message_cache
+    {
+      static constexpr size_t entries = 64, max_length = 111;
+      struct entry
+      {
+        const void *domain;
+        intptr_t value;
+        size_t length;
+        char message[max_length + 1];
+      } cache[entries];
+
+      static size_t slot(const void *domain, intptr_t value) noexcept
+      {
+        const auto h = (reinterpret_cast<uintptr_t>(domain) ^ static_cast<uintptr_t>(value)) * UINT64_C(0x9E3779B97F4A7C15);  // NOLINT
+        return static_cast<size_t>(h >> 32) % entries;
+      }
+    };
+  }  // namespace detail
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+#ifdef OUTCOME_C_API_IMPLEMENTATION
+extern "C" uint64_t cxx_status_code_system_domain_id(const struct cxx_status_code_system *code)
+{
+  const auto &sc = OUTCOME_V2_NAMESPACE::experimental::detail::c_api_code(code);
+  return sc.empty() ? 0 : sc.domain().id();
+}
+
+extern "C" size_t cxx_status_code_system_domain_name(const struct cxx_status_code_system *code, char *buffer, size_t bufferlen)
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental::detail;
+  const auto &sc = c_api_code(code);
+  if(sc.empty())
+  {
+    return c_api_copy("", 0, buffer, bufferlen);
+  }
+  const auto name = sc.domain().name();
+  return c_api_copy(name.data(), name.size(), buffer, bufferlen);
+}
+
+extern "C" size_t cxx_status_code_system_message(const struct cxx_status_code_system *code, char *buffer, size_t bufferlen)
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental::detail;
+  static thread_local c_api_message_cache cache;  // zero initialised
+  const auto &sc = c_api_code(code);
+  if(sc.empty())
+  {
+    return c_api_copy("", 0, buffer, bufferlen);
+  }
+  auto &e = cache.cache[c_api_message_cache::slot(code->domain, code->value)];
+  if(e.domain != code->domain || e.value != code->value)
+  {
+    const auto msg = sc.message();
+    if(msg.size() > c_api_message_cache::max_length)
+    {
+      return c_api_copy(msg.data(), msg.size(), buffer, bufferlen);
+    }
+    e.domain = code->domain;
+    e.value = code->value;
+    e.length = c_api_copy(msg.data(), msg.size(), e.message, sizeof(e.message));
+  }
+  return c_api_copy(e.message, e.length, buffer, bufferlen);
+}
+
+extern "C" int cxx_status_code_system_equivalent_errno(const struct cxx_status_code_system *code, int errcode)
+{
+  const auto &sc = OUTCOME_V2_NAMESPACE::experimental::detail::c_api_code(code);
+  return static_cast<int>(!sc.empty() && sc.equivalent(SYSTEM_ERROR2_NAMESPACE::generic_code(static_cast<SYSTEM_ERROR2_NAMESPACE::errc>(errcode))));
+}
+#endif
+
+#endif
@@ -0,0 +1,78 @@
+/* Status code domains constant initialised on every C++ standard
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXPERIMENTAL_STATUS_CODE_CONSTANT_DOMAIN_HPP
+#define OUTCOME_EXPERIMENTAL_STATUS_CODE_CONSTANT_DOMAIN_HPP
+
+#include "status_result.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace experimental
+{
+  namespace detail
+  {
+    /* A static data member of a class template, rather than a function local static or a variable
+    template, as it is constant initialised, has one address in every translation unit, and can be
+    defined in a header on every C++ standard.
+    */
+    template <class Domain> struct constant_status_code_domain_instance
+    {
+      static constexpr Domain value{};
+    };
+#if __cplusplus < 201700L && (!defined(_MSVC_LANG) || _MSVC_LANG < 201700L)
+    template <class Domain> constexpr Domain constant_status_code_domain_instance<Domain>::value;
+#endif
+  }  // namespace detail
+
+  /*! A base for a status code domain `Domain` which is a singleton constant initialised at compile
+  time, so neither calling `get()` nor `name()` nor the domain's virtual functions ever checks a
+  static initialisation guard, or takes its lock on first use, as the `static` variables in functions
+  which status code domains usually use for these would. `Domain` must provide:
+
+  - A `constexpr` default constructor passing its unique id to this base.
+  - A trivial destructor.
+  - `static constexpr const char *domain_name`, the name of the domain.
+
+  `Base` is the domain this derives from, by default `status_code_domain`.
+  */
+  template <class Domain, class Base = status_code_domain> class constant_status_code_domain : public Base
+  {
+  public:
+    using string_ref = typename Base::string_ref;
+
+    //! Constexpr singleton getter. Returns the constant initialised instance of `Domain`.
+    static constexpr const Domain &get() noexcept { return detail::constant_status_code_domain_instance<Domain>::value; }
+
+    //! The name of the domain, which refers to the static string `Domain::domain_name`.
+    virtual string_ref name() const noexcept override { return string_ref(Domain::domain_name); }  // NOLINT
+
+  protected:
+    using Base::Base;
+  };
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
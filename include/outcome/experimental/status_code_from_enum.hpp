@@ -0,0 +1,204 @@
+/* Status code domains declared by tables of the values of an enum
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXPERIMENTAL_STATUS_CODE_FROM_ENUM_HPP
+#define OUTCOME_EXPERIMENTAL_STATUS_CODE_FROM_ENUM_HPP
+
+#include "status_result.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace experimental
+{
+  /*! One row of the table describing an enum's status code domain: the enum value, its message,
+  and the generic code it is equivalent to, which is `errc::success` if the value is not a failure,
+  and `errc::unknown` if it is equivalent to no generic code.
+  */
+  template <class Enum> struct enum_status_code_mapping
+  {
+    Enum value;
+    const char *message;
+    errc code;
+  };
+
+  /*! Specialise this for an enum to generate its status code domain `_enum_status_code_domain<Enum>`,
+  providing:
+
+  - `static constexpr const char *domain_name`, the name of the domain.
+  - `static constexpr unsigned long long domain_id`, a unique randomly chosen id for the domain.
+  - `static constexpr enum_status_code_mapping<Enum> mappings[]`, a row for each enum value. If
+  the values are `0, 1, 2 ...` in order, lookups index the table, else they search it. Before
+  C++ 17, `mappings` must also be defined outside the class.
+
+  Then declare `make_status_code(Enum)` returning `enum_status_code<Enum>` in the enum's namespace.
+  */
+  template <class Enum> struct enum_status_code_traits;
+
+  template <class Enum> class _enum_status_code_domain;
+  //! The status code generated for `Enum` by specialising `enum_status_code_traits<Enum>`.
+  template <class Enum> using enum_status_code = status_code<_enum_status_code_domain<Enum>>;
+
+  namespace detail
+  {
+    template <class Enum, size_t N> constexpr inline bool enum_status_code_mappings_dense(const enum_status_code_mapping<Enum> (&mappings)[N]) noexcept
+    {
+      for(size_t n = 0; n < N; n++)
+      {
+        if(static_cast<size_t>(mappings[n].value) != n)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    template <class Enum, size_t N> constexpr inline size_t enum_status_code_mappings_count(const enum_status_code_mapping<Enum> (& /*unused*/)[N]) noexcept { return N; }
+  }  // namespace detail
+
+  /*! The domain generated for an enum by `enum_status_code_traits<Enum>`. Its lookups are constexpr
+  functions, which its virtual functions call. As it is `final`, the compiler can devirtualise the
+  calls of `enum_status_code<Enum>`, and the comparison operators below call the lookups directly.
+  */
+  template <class Enum> class _enum_status_code_domain final : public status_code_domain
+  {
+    template <class> friend class SYSTEM_ERROR2_NAMESPACE::status_code;
+    using _base = status_code_domain;
+    using _traits = enum_status_code_traits<Enum>;
+    using _mapping = enum_status_code_mapping<Enum>;
+    using _code = enum_status_code<Enum>;
+
+    static constexpr size_t _count = detail::enum_status_code_mappings_count(_traits::mappings);
+    static constexpr bool _dense = detail::enum_status_code_mappings_dense(_traits::mappings);
+
+  public:
+    using value_type = Enum;
+    using string_ref = _base::string_ref;
+
+    //! Default constructor
+    constexpr explicit _enum_status_code_domain(typename _base::unique_id_type id = _traits::domain_id) noexcept : _base(id) {}
+
+    //! Constexpr singleton getter. Returns the constexpr `enum_status_code_domain<Enum>` variable.
+    static inline constexpr const _enum_status_code_domain &get();
+
+    //! The row of the table for a value, or null if there is none.
+    static constexpr const _mapping *find(Enum v) noexcept
+    {
+      if(_dense)
+      {
+        return (static_cast<size_t>(v) < _count) ? &_traits::mappings[static_cast<size_t>(v)] : nullptr;
+      }
+      for(size_t n = 0; n < _count; n++)
+      {
+        if(_traits::mappings[n].value == v)
+        {
+          return &_traits::mappings[n];
+        }
+      }
+      return nullptr;
+    }
+    //! The message for a value.
+    static constexpr const char *message(Enum v) noexcept
+    {
+      const _mapping *m = find(v);
+      return (m != nullptr) ? m->message : "unknown";
+    }
+    //! The generic code a value is equivalent to.
+    static constexpr errc generic(Enum v) noexcept
+    {
+      const _mapping *m = find(v);
+      return (m != nullptr) ? m->code : errc::unknown;
+    }
+    //! True if two values are equivalent, exactly as `status_code::equivalent()` would find them.
+    static constexpr bool equivalent(Enum a, Enum b) noexcept { return a == b || (generic(a) != errc::unknown && generic(a) == generic(b)); }
+
+    virtual string_ref name() const noexcept override final { return string_ref(_traits::domain_name); }  // NOLINT
+
+  protected:
+    virtual bool _do_failure(const status_code<void> &code) const noexcept override final  // NOLINT
+    {
+      assert(code.domain() == *this);  // NOLINT
+      return generic(static_cast<const _code &>(code).value()) != errc::success;  // NOLINT
+    }
+    virtual bool _do_equivalent(const status_code<void> &code1, const status_code<void> &code2) const noexcept override final  // NOLINT
+    {
+      assert(code1.domain() == *this);  // NOLINT
+      const auto &c1 = static_cast<const _code &>(code1);  // NOLINT
+      if(code2.domain() == *this)
+      {
+        const auto &c2 = static_cast<const _code &>(code2);  // NOLINT
+        return c1.value() == c2.value();
+      }
+      if(code2.domain() == generic_code_domain)
+      {
+        const auto &c2 = static_cast<const generic_code &>(code2);  // NOLINT
+        const errc c = generic(c1.value());
+        return c != errc::unknown && c == c2.value();
+      }
+      return false;
+    }
+    virtual generic_code _generic_code(const status_code<void> &code) const noexcept override final  // NOLINT
+    {
+      assert(code.domain() == *this);  // NOLINT
+      return generic_code(generic(static_cast<const _code &>(code).value()));  // NOLINT
+    }
+    virtual string_ref _do_message(const status_code<void> &code) const noexcept override final  // NOLINT
+    {
+      assert(code.domain() == *this);  // NOLINT
+      return string_ref(message(static_cast<const _code &>(code).value()));  // NOLINT
+    }
+#if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || 0
+    SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override final  // NOLINT
+    {
+      assert(code.domain() == *this);  // NOLINT
+      throw status_error<_enum_status_code_domain>(static_cast<const _code &>(code));  // NOLINT
+    }
+#endif
+  };
+  //! A constexpr source variable for the domain of an enum. Returned by `_enum_status_code_domain<Enum>::get()`.
+  template <class Enum> OUTCOME_INLINE_CONSTEXPR _enum_status_code_domain<Enum> enum_status_code_domain{};
+  template <class Enum> inline constexpr const _enum_status_code_domain<Enum> &_enum_status_code_domain<Enum>::get() { return enum_status_code_domain<Enum>; }
+
+  /* Comparisons of codes of the same enum, and with the enum, which are equivalent to those of
+  status-code but compare the values directly rather than calling the domain's virtual functions.
+  */
+  template <class Enum> inline bool operator==(const enum_status_code<Enum> &a, const enum_status_code<Enum> &b) noexcept
+  {
+    if(a.empty() || b.empty())
+    {
+      return a.empty() && b.empty();
+    }
+    return _enum_status_code_domain<Enum>::equivalent(a.value(), b.value());
+  }
+  template <class Enum> inline bool operator!=(const enum_status_code<Enum> &a, const enum_status_code<Enum> &b) noexcept { return !(a == b); }
+  template <class Enum> inline bool operator==(const enum_status_code<Enum> &a, Enum b) noexcept { return !a.empty() && _enum_status_code_domain<Enum>::equivalent(a.value(), b); }
+  template <class Enum> inline bool operator==(Enum a, const enum_status_code<Enum> &b) noexcept { return b == a; }
+  template <class Enum> inline bool operator!=(const enum_status_code<Enum> &a, Enum b) noexcept { return !(a == b); }
+  template <class Enum> inline bool operator!=(Enum a, const enum_status_code<Enum> &b) noexcept { return !(b == a); }
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
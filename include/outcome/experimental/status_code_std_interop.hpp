@@ -0,0 +1,284 @@
+/* Allocation free conversions between std::error_code and status_code
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXPERIMENTAL_STATUS_CODE_STD_INTEROP_HPP
+#define OUTCOME_EXPERIMENTAL_STATUS_CODE_STD_INTEROP_HPP
+
+#include "../std_result.hpp"
+#include "status_result.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <functional>  // for std::less
+#include <thread>
+
+//! The number of distinct status code domains which can be represented as a `std::error_category`.
+#ifndef OUTCOME_STATUS_CODE_STD_INTEROP_CATEGORIES
+#define OUTCOME_STATUS_CODE_STD_INTEROP_CATEGORIES 64
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace experimental
+{
+  namespace detail
+  {
+    // Reassembles the erased status code of `domain` with `value`, as `status_code<erased<>>` has no public constructor for this.
+    class rebuilt_status_code : public system_code
+    {
+    public:
+      rebuilt_status_code(const status_code_domain *domain, intptr_t value) noexcept
+      {
+        this->_domain = domain;
+        this->_value = value;
+      }
+    };
+
+    /* A `std::error_category` standing in for one status code domain. Its state is the pointer
+    to that domain, claimed on first use, and a copy of the domain's name, as the name of a domain
+    need not outlive the `string_ref` returning it. So an array of these can be constant
+    initialised and needs neither a lock nor the heap. Names longer than the copy are truncated.
+    */
+    class status_code_error_category : public std::error_category
+    {
+      static constexpr size_t _name_size = 64;
+      std::atomic<bool> _claimed;
+      // Published once the name has been copied
+      std::atomic<const status_code_domain *> _domain;
+      char _name[_name_size];
+
+    public:
+      constexpr status_code_error_category() noexcept
+          : _claimed(false)
+          , _domain(nullptr)
+          , _name{}
+      {
+      }
+
+      const status_code_domain *domain() const noexcept { return _domain.load(std::memory_order_acquire); }
+      // Returns true if this now stands in for `domain`
+      bool claim(const status_code_domain *domain) noexcept
+      {
+        bool expected = false;
+        if(_claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+          const auto name = domain->name();
+          const size_t n = (name.size() < _name_size) ? name.size() : _name_size - 1;
+          memcpy(_name, name.data(), n);
+          _name[n] = 0;
+          _domain.store(domain, std::memory_order_release);
+          return true;
+        }
+        // Another thread is claiming this for some domain, which takes no time at all
+        const status_code_domain *d;
+        while((d = this->domain()) == nullptr)
+        {
+          std::this_thread::yield();
+        }
+        return *d == *domain;
+      }
+
+      virtual const char *name() const noexcept override { return _name; }  // NOLINT
+      virtual std::string message(int code) const override                                    // NOLINT
+      {
+        const auto msg = rebuilt_status_code(domain(), code).message();
+        return std::string(msg.data(), msg.size());
+      }
+      virtual bool equivalent(int code, const std::error_condition &cond) const noexcept override;  // NOLINT
+    };
+
+    template <class T = void> struct status_code_error_categories
+    {
+      static status_code_error_category table[OUTCOME_STATUS_CODE_STD_INTEROP_CATEGORIES];
+
+      static const status_code_error_category *find(const std::error_category &cat) noexcept
+      {
+        const std::less<const void *> less;
+        if(less(&cat, table) || !less(&cat, table + OUTCOME_STATUS_CODE_STD_INTEROP_CATEGORIES))
+        {
+          return nullptr;
+        }
+        return table + (static_cast<const status_code_error_category *>(&cat) - table);
+      }
+      static const status_code_error_category *get(const status_code_domain &domain) noexcept
+      {
+        for(auto &cat : table)
+        {
+          const status_code_domain *d = cat.domain();
+          if(d == nullptr ? cat.claim(&domain) : *d == domain)
+          {
+            return &cat;
+          }
+        }
+        return nullptr;
+      }
+    };
+    template <class T> status_code_error_category status_code_error_categories<T>::table[OUTCOME_STATUS_CODE_STD_INTEROP_CATEGORIES];
+
+    inline bool status_code_error_category::equivalent(int code, const std::error_condition &cond) const noexcept
+    {
+      if(cond.category() == std::generic_category())
+      {
+        return rebuilt_status_code(domain(), code).equivalent(generic_code(static_cast<errc>(cond.value())));
+      }
+      if(const status_code_error_category *other = status_code_error_categories<>::find(cond.category()))
+      {
+        return rebuilt_status_code(domain(), code).equivalent(rebuilt_status_code(other->domain(), cond.value()));
+      }
+      return std::error_category::equivalent(code, cond);
+    }
+
+    inline std::error_code to_error_code(const status_code_domain *domain, intptr_t value) noexcept
+    {
+      if(domain == nullptr)
+      {
+        return {};
+      }
+      if(*domain == generic_code_domain)
+      {
+        return {static_cast<int>(value), std::generic_category()};
+      }
+#ifdef _WIN32
+      if(*domain == win32_code_domain)
+#else
+      if(*domain == posix_code_domain)
+#endif
+      {
+        return {static_cast<int>(value), std::system_category()};
+      }
+      // std::error_code can keep no more than an int, which to_status_code() sign extends again
+      if(value != static_cast<intptr_t>(static_cast<int>(value)))
+      {
+        return std::make_error_code(std::errc::value_too_large);
+      }
+      if(const status_code_error_category *cat = status_code_error_categories<>::get(*domain))
+      {
+        return {static_cast<int>(value), *cat};
+      }
+      return std::make_error_code(std::errc::not_enough_memory);
+    }
+  }  // namespace detail
+
+  /*! Returns the `std::error_code` equivalent to the status code `sc`. This never allocates memory.
+
+  Generic codes become codes of `std::generic_category()`, and the platform's system codes, POSIX
+  or Win32, codes of `std::system_category()`. The codes of any other domain become codes of a
+  `std::error_category` standing in for that domain, whose `message()` and comparisons with
+  `std::error_condition`s of `std::generic_category()` defer to the domain, and whose `name()` is
+  a copy of the domain's, truncated to 63 characters. There can be up to
+  `OUTCOME_STATUS_CODE_STD_INTEROP_CATEGORIES` such domains in a program, after which the code
+  becomes `std::errc::not_enough_memory`. A value which does not fit into an `int` becomes
+  `std::errc::value_too_large`. An empty status code becomes a default constructed `std::error_code`.
+
+  The value of the status code must be trivially copyable, as it is for every status code domain
+  bar `nested_status_code`'s.
+  */
+  OUTCOME_TEMPLATE(class DomainType)
+  OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_trivially_copyable<typename status_code<DomainType>::value_type>::value &&SYSTEM_ERROR2_NAMESPACE::detail::type_erasure_is_safe<intptr_t, typename status_code<DomainType>::value_type>::value))
+  inline std::error_code to_error_code(const status_code<DomainType> &sc) noexcept
+  {
+    return sc.empty() ? std::error_code() : detail::to_error_code(&sc.domain(), SYSTEM_ERROR2_NAMESPACE::detail::erasure_cast<intptr_t>(sc.value()));
+  }
+  //! \overload
+  template <class ErasedType> inline std::error_code to_error_code(const status_code<erased<ErasedType>> &sc) noexcept { return sc.empty() ? std::error_code() : detail::to_error_code(&sc.domain(), static_cast<intptr_t>(sc.value())); }
+
+  /*! Returns the erased status code equivalent to `ec`. This never allocates memory.
+
+  Codes of `std::generic_category()` become `generic_code`, and codes of `std::system_category()`
+  the platform's system code, `posix_code` or `win32_code`. Codes made by `to_error_code()` become
+  the status code they were made from. Codes of any other category become the `generic_code` of
+  their `default_error_condition()` if it is of `std::generic_category()`, else `errc::unknown`.
+  */
+  inline system_code to_status_code(const std::error_code &ec) noexcept
+  {
+    const std::error_category &cat = ec.category();
+    if(cat == std::generic_category())
+    {
+      return generic_code(static_cast<errc>(ec.value()));
+    }
+    if(cat == std::system_category())
+    {
+#ifdef _WIN32
+      return win32_code(static_cast<win32::DWORD>(ec.value()));
+#else
+      return posix_code(ec.value());
+#endif
+    }
+    if(const detail::status_code_error_category *ours = detail::status_code_error_categories<>::find(cat))
+    {
+      return detail::rebuilt_status_code(ours->domain(), ec.value());
+    }
+    const std::error_condition cond = ec.default_error_condition();
+    return generic_code((cond.category() == std::generic_category()) ? static_cast<errc>(cond.value()) : errc::unknown);
+  }
+}  // namespace experimental
+
+namespace convert
+{
+  /*! Explicitly converts a `basic_result` with a status code error into one with a `std::error_code`
+  error, using `experimental::to_error_code()`. This enables the explicit converting constructor.
+  */
+  template <class T, class NoValuePolicy, class U, class DomainType, class NoValuePolicy2> struct value_or_error<basic_result<T, std::error_code, NoValuePolicy>, basic_result<U, SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>, NoValuePolicy2>>
+  {
+    static constexpr bool enable_result_inputs = true;
+    static constexpr bool enable_outcome_inputs = false;
+    OUTCOME_TEMPLATE(class X)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_same<basic_result<U, SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>, NoValuePolicy2>, std::decay_t<X>>::value                  //
+                                    && (std::is_void<U>::value || OUTCOME_V2_NAMESPACE::detail::is_explicitly_constructible<T, U>)),                                          //
+                      OUTCOME_TEXPR(experimental::to_error_code(std::declval<X>().assume_error())))
+    basic_result<T, std::error_code, NoValuePolicy> operator()(X &&v) noexcept(std::is_void<U>::value || std::is_nothrow_constructible<T, U>::value)
+    {
+      using type = basic_result<T, std::error_code, NoValuePolicy>;
+      if(v.has_value())
+      {
+        return detail::make_type<type, T>::value(static_cast<X &&>(v));
+      }
+      return type{in_place_type<std::error_code>, experimental::to_error_code(v.assume_error())};
+    }
+  };
+  /*! Explicitly converts a `basic_result` with a `std::error_code` error into one with a `system_code`
+  error, using `experimental::to_status_code()`. This enables the explicit converting constructor.
+  */
+  template <class T, class NoValuePolicy, class U, class NoValuePolicy2> struct value_or_error<basic_result<T, SYSTEM_ERROR2_NAMESPACE::system_code, NoValuePolicy>, basic_result<U, std::error_code, NoValuePolicy2>>
+  {
+    static constexpr bool enable_result_inputs = true;
+    static constexpr bool enable_outcome_inputs = false;
+    OUTCOME_TEMPLATE(class X)
+    OUTCOME_TREQUIRES(OUTCOME_TPRED(std::is_same<basic_result<U, std::error_code, NoValuePolicy2>, std::decay_t<X>>::value  //
+                                    && (std::is_void<U>::value || OUTCOME_V2_NAMESPACE::detail::is_explicitly_constructible<T, U>)))
+    basic_result<T, SYSTEM_ERROR2_NAMESPACE::system_code, NoValuePolicy> operator()(X &&v) noexcept(std::is_void<U>::value || std::is_nothrow_constructible<T, U>::value)
+    {
+      using type = basic_result<T, SYSTEM_ERROR2_NAMESPACE::system_code, NoValuePolicy>;
+      if(v.has_value())
+      {
+        return detail::make_type<type, T>::value(static_cast<X &&>(v));
+      }
+      return type{in_place_type<SYSTEM_ERROR2_NAMESPACE::system_code>, experimental::to_status_code(v.assume_error())};
+    }
+  };
+}  // namespace convert
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
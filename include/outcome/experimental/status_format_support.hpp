@@ -0,0 +1,90 @@
+/* std::format and fmt support for status codes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXPERIMENTAL_STATUS_FORMAT_SUPPORT_HPP
+#define OUTCOME_EXPERIMENTAL_STATUS_FORMAT_SUPPORT_HPP
+
+#include "../format_support.hpp"
+
+#include "status-code/include/system_error2.hpp"
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  // The message, preceded by the domain's name if verbose, both written straight from their string_refs
+  template <class DomainType> struct format_payload<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>>
+  {
+    template <class Backend, class Out> static Out write(Out out, const SYSTEM_ERROR2_NAMESPACE::status_code<DomainType> &sc, bool verbose)
+    {
+      if(sc.empty())
+      {
+        return format_write(out, "(empty)");
+      }
+      if(verbose)
+      {
+        const auto name = sc.domain().name();
+        out = format_write(out, name.data(), name.size());
+        out = format_write(out, ": ");
+      }
+      const auto msg = sc.message();
+      return format_write(out, msg.data(), msg.size());
+    }
+  };
+}  // namespace detail
+
+OUTCOME_V2_NAMESPACE_END
+
+#define OUTCOME_FORMAT_SUPPORT_STATUS_CODE_FORMATTER(NS, ERROR, BACKEND)                                                                                                                                                                                                                                                                                                        \
+  template <class DomainType> struct formatter<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>>                                                                                                                                                                                                                                                                                \
+  {                                                                                                                                                                                                                                                                                                                                                                             \
+    bool verbose{false};                                                                                                                                                                                                                                                                                                                                                        \
+    template <class ParseContext> constexpr auto parse(ParseContext &ctx)                                                                                                                                                                                                                                                                                                       \
+    {                                                                                                                                                                                                                                                                                                                                                                           \
+      OUTCOME_V2_NAMESPACE::detail::format_mode mode{OUTCOME_V2_NAMESPACE::detail::format_mode::normal};                                                                                                                                                                                                                                                                        \
+      auto it = ctx.begin();                                                                                                                                                                                                                                                                                                                                                    \
+      if(!OUTCOME_V2_NAMESPACE::detail::format_parse_mode(it, ctx.end(), mode) || mode == OUTCOME_V2_NAMESPACE::detail::format_mode::value_only)                                                                                                                                                                                                                                \
+        OUTCOME_THROW_EXCEPTION(NS::ERROR("invalid format spec for a status code, must be empty, e or #"));                                                                                                                                                                                                                                                                     \
+      verbose = (mode == OUTCOME_V2_NAMESPACE::detail::format_mode::verbose);                                                                                                                                                                                                                                                                                                   \
+      return it;                                                                                                                                                                                                                                                                                                                                                                \
+    }                                                                                                                                                                                                                                                                                                                                                                           \
+    template <class FormatContext> auto format(const SYSTEM_ERROR2_NAMESPACE::status_code<DomainType> &v, FormatContext &ctx) const                                                                                                                                                                                                                                             \
+    {                                                                                                                                                                                                                                                                                                                                                                           \
+      return OUTCOME_V2_NAMESPACE::detail::format_payload<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>>::template write<OUTCOME_V2_NAMESPACE::detail::BACKEND>(ctx.out(), v, verbose);                                                                                                                                                                                      \
+    }                                                                                                                                                                                                                                                                                                                                                                           \
+  };
+
+#if OUTCOME_HAVE_STD_FORMAT_SUPPORT
+namespace std
+{
+  OUTCOME_FORMAT_SUPPORT_STATUS_CODE_FORMATTER(std, format_error, format_backend_std)
+}  // namespace std
+#endif
+#if OUTCOME_HAVE_FMT_SUPPORT
+FMT_BEGIN_NAMESPACE
+OUTCOME_FORMAT_SUPPORT_STATUS_CODE_FORMATTER(fmt, format_error, format_backend_fmt)
+FMT_END_NAMESPACE
+#endif
+
+#endif
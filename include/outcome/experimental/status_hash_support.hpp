@@ -0,0 +1,152 @@
+/* std::hash support for status codes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXPERIMENTAL_STATUS_HASH_SUPPORT_HPP
+#define OUTCOME_EXPERIMENTAL_STATUS_HASH_SUPPORT_HPP
+
+#include "../hash_support.hpp"
+
+#include "status-code/include/system_error2.hpp"
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  template <class Domain, class = void> struct status_code_domain_has_do_hash : std::false_type
+  {
+  };
+  template <class Domain>
+  struct status_code_domain_has_do_hash<Domain, std::enable_if_t<std::is_convertible<decltype(std::declval<const Domain &>()._do_hash(std::declval<const typename Domain::value_type &>())), size_t>::value>> : std::true_type
+  {
+  };
+
+  /* Integral and enum values hash as the integer status code erasure would sign or zero extend them to,
+  so a code hashes the same as its type erased form. Other values use their std::hash, or else their bytes.
+  */
+  template <class T> using status_code_value_integer = std::conditional_t<std::is_enum<T>::value, std::underlying_type<T>, std::enable_if<true, T>>;
+  template <class T> constexpr inline uint64_t status_code_value_hash(const T &v, std::integral_constant<int, 0> /*integer*/) noexcept
+  {
+    using integer = typename status_code_value_integer<T>::type;
+    return static_cast<uint64_t>(static_cast<std::conditional_t<std::is_signed<integer>::value, int64_t, uint64_t>>(static_cast<integer>(v)));
+  }
+  template <class T> inline uint64_t status_code_value_hash(const T &v, std::integral_constant<int, 1> /*hashable*/) { return std::hash<T>()(v); }
+  template <class T> inline uint64_t status_code_value_hash(const T &v, std::integral_constant<int, 2> /*bytes*/) noexcept { return hash_bytes(0, &v, sizeof(T)); }
+  template <class T> using status_code_value_hash_kind = std::integral_constant<int, (std::is_integral<T>::value || std::is_enum<T>::value) ? 0 : is_std_hashable<T>::value ? 1 : 2>;
+
+  template <class Domain> inline uint64_t status_code_hash_value(const SYSTEM_ERROR2_NAMESPACE::status_code<Domain> &sc, std::true_type /*has _do_hash*/) { return sc.domain()._do_hash(sc.value()); }
+  template <class Domain> inline uint64_t status_code_hash_value(const SYSTEM_ERROR2_NAMESPACE::status_code<Domain> &sc, std::false_type /*has _do_hash*/)
+  {
+    using value_type = typename SYSTEM_ERROR2_NAMESPACE::status_code<Domain>::value_type;
+    return status_code_value_hash(sc.value(), status_code_value_hash_kind<value_type>());
+  }
+
+  template <class Domain, bool enabled> struct status_code_hash
+  {
+    size_t operator()(const SYSTEM_ERROR2_NAMESPACE::status_code<Domain> &sc) const noexcept(noexcept(status_code_hash_value(sc, status_code_domain_has_do_hash<Domain>())))
+    {
+      if(sc.empty())
+      {
+        return static_cast<size_t>(hash_mix(0));
+      }
+      return static_cast<size_t>(hash_combine(hash_mix(sc.domain().id()), status_code_hash_value(sc, status_code_domain_has_do_hash<Domain>())));
+    }
+  };
+  // Type erased codes which cannot be copied have no accessible value
+  template <class Domain> struct status_code_hash<Domain, false>
+  {
+    status_code_hash() = delete;
+    status_code_hash(const status_code_hash &) = delete;
+    status_code_hash &operator=(const status_code_hash &) = delete;
+  };
+  template <class Domain> using status_code_is_hashable = std::integral_constant<bool, (status_code_domain_has_do_hash<Domain>::value || status_code_value_hash_kind<typename Domain::value_type>::value != 2 || std::is_trivially_copyable<typename Domain::value_type>::value)>;
+  template <class Domain> struct status_code_is_hashable_impl : status_code_is_hashable<Domain>
+  {
+  };
+  template <> struct status_code_is_hashable_impl<void> : std::false_type
+  {
+  };
+
+  // Values of the same type compare by their operator==, integral and enum values as they hash, and others never match
+  template <class T> inline bool status_code_values_equal(const T &a, const T &b) { return a == b; }
+  template <class T, class U> constexpr inline bool status_code_values_equal(const T &a, const U &b, std::integral_constant<int, 0> /*integer*/, std::integral_constant<int, 0> /*integer*/) noexcept
+  {
+    return status_code_value_hash(a, std::integral_constant<int, 0>()) == status_code_value_hash(b, std::integral_constant<int, 0>());
+  }
+  template <class T, class U, class KindT, class KindU> constexpr inline bool status_code_values_equal(const T & /*unused*/, const U & /*unused*/, KindT /*unused*/, KindU /*unused*/) noexcept { return false; }
+  template <class T, class U> inline bool status_code_values_equal(const T &a, const U &b) { return status_code_values_equal(a, b, status_code_value_hash_kind<T>(), status_code_value_hash_kind<U>()); }
+}  // namespace detail
+
+namespace experimental
+{
+  /*! Exact equality of status codes, for keying containers with `std::hash` of status codes.
+  The `operator==` of status codes is semantic, so codes of different domains can compare equal
+  yet hash differently. This compares that their domains are the same and their values equal.
+  It is transparent, and a code equals its type erased form, so paired with `status_code_hash`
+  a container keyed by erased codes can be searched with typed ones.
+  */
+  struct status_code_equal_to
+  {
+    using is_transparent = void;
+    template <class DomainA, class DomainB> bool operator()(const SYSTEM_ERROR2_NAMESPACE::status_code<DomainA> &a, const SYSTEM_ERROR2_NAMESPACE::status_code<DomainB> &b) const noexcept
+    {
+      if(a.empty() || b.empty())
+      {
+        return a.empty() && b.empty();
+      }
+      return a.domain() == b.domain() && detail::status_code_values_equal(a.value(), b.value());
+    }
+  };
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+namespace std
+{
+  /*! Hashes the unique id of the domain of a status code, and then its value. If the domain has
+  a member function `_do_hash(const value_type &)` accessible to this, its result is the hash of
+  the value. Otherwise integral and enum values hash as their type erased form would, so a typed
+  code hashes the same as its erased form, and others hash by `std::hash`, or else by their bytes.
+  As `operator==` of status codes is semantic, key containers with `experimental::status_code_equal_to`.
+  */
+  template <class DomainType>
+  struct hash<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>> : OUTCOME_V2_NAMESPACE::detail::status_code_hash<DomainType, OUTCOME_V2_NAMESPACE::detail::status_code_is_hashable_impl<DomainType>::value>
+  {
+  };
+}  // namespace std
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace experimental
+{
+  //! A transparent hash of status codes, which hashes each as its `std::hash` does. See `status_code_equal_to`.
+  struct status_code_hash
+  {
+    using is_transparent = void;
+    template <class DomainType> size_t operator()(const SYSTEM_ERROR2_NAMESPACE::status_code<DomainType> &sc) const { return std::hash<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>>()(sc); }
+  };
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
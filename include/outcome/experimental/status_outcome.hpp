@@ -118,6 +118,7 @@ SIGNATURE NOT RECOGNISED
           }
           if(base::_has_error(static_cast<Impl &&>(self)))
           {
+            OUTCOME_SDT_FAILURE(status_code_throw, &base::_error(self));
 #ifdef __cpp_exceptions
             base::_error(static_cast<Impl &&>(self)).throw_exception();
 #else
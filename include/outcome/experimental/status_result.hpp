@@ -39,6 +39,17 @@ namespace detail
   template <class State> constexpr inline void _set_error_is_errno(State &state, const SYSTEM_ERROR2_NAMESPACE::posix_code & /*unused*/) { state._status |= status_error_is_errno; }
   template <class State> constexpr inline void _set_error_is_errno(State &state, const SYSTEM_ERROR2_NAMESPACE::errc & /*unused*/) { state._status |= status_error_is_errno; }
 
+  // The probes report the id of the domain of a status code, and its value if integral
+  template <class DomainType> struct sdt_error_info<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>>
+  {
+    using _value_type = typename SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>::value_type;
+    static uint64_t domain(const SYSTEM_ERROR2_NAMESPACE::status_code<DomainType> &v) noexcept { return v.empty() ? 0 : v.domain().id(); }
+    static int64_t value(const SYSTEM_ERROR2_NAMESPACE::status_code<DomainType> &v) noexcept { return v.empty() ? 0 : sdt_value(v.value(), sdt_is_integral<_value_type>()); }
+  };
+  template <class DomainType> struct sdt_error_info<SYSTEM_ERROR2_NAMESPACE::errored_status_code<DomainType>> : sdt_error_info<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>>
+  {
+  };
+
 }  // namespace detail
 
 namespace experimental
@@ -63,6 +74,7 @@ namespace experimental
         {
           if(base::_has_error(static_cast<Impl &&>(self)))
           {
+            OUTCOME_SDT_FAILURE(status_code_throw, &base::_error(self));
 #ifdef __cpp_exceptions
             base::_error(static_cast<Impl &&>(self)).throw_exception();
 #else
@@ -0,0 +1,223 @@
+/* Batches of status results laid out for the C batch API
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXPERIMENTAL_STATUS_RESULT_BATCH_HPP
+#define OUTCOME_EXPERIMENTAL_STATUS_RESULT_BATCH_HPP
+
+#include "status_result.hpp"
+
+#include "result.h"
+
+#include <cstring>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace experimental
+{
+  static_assert(sizeof(system_code) == sizeof(cxx_status_code_system) && alignof(system_code) == alignof(cxx_status_code_system), "system_code does not have the layout of cxx_status_code_system");
+
+  /*! The C++ declaration of `CXX_RESULT_BATCH_SYSTEM(ident)` for `T`, which is how a batch of results
+  is handed to C. It refers to the storage of a `status_result_batch<T>`.
+  */
+  template <class T> struct status_result_batch_view
+  {
+    T *values;
+    const uint64_t *success;
+    system_code *errors;
+    const uint64_t *errors_are_errno;
+    size_t count;
+    size_t error_count;
+  };
+
+  /*! A batch of `status_result<T>`, stored as the C batch API expects: a contiguous array of
+  `count()` values, a bitmap with a bit set for each result which succeeded, and a compact
+  array of just the errors of those which failed, in order. `T` must be trivially copyable,
+  which C compatible types are, and the values of failed results are zero.
+
+  C++ functions returning many results to C should fill one of these directly with
+  `push_back()`, and hand out its `view()`, which remains valid until the batch is next modified.
+  */
+  template <class T> class status_result_batch
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "status_result_batch requires a trivially copyable value type");
+
+    std::vector<T> _values;
+    std::vector<uint64_t> _success, _errors_are_errno;
+    std::vector<system_code> _errors;
+
+    static void _set_bit(std::vector<uint64_t> &bitmap, size_t idx, bool v)
+    {
+      if(idx % 64 == 0)
+      {
+        bitmap.push_back(0);
+      }
+      bitmap.back() |= static_cast<uint64_t>(v) << (idx % 64);
+    }
+    void _push_back_error(system_code &&e)
+    {
+      _set_bit(_success, _values.size(), false);
+      _values.emplace_back();
+      // An empty code has no domain, and is not an errno
+      _set_bit(_errors_are_errno, _errors.size(), !e.empty() && (e.domain() == generic_code_domain || e.domain() == posix_code_domain));
+      _errors.push_back(static_cast<system_code &&>(e));
+    }
+
+  public:
+    using value_type = T;
+    using result_type = status_result<T>;
+
+    status_result_batch() = default;
+    //! Reserves storage for `count` results, of which `errors` might fail.
+    explicit status_result_batch(size_t count, size_t errors = 0)
+    {
+      reserve(count, errors);
+    }
+    //! Moves the results in `results` into a batch, copying each value once, bitwise.
+    explicit status_result_batch(std::vector<result_type> &&results)
+    {
+      size_t errors = 0;
+      for(const auto &r : results)
+      {
+        errors += static_cast<size_t>(r.has_error());
+      }
+      reserve(results.size(), errors);
+      for(auto &r : results)
+      {
+        push_back(static_cast<result_type &&>(r));
+      }
+      results.clear();
+    }
+
+    //! Reserves storage for `count` results, of which `errors` might fail.
+    void reserve(size_t count, size_t errors = 0)
+    {
+      _values.reserve(count);
+      _success.reserve((count + 63) / 64);
+      _errors.reserve(errors);
+      _errors_are_errno.reserve((errors + 63) / 64);
+    }
+    //! Removes all results.
+    void clear() noexcept
+    {
+      _values.clear();
+      _success.clear();
+      _errors.clear();
+      _errors_are_errno.clear();
+    }
+
+    //! The number of results.
+    size_t count() const noexcept { return _values.size(); }
+    //! The number of failed results.
+    size_t error_count() const noexcept { return _errors.size(); }
+    //! True if the result at `idx` succeeded.
+    bool has_value(size_t idx) const noexcept { return ((_success[idx / 64] >> (idx % 64)) & 1) != 0; }
+    //! The values, zero where the result failed.
+    const T *values() const noexcept { return _values.data(); }
+    //! The errors of the failed results, in order.
+    const system_code *errors() const noexcept { return _errors.data(); }
+
+    //! Appends a successful result.
+    void push_back(const T &v)
+    {
+      _set_bit(_success, _values.size(), true);
+      _values.push_back(v);
+    }
+    //! Appends a failed result.
+    void push_back(system_code &&e) { _push_back_error(static_cast<system_code &&>(e)); }
+    //! Appends a failed result.
+    template <class DomainType> void push_back(status_code<DomainType> &&e) { _push_back_error(system_code(static_cast<status_code<DomainType> &&>(e))); }
+    //! Appends the result `r`, whose error is moved from if it failed.
+    void push_back(result_type &&r)
+    {
+      if(r.has_value())
+      {
+        push_back(r.assume_value());
+      }
+      else
+      {
+        _push_back_error(static_cast<system_code &&>(r.assume_error()));
+      }
+    }
+
+    //! The batch, as `CXX_RESULT_BATCH_SYSTEM(ident)` for `T` lays it out for C.
+    status_result_batch_view<T> view() noexcept { return {_values.data(), _success.data(), _errors.data(), _errors_are_errno.data(), _values.size(), _errors.size()}; }
+    //! Copies the view into the C declared batch type `CBatch`, such as `CXX_RESULT_BATCH_SYSTEM(ident)`.
+    template <class CBatch> CBatch c_view() noexcept
+    {
+      static_assert(sizeof(CBatch) == sizeof(status_result_batch_view<T>), "C batch type does not match the layout of status_result_batch_view");
+      const auto v = view();
+      CBatch ret;
+      memcpy(&ret, &v, sizeof(ret));
+      return ret;
+    }
+
+    //! Moves the results out of the batch, which is left empty.
+    std::vector<result_type> release()
+    {
+      std::vector<result_type> ret;
+      ret.reserve(_values.size());
+      size_t erroridx = 0;
+      for(size_t idx = 0; idx < _values.size(); idx++)
+      {
+        if(has_value(idx))
+        {
+          ret.emplace_back(in_place_type<T>, _values[idx]);
+        }
+        else
+        {
+          ret.emplace_back(in_place_type<system_code>, static_cast<system_code &&>(_errors[erroridx++]));
+        }
+      }
+      clear();
+      return ret;
+    }
+  };
+
+  /*! Moves the results in the C batch view `v`, whose errors are left empty, into a vector of
+  results. Each value is copied once, bitwise.
+  */
+  template <class T> inline std::vector<status_result<T>> to_status_results(status_result_batch_view<T> v)
+  {
+    std::vector<status_result<T>> ret;
+    ret.reserve(v.count);
+    size_t erroridx = 0;
+    for(size_t idx = 0; idx < v.count; idx++)
+    {
+      if(((v.success[idx / 64] >> (idx % 64)) & 1) != 0)
+      {
+        ret.emplace_back(in_place_type<T>, v.values[idx]);
+      }
+      else
+      {
+        ret.emplace_back(in_place_type<system_code>, static_cast<system_code &&>(v.errors[erroridx++]));
+      }
+    }
+    return ret;
+  }
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,604 @@
+/* Streaming JSON and CBOR encoding of results, outcomes and status codes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_EXPERIMENTAL_STRUCTURED_SUPPORT_HPP
+#define OUTCOME_EXPERIMENTAL_STRUCTURED_SUPPORT_HPP
+
+#include "../outcome.hpp"
+
+#include "status-code/include/system_error2.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace experimental
+{
+  /*! How a value of type `T` is written by `json_encode()` and `cbor_encode()`. Specialise this
+  with a `template <class Writer> static void write(Writer &w, const T &v)` for your own types,
+  calling upon `w.null()`, `w.boolean()`, `w.integer()`, `w.uinteger()`, `w.floating()`,
+  `w.string()`, and `w.begin_map(entries)`, `w.key()` and `w.end_map()`.
+
+  Null, booleans, arithmetic and enum types, contiguous character strings, `status_code`s,
+  `std::error_code`s and `std::exception_ptr`s are supported out of the box.
+  */
+  template <class T, class Enable = void> struct structured_value
+  {
+    static_assert(!std::is_same<T, T>::value, "structured_value<T> must be specialised to encode this type");
+  };
+
+  //! Writes JSON into the output iterator `Out` of `char`.
+  template <class Out> class json_writer
+  {
+    Out _out;
+    // Whether a comma is needed before the next entry
+    bool _comma{false};
+
+    void _put(char c) { *_out++ = c; }
+    void _put(const char *s, size_t len)
+    {
+      for(size_t n = 0; n < len; n++)
+      {
+        *_out++ = s[n];
+      }
+    }
+    void _separate()
+    {
+      if(_comma)
+      {
+        _put(',');
+      }
+      _comma = true;
+    }
+
+  public:
+    explicit json_writer(Out out)
+        : _out(out)
+    {
+    }
+    Out out() const { return _out; }
+
+    void null()
+    {
+      _separate();
+      _put("null", 4);
+    }
+    void boolean(bool v)
+    {
+      _separate();
+      v ? _put("true", 4) : _put("false", 5);
+    }
+    void integer(int64_t v)
+    {
+      char buffer[24];
+      _separate();
+      _put(buffer, static_cast<size_t>(snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(v))));
+    }
+    void uinteger(uint64_t v)
+    {
+      char buffer[24];
+      _separate();
+      _put(buffer, static_cast<size_t>(snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(v))));
+    }
+    void floating(double v)
+    {
+      if(v != v || v == std::numeric_limits<double>::infinity() || v == -std::numeric_limits<double>::infinity())
+      {
+        null();  // JSON has no representation of these
+        return;
+      }
+      char buffer[32];
+      _separate();
+      _put(buffer, static_cast<size_t>(snprintf(buffer, sizeof(buffer), "%.17g", v)));
+    }
+    void string(const char *s, size_t len)
+    {
+      static constexpr char hex[] = "0123456789abcdef";
+      _separate();
+      _put('"');
+      for(size_t n = 0; n < len; n++)
+      {
+        const auto c = static_cast<unsigned char>(s[n]);
+        if(c == '"' || c == '\\')
+        {
+          _put('\\');
+          _put(static_cast<char>(c));
+        }
+        else if(c < 0x20)
+        {
+          const char esc[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 15]};
+          _put(esc, 6);
+        }
+        else
+        {
+          _put(static_cast<char>(c));
+        }
+      }
+      _put('"');
+    }
+    void begin_map(size_t /*unused*/)
+    {
+      _separate();
+      _put('{');
+      _comma = false;
+    }
+    void key(const char *k)
+    {
+      string(k, strlen(k));
+      _put(':');
+      _comma = false;
+    }
+    void end_map()
+    {
+      _put('}');
+      _comma = true;
+    }
+    // Ends a record, so records form a stream of JSON lines
+    void end_record()
+    {
+      _put('\n');
+      _comma = false;
+    }
+  };
+
+  //! Writes CBOR (RFC 7049) into the output iterator `Out` of `char`.
+  template <class Out> class cbor_writer
+  {
+    Out _out;
+
+    void _put(unsigned char c) { *_out++ = static_cast<char>(c); }
+    void _head(unsigned major, uint64_t v)
+    {
+      major <<= 5;
+      if(v < 24)
+      {
+        _put(static_cast<unsigned char>(major | v));
+        return;
+      }
+      unsigned bytes = 8, info = 27;
+      if(v <= 0xff)
+      {
+        bytes = 1;
+        info = 24;
+      }
+      else if(v <= 0xffff)
+      {
+        bytes = 2;
+        info = 25;
+      }
+      else if(v <= 0xffffffff)
+      {
+        bytes = 4;
+        info = 26;
+      }
+      _put(static_cast<unsigned char>(major | info));
+      for(unsigned n = bytes; n > 0; n--)
+      {
+        _put(static_cast<unsigned char>(v >> ((n - 1) * 8)));
+      }
+    }
+
+  public:
+    explicit cbor_writer(Out out)
+        : _out(out)
+    {
+    }
+    Out out() const { return _out; }
+
+    void null() { _put(0xf6); }
+    void boolean(bool v) { _put(v ? 0xf5 : 0xf4); }
+    void integer(int64_t v) { (v < 0) ? _head(1, static_cast<uint64_t>(-(v + 1))) : _head(0, static_cast<uint64_t>(v)); }
+    void uinteger(uint64_t v) { _head(0, v); }
+    void floating(double v)
+    {
+      uint64_t bits;
+      memcpy(&bits, &v, sizeof(bits));
+      _put(0xfb);
+      for(unsigned n = 8; n > 0; n--)
+      {
+        _put(static_cast<unsigned char>(bits >> ((n - 1) * 8)));
+      }
+    }
+    void string(const char *s, size_t len)
+    {
+      _head(3, len);
+      for(size_t n = 0; n < len; n++)
+      {
+        *_out++ = s[n];
+      }
+    }
+    void begin_map(size_t entries) { _head(5, entries); }
+    void key(const char *k) { string(k, strlen(k)); }
+    void end_map() {}
+    void end_record() {}
+  };
+
+  namespace detail
+  {
+    template <class T> struct structured_is_string
+    {
+      template <class U> static auto test(const U *u) -> decltype(static_cast<const char *>(u->data()), static_cast<size_t>(u->size()), std::true_type());
+      static std::false_type test(...);
+      static constexpr bool value = decltype(test(static_cast<const T *>(nullptr)))::value;
+    };
+    template <class SC> struct structured_has_integral_value
+    {
+      template <class U> static auto test(const U *u) -> std::integral_constant<bool, std::is_integral<std::decay_t<decltype(u->value())>>::value || std::is_enum<std::decay_t<decltype(u->value())>>::value>;
+      static std::false_type test(...);
+      static constexpr bool value = decltype(test(static_cast<const SC *>(nullptr)))::value;
+    };
+    template <class Writer, class SC> inline void structured_code_value(Writer &w, const SC &sc, std::true_type /*unused*/)
+    {
+      w.key("value");
+      w.integer(static_cast<int64_t>(sc.value()));
+    }
+    template <class Writer, class SC> inline void structured_code_value(Writer & /*unused*/, const SC & /*unused*/, std::false_type /*unused*/) {}
+
+    template <class Writer, class Result> inline void structured_value_of(Writer &w, const Result &v, std::false_type /*void*/) { structured_value<typename Result::value_type>::write(w, v.assume_value()); }
+    template <class Writer, class Result> inline void structured_value_of(Writer &w, const Result & /*unused*/, std::true_type /*void*/) { w.null(); }
+    template <class Writer, class Result> inline void structured_error_of(Writer &w, const Result &v, std::false_type /*void*/) { structured_value<typename Result::error_type>::write(w, v.assume_error()); }
+    template <class Writer, class Result> inline void structured_error_of(Writer &w, const Result & /*unused*/, std::true_type /*void*/) { w.null(); }
+
+    // { "value": v } or { "error": e }, and for outcomes also "exception"
+    template <class Writer, class Result> inline void structured_result(Writer &w, const Result &v, bool has_exception)
+    {
+      w.begin_map(static_cast<size_t>(v.has_value()) + static_cast<size_t>(v.has_error()) + static_cast<size_t>(has_exception));
+      if(v.has_value())
+      {
+        w.key("value");
+        structured_value_of(w, v, std::is_void<typename Result::value_type>());
+      }
+      if(v.has_error())
+      {
+        w.key("error");
+        structured_error_of(w, v, std::is_void<typename Result::error_type>());
+      }
+    }
+    template <class Writer, class R, class S, class P> inline void structured_write(Writer &w, const basic_result<R, S, P> &v)
+    {
+      structured_result(w, v, false);
+      w.end_map();
+    }
+    template <class Writer, class R, class S, class P, class N> inline void structured_write(Writer &w, const basic_outcome<R, S, P, N> &v)
+    {
+      structured_result(w, v, v.has_exception());
+      if(v.has_exception())
+      {
+        w.key("exception");
+        structured_value<P>::write(w, v.assume_exception());
+      }
+      w.end_map();
+    }
+    template <class Writer, class T> inline void structured_write(Writer &w, const T &v) { structured_value<T>::write(w, v); }
+  }  // namespace detail
+
+  template <> struct structured_value<bool>
+  {
+    template <class Writer> static void write(Writer &w, bool v) { w.boolean(v); }
+  };
+  template <class T> struct structured_value<T, std::enable_if_t<(std::is_integral<T>::value && !std::is_same<T, bool>::value) || std::is_enum<T>::value>>
+  {
+    template <class Writer> static void write(Writer &w, T v) { std::is_signed<T>::value || std::is_enum<T>::value ? w.integer(static_cast<int64_t>(v)) : w.uinteger(static_cast<uint64_t>(v)); }
+  };
+  template <class T> struct structured_value<T, std::enable_if_t<std::is_floating_point<T>::value>>
+  {
+    template <class Writer> static void write(Writer &w, T v) { w.floating(static_cast<double>(v)); }
+  };
+  template <class T> struct structured_value<T, std::enable_if_t<detail::structured_is_string<T>::value>>
+  {
+    template <class Writer> static void write(Writer &w, const T &v) { w.string(v.data(), v.size()); }
+  };
+  /*! Status codes are written as a map of the domain's `name()`, its unique `id` (as a hexadecimal
+  string in JSON, which cannot represent all 64 bit integers), the code's value if that is integral,
+  and the code's `message()`. Names and messages are written straight from their `string_ref`s.
+  */
+  template <class DomainType> struct structured_value<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>>
+  {
+    using status_code_type = SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>;
+    template <class Out> static void _id(json_writer<Out> &w, unsigned long long id)
+    {
+      char buffer[24];
+      w.string(buffer, static_cast<size_t>(snprintf(buffer, sizeof(buffer), "0x%016llx", id)));
+    }
+    template <class Out> static void _id(cbor_writer<Out> &w, unsigned long long id) { w.uinteger(id); }
+    template <class Writer> static void write(Writer &w, const status_code_type &sc)
+    {
+      if(sc.empty())
+      {
+        w.null();
+        return;
+      }
+      constexpr bool has_value = detail::structured_has_integral_value<status_code_type>::value;
+      w.begin_map(3 + static_cast<size_t>(has_value));
+      const auto name = sc.domain().name();
+      w.key("domain");
+      w.string(name.data(), name.size());
+      w.key("id");
+      _id(w, sc.domain().id());
+      detail::structured_code_value(w, sc, std::integral_constant<bool, has_value>());
+      const auto msg = sc.message();
+      w.key("message");
+      w.string(msg.data(), msg.size());
+      w.end_map();
+    }
+  };
+  //! Error codes are written as a map of the category's name, the value and the (allocated) message.
+  template <> struct structured_value<std::error_code>
+  {
+    template <class Writer> static void write(Writer &w, const std::error_code &ec)
+    {
+      w.begin_map(3);
+      w.key("category");
+      const char *name = ec.category().name();
+      w.string(name, strlen(name));
+      w.key("value");
+      w.integer(ec.value());
+      w.key("message");
+      const std::string msg(ec.message());
+      w.string(msg.data(), msg.size());
+      w.end_map();
+    }
+  };
+  //! Exceptions are written as their `what()`.
+  template <> struct structured_value<std::exception_ptr>
+  {
+    template <class Writer> static void write(Writer &w, const std::exception_ptr &e)
+    {
+#ifdef __cpp_exceptions
+      try
+      {
+        rethrow_exception(e);
+      }
+      catch(const std::exception &ex)
+      {
+        w.string(ex.what(), strlen(ex.what()));
+        return;
+      }
+      catch(...)
+#endif
+      {
+        (void) e;
+        w.string("unknown exception", 17);
+      }
+    }
+  };
+
+  /*! Writes `v`, a `basic_result`, `basic_outcome`, `status_code` or any other type with a
+  `structured_value`, as a line of JSON into the output iterator `out`. Nothing is allocated
+  unless `out`, or some `std::error_code`'s `message()`, allocates.
+  \returns The output iterator after the last character written.
+  */
+  template <class Out, class T> inline Out json_encode(Out out, const T &v)
+  {
+    json_writer<Out> w(out);
+    detail::structured_write(w, v);
+    w.end_record();
+    return w.out();
+  }
+  /*! Writes `v`, as for `json_encode()`, as a CBOR data item into the output iterator `out`.
+  Consecutive items form a CBOR sequence (RFC 8742).
+  */
+  template <class Out, class T> inline Out cbor_encode(Out out, const T &v)
+  {
+    cbor_writer<Out> w(out);
+    detail::structured_write(w, v);
+    return w.out();
+  }
+
+  namespace detail
+  {
+    class cbor_reader
+    {
+      const unsigned char *_p, *_end;
+
+    public:
+      cbor_reader(const char *p, size_t len)
+          : _p(reinterpret_cast<const unsigned char *>(p))  // NOLINT
+          , _end(_p + len)
+      {
+      }
+      const char *pos() const noexcept { return reinterpret_cast<const char *>(_p); }  // NOLINT
+      bool head(unsigned &major, uint64_t &v) noexcept
+      {
+        if(_p == _end)
+        {
+          return false;
+        }
+        major = *_p >> 5;
+        const unsigned info = *_p++ & 31;
+        if(info < 24)
+        {
+          v = info;
+          return true;
+        }
+        if(info > 27)
+        {
+          return false;  // indefinite lengths are never written
+        }
+        const unsigned bytes = 1U << (info - 24);
+        if(static_cast<size_t>(_end - _p) < bytes)
+        {
+          return false;
+        }
+        v = 0;
+        for(unsigned n = 0; n < bytes; n++)
+        {
+          v = (v << 8) | *_p++;
+        }
+        return true;
+      }
+      bool text(const char *&s, size_t &len) noexcept
+      {
+        unsigned major;
+        uint64_t v;
+        if(!head(major, v) || major != 3 || v > static_cast<uint64_t>(_end - _p))
+        {
+          return false;
+        }
+        s = reinterpret_cast<const char *>(_p);  // NOLINT
+        len = static_cast<size_t>(v);
+        _p += len;
+        return true;
+      }
+      bool skip(unsigned depth = 0) noexcept
+      {
+        unsigned major;
+        uint64_t v;
+        if(depth > 16 || !head(major, v))
+        {
+          return false;
+        }
+        switch(major)
+        {
+        case 2:
+        case 3:
+          if(v > static_cast<uint64_t>(_end - _p))
+          {
+            return false;
+          }
+          _p += v;
+          return true;
+        case 4:
+        case 5:
+          for(uint64_t n = 0; n < v * (major - 3); n++)
+          {
+            if(!skip(depth + 1))
+            {
+              return false;
+            }
+          }
+          return true;
+        case 6:
+          return skip(depth + 1);
+        default:
+          return true;
+        }
+      }
+    };
+
+    inline bool cbor_key_is(const char *s, size_t len, const char *k) noexcept { return len == strlen(k) && memcmp(s, k, len) == 0; }
+
+    inline bool cbor_decode_code(cbor_reader &r, SYSTEM_ERROR2_NAMESPACE::system_code &out, unsigned depth)
+    {
+      unsigned major;
+      uint64_t entries;
+      if(depth > 1 || !r.head(major, entries) || major != 5)
+      {
+        return false;
+      }
+      uint64_t id = 0;
+      int64_t value = 0;
+      bool have_id = false, have_value = false, have_code = false;
+      for(uint64_t n = 0; n < entries; n++)
+      {
+        const char *k;
+        size_t klen;
+        if(!r.text(k, klen))
+        {
+          return false;
+        }
+        if(cbor_key_is(k, klen, "error"))
+        {
+          if(!cbor_decode_code(r, out, depth + 1))
+          {
+            return false;
+          }
+          have_code = true;
+        }
+        else if(cbor_key_is(k, klen, "id"))
+        {
+          if(!r.head(major, id) || major != 0)
+          {
+            return false;
+          }
+          have_id = true;
+        }
+        else if(cbor_key_is(k, klen, "value"))
+        {
+          uint64_t v;
+          if(!r.head(major, v) || (major != 0 && major != 1) || v > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+          {
+            return false;
+          }
+          value = (major == 0) ? static_cast<int64_t>(v) : -1 - static_cast<int64_t>(v);
+          have_value = true;
+        }
+        else if(!r.skip())
+        {
+          return false;
+        }
+      }
+      if(have_code)
+      {
+        return true;
+      }
+      if(!have_id || !have_value)
+      {
+        return false;
+      }
+      if(id == SYSTEM_ERROR2_NAMESPACE::generic_code_domain.id())
+      {
+        out = SYSTEM_ERROR2_NAMESPACE::generic_code(static_cast<SYSTEM_ERROR2_NAMESPACE::errc>(value));
+        return true;
+      }
+      if(id == SYSTEM_ERROR2_NAMESPACE::posix_code_domain.id())
+      {
+        out = SYSTEM_ERROR2_NAMESPACE::posix_code(static_cast<int>(value));
+        return true;
+      }
+#ifdef _WIN32
+      if(id == SYSTEM_ERROR2_NAMESPACE::win32_code_domain.id())
+      {
+        out = SYSTEM_ERROR2_NAMESPACE::win32_code(static_cast<SYSTEM_ERROR2_NAMESPACE::win32::DWORD>(value));
+        return true;
+      }
+      if(id == SYSTEM_ERROR2_NAMESPACE::nt_code_domain.id())
+      {
+        out = SYSTEM_ERROR2_NAMESPACE::nt_code(static_cast<SYSTEM_ERROR2_NAMESPACE::win32::NTSTATUS>(value));
+        return true;
+      }
+#endif
+      return false;  // not a domain which system_code can be rebuilt from
+    }
+  }  // namespace detail
+
+  /*! Decodes the CBOR data item at `buffer` written by `cbor_encode()` of a status code, or of a
+  failed `basic_result` or `basic_outcome` of one, into `out`. The code's domain is identified by
+  its unique id, so only domains known to this function, those of the platform's `system_code`,
+  can be decoded.
+  \returns The number of bytes decoded, or zero if the item could not be decoded.
+  */
+  inline size_t cbor_decode(SYSTEM_ERROR2_NAMESPACE::system_code &out, const char *buffer, size_t length)
+  {
+    detail::cbor_reader r(buffer, length);
+    return detail::cbor_decode_code(r, out, 0) ? static_cast<size_t>(r.pos() - buffer) : 0;
+  }
+}  // namespace experimental
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,319 @@
+/* std::format and fmt support for results and outcomes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_FORMAT_SUPPORT_HPP
+#define OUTCOME_FORMAT_SUPPORT_HPP
+
+#include "outcome.hpp"
+
+#include <cstring>
+#include <string.h>  // for strerror_r
+
+#if defined(__has_include)
+#if(__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)) && __has_include(<format>)
+#include <format>
+#endif
+#if !defined(OUTCOME_DISABLE_FMT_SUPPORT) && __has_include(<fmt/format.h>)
+#include <fmt/format.h>
+#endif
+#endif
+
+#if defined(__cpp_lib_format) && !defined(OUTCOME_HAVE_STD_FORMAT_SUPPORT)
+#define OUTCOME_HAVE_STD_FORMAT_SUPPORT 1
+#endif
+#if defined(FMT_VERSION) && !defined(OUTCOME_HAVE_FMT_SUPPORT)
+#define OUTCOME_HAVE_FMT_SUPPORT 1
+#endif
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  /* The format spec of a result or outcome: `{}` is the value, else the error,
+  else the exception, `{:v}` only ever the value, `{:e}` only ever the error
+  or exception, and `{:#}` the same text as `print()`.
+  */
+  enum class format_mode
+  {
+    normal,
+    value_only,
+    error_only,
+    verbose
+  };
+
+  // Advances `it` to the end of the spec, returning false if it is invalid
+  template <class It> constexpr inline bool format_parse_mode(It &it, It end, format_mode &mode) noexcept
+  {
+    mode = format_mode::normal;
+    if(it != end && *it != '}')
+    {
+      switch(*it)
+      {
+      case 'v':
+        mode = format_mode::value_only;
+        break;
+      case 'e':
+        mode = format_mode::error_only;
+        break;
+      case '#':
+        mode = format_mode::verbose;
+        break;
+      default:
+        return false;
+      }
+      ++it;
+    }
+    return it == end || *it == '}';
+  }
+
+  template <class Out> inline Out format_write(Out out, const char *s, size_t len)
+  {
+    for(size_t n = 0; n < len; n++)
+    {
+      *out++ = s[n];
+    }
+    return out;
+  }
+  template <class Out> inline Out format_write(Out out, const char *s) { return format_write(out, s, strlen(s)); }
+
+  // Adapts to whichever of the GNU or XSI strerror_r() we have
+  inline const char *format_strerror_result(const char *ret, const char * /*unused*/) noexcept { return ret; }
+  inline const char *format_strerror_result(int ret, const char *buffer) noexcept { return (ret == 0) ? buffer : "unknown error"; }
+
+  /* How each value, error or exception is written. Types without a
+  specialisation are written with the formatter of the backend in use, so
+  `Backend::format(out, v)` is `std::format_to(out, "{}", v)` or similar.
+  */
+  template <class T, class Enable = void> struct format_payload
+  {
+    template <class Backend, class Out> static Out write(Out out, const T &v, bool /*unused*/) { return Backend::format(out, v); }
+  };
+  // As per operator<<, then with the message if verbose, which avoids allocation for errno codes
+  template <> struct format_payload<std::error_code>
+  {
+    template <class Backend, class Out> static Out write(Out out, const std::error_code &ec, bool verbose)
+    {
+      out = format_write(out, ec.category().name());
+      *out++ = ':';
+      out = Backend::format(out, ec.value());
+      if(verbose)
+      {
+        out = format_write(out, " (");
+#ifdef _WIN32
+        const bool is_errno = (ec.category() == std::generic_category());
+#else
+        const bool is_errno = (ec.category() == std::generic_category() || ec.category() == std::system_category());
+#endif
+        if(is_errno)
+        {
+          char buffer[256] = "";
+#ifdef _WIN32
+          strerror_s(buffer, sizeof(buffer), ec.value());
+          out = format_write(out, buffer);
+#else
+          out = format_write(out, format_strerror_result(strerror_r(ec.value(), buffer, sizeof(buffer)), buffer));
+#endif
+        }
+        else
+        {
+          const std::string msg(ec.message());
+          out = format_write(out, msg.data(), msg.size());
+        }
+        *out++ = ')';
+      }
+      return out;
+    }
+  };
+  // As per print()
+  template <> struct format_payload<std::exception_ptr>
+  {
+    template <class Backend, class Out> static Out write(Out out, const std::exception_ptr &e, bool /*unused*/)
+    {
+#ifdef __cpp_exceptions
+      try
+      {
+        rethrow_exception(e);
+      }
+      catch(const std::system_error &ex)
+      {
+        out = format_write(out, "std::system_error code ");
+        out = format_payload<std::error_code>::write<Backend>(out, ex.code(), false);
+        out = format_write(out, ": ");
+        return format_write(out, ex.what());
+      }
+      catch(const std::exception &ex)
+      {
+        out = format_write(out, "std::exception: ");
+        return format_write(out, ex.what());
+      }
+      catch(...)
+#endif
+      {
+        (void) e;
+        return format_write(out, "unknown exception");
+      }
+    }
+  };
+
+  template <class Backend, class Out, class Result> inline Out format_value(Out out, const Result &v, std::false_type /*void*/) { return format_payload<typename Result::value_type>::template write<Backend>(out, v.assume_value(), false); }
+  template <class Backend, class Out, class Result> inline Out format_value(Out out, const Result & /*unused*/, std::true_type /*void*/) { return format_write(out, "(+void)"); }
+  template <class Backend, class Out, class Result> inline Out format_error(Out out, const Result &v, bool verbose, std::false_type /*void*/) { return format_payload<typename Result::error_type>::template write<Backend>(out, v.assume_error(), verbose); }
+  template <class Backend, class Out, class Result> inline Out format_error(Out out, const Result & /*unused*/, bool /*unused*/, std::true_type /*void*/) { return format_write(out, "(-void)"); }
+
+  template <class Backend, class Out, class Result> inline Out format_result(Out out, const Result &v, format_mode mode)
+  {
+    if(v.has_value() && mode != format_mode::error_only)
+    {
+      out = format_value<Backend>(out, v, std::is_void<typename Result::value_type>());
+    }
+    if(v.has_error() && mode != format_mode::value_only)
+    {
+      out = format_error<Backend>(out, v, mode == format_mode::verbose, std::is_void<typename Result::error_type>());
+    }
+    return out;
+  }
+  template <class Backend, class Out, class Outcome> inline Out format_outcome(Out out, const Outcome &v, format_mode mode)
+  {
+    const bool both = mode == format_mode::verbose && v.has_error() && v.has_exception();
+    if(both)
+    {
+      out = format_write(out, "{ ");
+    }
+    out = format_result<Backend>(out, v, mode);
+    if(both)
+    {
+      out = format_write(out, ", ");
+    }
+    // Exceptions are only written in normal mode if there is nothing else
+    if(v.has_exception() && mode != format_mode::value_only && (mode != format_mode::normal || !v.has_error()))
+    {
+      out = format_payload<typename Outcome::exception_type>::template write<Backend>(out, v.assume_exception(), mode == format_mode::verbose);
+    }
+    if(both)
+    {
+      out = format_write(out, " }");
+    }
+    return out;
+  }
+
+#if OUTCOME_HAVE_STD_FORMAT_SUPPORT
+  struct format_backend_std
+  {
+    template <class Out, class T> static Out format(Out out, const T &v) { return std::format_to(out, "{}", v); }
+  };
+#endif
+#if OUTCOME_HAVE_FMT_SUPPORT
+  struct format_backend_fmt
+  {
+    template <class Out, class T> static Out format(Out out, const T &v) { return fmt::format_to(out, "{}", v); }
+  };
+#endif
+}  // namespace detail
+
+/*! Formats a `std::error_code` as the error of a result would be, so `{}` is `category:value` and
+`{:#}` adds the message. Specialising `std::formatter` for `std::error_code` is not permitted, so
+error codes outside a result are formatted through this wrapper, which must not outlive the code.
+*/
+class formattable_error_code
+{
+  const std::error_code &_ec;
+
+public:
+  explicit formattable_error_code(const std::error_code &ec) noexcept
+      : _ec(ec)
+  {
+  }
+  //! The wrapped error code.
+  const std::error_code &code() const noexcept { return _ec; }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#define OUTCOME_FORMAT_SUPPORT_FORMATTERS(NS, ERROR, BACKEND)                                                                                                                                                                                                                                                                                                                   \
+  template <class R, class S, class P> struct formatter<OUTCOME_V2_NAMESPACE::basic_result<R, S, P>>                                                                                                                                                                                                                                                                            \
+  {                                                                                                                                                                                                                                                                                                                                                                             \
+    OUTCOME_V2_NAMESPACE::detail::format_mode mode{OUTCOME_V2_NAMESPACE::detail::format_mode::normal};                                                                                                                                                                                                                                                                          \
+    template <class ParseContext> constexpr auto parse(ParseContext &ctx)                                                                                                                                                                                                                                                                                                       \
+    {                                                                                                                                                                                                                                                                                                                                                                           \
+      auto it = ctx.begin();                                                                                                                                                                                                                                                                                                                                                    \
+      if(!OUTCOME_V2_NAMESPACE::detail::format_parse_mode(it, ctx.end(), mode))                                                                                                                                                                                                                                                                                                 \
+        OUTCOME_THROW_EXCEPTION(NS::ERROR("invalid format spec for a result, must be empty, v, e or #"));                                                                                                                                                                                                                                                                       \
+      return it;                                                                                                                                                                                                                                                                                                                                                                \
+    }                                                                                                                                                                                                                                                                                                                                                                           \
+    template <class FormatContext> auto format(const OUTCOME_V2_NAMESPACE::basic_result<R, S, P> &v, FormatContext &ctx) const { return OUTCOME_V2_NAMESPACE::detail::format_result<OUTCOME_V2_NAMESPACE::detail::BACKEND>(ctx.out(), v, mode); }                                                                                                                               \
+  };                                                                                                                                                                                                                                                                                                                                                                            \
+  template <class R, class S, class P, class N> struct formatter<OUTCOME_V2_NAMESPACE::basic_outcome<R, S, P, N>>                                                                                                                                                                                                                                                               \
+  {                                                                                                                                                                                                                                                                                                                                                                             \
+    OUTCOME_V2_NAMESPACE::detail::format_mode mode{OUTCOME_V2_NAMESPACE::detail::format_mode::normal};                                                                                                                                                                                                                                                                          \
+    template <class ParseContext> constexpr auto parse(ParseContext &ctx)                                                                                                                                                                                                                                                                                                       \
+    {                                                                                                                                                                                                                                                                                                                                                                           \
+      auto it = ctx.begin();                                                                                                                                                                                                                                                                                                                                                    \
+      if(!OUTCOME_V2_NAMESPACE::detail::format_parse_mode(it, ctx.end(), mode))                                                                                                                                                                                                                                                                                                 \
+        OUTCOME_THROW_EXCEPTION(NS::ERROR("invalid format spec for an outcome, must be empty, v, e or #"));                                                                                                                                                                                                                                                                     \
+      return it;                                                                                                                                                                                                                                                                                                                                                                \
+    }                                                                                                                                                                                                                                                                                                                                                                           \
+    template <class FormatContext> auto format(const OUTCOME_V2_NAMESPACE::basic_outcome<R, S, P, N> &v, FormatContext &ctx) const { return OUTCOME_V2_NAMESPACE::detail::format_outcome<OUTCOME_V2_NAMESPACE::detail::BACKEND>(ctx.out(), v, mode); }                                                                                                                          \
+  };
+
+
+#define OUTCOME_FORMAT_SUPPORT_ERROR_CODE_FORMATTER(NS, ERROR, BACKEND)                                                                                                                                                                                                                                                                                                         \
+  template <> struct formatter<OUTCOME_V2_NAMESPACE::formattable_error_code>                                                                                                                                                                                                                                                                                                    \
+  {                                                                                                                                                                                                                                                                                                                                                                             \
+    bool verbose{false};                                                                                                                                                                                                                                                                                                                                                        \
+    template <class ParseContext> constexpr auto parse(ParseContext &ctx)                                                                                                                                                                                                                                                                                                       \
+    {                                                                                                                                                                                                                                                                                                                                                                           \
+      OUTCOME_V2_NAMESPACE::detail::format_mode mode{OUTCOME_V2_NAMESPACE::detail::format_mode::normal};                                                                                                                                                                                                                                                                        \
+      auto it = ctx.begin();                                                                                                                                                                                                                                                                                                                                                    \
+      if(!OUTCOME_V2_NAMESPACE::detail::format_parse_mode(it, ctx.end(), mode) || mode == OUTCOME_V2_NAMESPACE::detail::format_mode::value_only)                                                                                                                                                                                                                                \
+        OUTCOME_THROW_EXCEPTION(NS::ERROR("invalid format spec for an error code, must be empty, e or #"));                                                                                                                                                                                                                                                                     \
+      verbose = (mode == OUTCOME_V2_NAMESPACE::detail::format_mode::verbose);                                                                                                                                                                                                                                                                                                   \
+      return it;                                                                                                                                                                                                                                                                                                                                                                \
+    }                                                                                                                                                                                                                                                                                                                                                                           \
+    template <class FormatContext> auto format(const OUTCOME_V2_NAMESPACE::formattable_error_code &v, FormatContext &ctx) const { return OUTCOME_V2_NAMESPACE::detail::format_payload<std::error_code>::write<OUTCOME_V2_NAMESPACE::detail::BACKEND>(ctx.out(), v.code(), verbose); }                                                                                           \
+  };
+
+#if OUTCOME_HAVE_STD_FORMAT_SUPPORT
+namespace std
+{
+  OUTCOME_FORMAT_SUPPORT_FORMATTERS(std, format_error, format_backend_std)
+  OUTCOME_FORMAT_SUPPORT_ERROR_CODE_FORMATTER(std, format_error, format_backend_std)
+}  // namespace std
+#endif
+#if OUTCOME_HAVE_FMT_SUPPORT
+FMT_BEGIN_NAMESPACE
+OUTCOME_FORMAT_SUPPORT_FORMATTERS(fmt, format_error, format_backend_fmt)
+OUTCOME_FORMAT_SUPPORT_ERROR_CODE_FORMATTER(fmt, format_error, format_backend_fmt)
+/* Before fmt 10, which formats error codes itself, fmt can be taught to format std::error_code
+directly, but only if no other library in the program does the same, so this must be opted into.
+*/
+#if FMT_VERSION < 100000 && defined(OUTCOME_ENABLE_FMT_ERROR_CODE_FORMATTER)
+template <> struct formatter<std::error_code> : formatter<OUTCOME_V2_NAMESPACE::formattable_error_code>
+{
+  template <class FormatContext> auto format(const std::error_code &v, FormatContext &ctx) const { return formatter<OUTCOME_V2_NAMESPACE::formattable_error_code>::format(OUTCOME_V2_NAMESPACE::formattable_error_code(v), ctx); }
+};
+#endif
+FMT_END_NAMESPACE
+#endif
+
+#endif
@@ -0,0 +1,182 @@
+/* std::hash support for results and outcomes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_HASH_SUPPORT_HPP
+#define OUTCOME_HASH_SUPPORT_HPP
+
+#include "outcome.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>  // for std::hash
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  // The finaliser of SplitMix64, which changes each output bit with half of the input bits
+  constexpr inline uint64_t hash_mix(uint64_t x) noexcept
+  {
+    x ^= x >> 30U;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27U;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31U;
+    return x;
+  }
+  // Order dependent, so combining a then b differs from b then a
+  constexpr inline uint64_t hash_combine(uint64_t seed, uint64_t v) noexcept { return hash_mix(seed ^ (v + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U))); }
+  // The bytes of a trivially copyable object, eight at a time
+  inline uint64_t hash_bytes(uint64_t seed, const void *p, size_t length) noexcept
+  {
+    const auto *s = static_cast<const char *>(p);
+    for(; length >= 8; s += 8, length -= 8)
+    {
+      uint64_t v;
+      memcpy(&v, s, 8);
+      seed = hash_combine(seed, v);
+    }
+    if(length > 0)
+    {
+      uint64_t v = 0;
+      memcpy(&v, s, length);
+      seed = hash_combine(seed, v);
+    }
+    return seed;
+  }
+
+  template <class T, class = void> struct is_std_hashable : std::false_type
+  {
+  };
+  template <class T> struct is_std_hashable<T, std::enable_if_t<std::is_convertible<decltype(std::hash<T>()(std::declval<const T &>())), size_t>::value>> : std::true_type
+  {
+  };
+
+  // The hash of a value, error or exception field, by its std::hash
+  template <class T> struct hash_field
+  {
+    static constexpr bool enabled = is_std_hashable<T>::value;
+    static uint64_t hash(const T &v) noexcept(noexcept(std::hash<T>()(v))) { return std::hash<T>()(v); }
+  };
+  /* std::exception_ptr has no std::hash, and what it points to cannot be portably identified,
+  so only whether there is an exception contributes to the hash, which stays consistent with
+  operator== at the cost of outcomes differing only in their exception colliding.
+  */
+  template <> struct hash_field<std::exception_ptr>
+  {
+    static constexpr bool enabled = true;
+    static constexpr uint64_t hash(const std::exception_ptr & /*unused*/) noexcept { return 0; }
+  };
+  template <class T> using hash_field_enabled = std::integral_constant<bool, std::is_void<T>::value || hash_field<std::conditional_t<std::is_void<T>::value, int, T>>::enabled>;
+
+  // Void fields contribute nothing
+  template <class T, class R> inline uint64_t hash_value(const R &r, std::false_type /*void*/) { return hash_field<T>::hash(r.assume_value()); }
+  template <class T, class R> inline uint64_t hash_error(const R &r, std::false_type /*void*/) { return hash_field<T>::hash(r.assume_error()); }
+  template <class T, class R> inline uint64_t hash_exception(const R &r, std::false_type /*void*/) { return hash_field<T>::hash(r.assume_exception()); }
+  template <class T, class R> constexpr inline uint64_t hash_value(const R & /*unused*/, std::true_type /*void*/) noexcept { return 0; }
+  template <class T, class R> constexpr inline uint64_t hash_error(const R & /*unused*/, std::true_type /*void*/) noexcept { return 0; }
+  template <class T, class R> constexpr inline uint64_t hash_exception(const R & /*unused*/, std::true_type /*void*/) noexcept { return 0; }
+
+  template <class T> struct result_hasher
+  {
+    // The has value, has error and has exception bits, then the hash of each the result has
+    size_t operator()(const T &r) const
+    {
+      const uint64_t status = (r.has_value() ? 1U : 0U) | (r.has_error() ? 2U : 0U) | (r.has_exception() ? 4U : 0U);
+      uint64_t h = hash_mix(status);
+      if(r.has_value())
+      {
+        h = hash_combine(h, hash_value<typename T::value_type>(r, std::is_void<typename T::value_type>()));
+      }
+      if(r.has_error())
+      {
+        h = hash_combine(h, hash_error<typename T::error_type>(r, std::is_void<typename T::error_type>()));
+      }
+      h = hash_exception_of(h, r);
+      return static_cast<size_t>(h);
+    }
+
+  private:
+    template <class U> static uint64_t hash_exception_of(uint64_t h, const U & /*unused*/) { return h; }
+    template <class R, class S, class P, class NoValuePolicy> static uint64_t hash_exception_of(uint64_t h, const basic_outcome<R, S, P, NoValuePolicy> &o)
+    {
+      return o.has_exception() ? hash_combine(h, hash_exception<P>(o, std::is_void<P>())) : h;
+    }
+  };
+  // std::hash of a result or outcome is disabled unless each of its types is hashable
+  template <class T, bool enabled> struct result_hash : result_hasher<T>
+  {
+  };
+  template <class T> struct result_hash<T, false>
+  {
+    result_hash() = delete;
+    result_hash(const result_hash &) = delete;
+    result_hash &operator=(const result_hash &) = delete;
+  };
+}  // namespace detail
+
+OUTCOME_V2_NAMESPACE_END
+
+namespace std
+{
+  /*! Hashes the has value, has error and has exception state of a result, and then its value
+  or its error, with `std::hash` of their types. It is consistent with `operator==`, and is
+  disabled unless each of `R` and `S` is `void` or has a `std::hash`.
+  */
+  template <class R, class S, class NoValuePolicy>
+  struct hash<OUTCOME_V2_NAMESPACE::basic_result<R, S, NoValuePolicy>>
+      : OUTCOME_V2_NAMESPACE::detail::result_hash<OUTCOME_V2_NAMESPACE::basic_result<R, S, NoValuePolicy>, OUTCOME_V2_NAMESPACE::detail::hash_field_enabled<R>::value && OUTCOME_V2_NAMESPACE::detail::hash_field_enabled<S>::value>
+  {
+  };
+  /*! Hashes the state of an outcome, and then its value, its error and its exception, with
+  `std::hash` of their types. As `std::exception_ptr` has no `std::hash`, only whether there is
+  one is hashed. It is consistent with `operator==`, and is disabled unless each of `R`, `S` and
+  `P` is `void`, `std::exception_ptr` or has a `std::hash`.
+  */
+  template <class R, class S, class P, class NoValuePolicy>
+  struct hash<OUTCOME_V2_NAMESPACE::basic_outcome<R, S, P, NoValuePolicy>>
+      : OUTCOME_V2_NAMESPACE::detail::result_hash<OUTCOME_V2_NAMESPACE::basic_outcome<R, S, P, NoValuePolicy>,
+                                                 OUTCOME_V2_NAMESPACE::detail::hash_field_enabled<R>::value && OUTCOME_V2_NAMESPACE::detail::hash_field_enabled<S>::value && OUTCOME_V2_NAMESPACE::detail::hash_field_enabled<P>::value>
+  {
+  };
+}  // namespace std
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+/*! A transparent hash of results and outcomes, which hashes each as its `std::hash` does. Paired
+with the transparent `std::equal_to<>`, an unordered container keyed by one result type can be
+searched with another whose values and errors hash and compare the same, such as a set of
+`result<std::string>` with a `result<std::string_view>`, without constructing a key.
+*/
+struct result_hash
+{
+  using is_transparent = void;
+  template <class R, class S, class NoValuePolicy> size_t operator()(const basic_result<R, S, NoValuePolicy> &r) const { return std::hash<basic_result<R, S, NoValuePolicy>>()(r); }
+  template <class R, class S, class P, class NoValuePolicy> size_t operator()(const basic_outcome<R, S, P, NoValuePolicy> &o) const { return std::hash<basic_outcome<R, S, P, NoValuePolicy>>()(o); }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
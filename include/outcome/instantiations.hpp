@@ -0,0 +1,104 @@
+/* Extern template declarations of commonly used results and outcomes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_INSTANTIATIONS_HPP
+#define OUTCOME_INSTANTIATIONS_HPP
+
+#include "experimental/status_outcome.hpp"
+#include "outcome.hpp"
+
+#include <string>
+
+/*! Declares, or with `OUTCOME_INSTANTIATIONS_EXTERN` defined empty explicitly instantiates, each
+of the classes which `basic_result<R, S, NoValuePolicy>` is built from. These suffice for move
+only `S`, such as `system_code`, which `basic_result`'s copying `as_failure() const &` cannot be
+instantiated for.
+*/
+#define OUTCOME_INSTANTIATE_BASIC_RESULT_BASES(R, S, NoValuePolicy)                                                                                                                                                                                                                                                            \
+  OUTCOME_INSTANTIATIONS_EXTERN template class OUTCOME_V2_NAMESPACE::detail::basic_result_storage<R, S, NoValuePolicy>;                                                                                                                                                                                                        \
+  OUTCOME_INSTANTIATIONS_EXTERN template class OUTCOME_V2_NAMESPACE::detail::basic_result_value_observers<OUTCOME_V2_NAMESPACE::detail::basic_result_storage<R, S, NoValuePolicy>, R, NoValuePolicy>;                                                                                                                          \
+  OUTCOME_INSTANTIATIONS_EXTERN template class OUTCOME_V2_NAMESPACE::detail::basic_result_error_observers<OUTCOME_V2_NAMESPACE::detail::basic_result_value_observers<OUTCOME_V2_NAMESPACE::detail::basic_result_storage<R, S, NoValuePolicy>, R, NoValuePolicy>, S, NoValuePolicy>;                                            \
+  OUTCOME_INSTANTIATIONS_EXTERN template class OUTCOME_V2_NAMESPACE::detail::basic_result_final<R, S, NoValuePolicy>
+
+/*! Declares, or with `OUTCOME_INSTANTIATIONS_EXTERN` defined empty explicitly instantiates, the
+`basic_result<R, S, NoValuePolicy>` and each of the classes it is built from.
+*/
+#define OUTCOME_INSTANTIATE_BASIC_RESULT(R, S, NoValuePolicy)                                                                                                                                                                                                                                                                  \
+  OUTCOME_INSTANTIATE_BASIC_RESULT_BASES(R, S, NoValuePolicy);                                                                                                                                                                                                                                                                 \
+  OUTCOME_INSTANTIATIONS_EXTERN template class OUTCOME_V2_NAMESPACE::basic_result<R, S, NoValuePolicy>
+
+/*! Declares, or with `OUTCOME_INSTANTIATIONS_EXTERN` defined empty explicitly instantiates, each
+of the classes which `basic_outcome<R, S, P, NoValuePolicy>` is built from.
+*/
+#define OUTCOME_INSTANTIATE_BASIC_OUTCOME_BASES(R, S, P, NoValuePolicy)                                                                                                                                                                                                                                                        \
+  OUTCOME_INSTANTIATE_BASIC_RESULT_BASES(R, S, NoValuePolicy);                                                                                                                                                                                                                                                                 \
+  OUTCOME_INSTANTIATIONS_EXTERN template class OUTCOME_V2_NAMESPACE::detail::basic_outcome_exception_observers<OUTCOME_V2_NAMESPACE::detail::basic_result_final<R, S, NoValuePolicy>, R, S, P, NoValuePolicy>
+
+/*! Declares, or with `OUTCOME_INSTANTIATIONS_EXTERN` defined empty explicitly instantiates, the
+`basic_outcome<R, S, P, NoValuePolicy>` and each of the classes it is built from.
+*/
+#define OUTCOME_INSTANTIATE_BASIC_OUTCOME(R, S, P, NoValuePolicy)                                                                                                                                                                                                                                                              \
+  OUTCOME_INSTANTIATE_BASIC_OUTCOME_BASES(R, S, P, NoValuePolicy);                                                                                                                                                                                                                                                             \
+  OUTCOME_INSTANTIATIONS_EXTERN template class OUTCOME_V2_NAMESPACE::basic_outcome<R, S, P, NoValuePolicy>
+
+/*! The results and outcomes explicitly instantiated by the `outcome_instantiations` library.
+Each is invoked as `X(R)`, so the list can be reused for other purposes.
+*/
+#define OUTCOME_INSTANTIATIONS_RESULT_TYPES(X) X(void) X(bool) X(int) X(unsigned) X(long long) X(unsigned long long) X(std::string)
+#define OUTCOME_INSTANTIATIONS_OUTCOME_TYPES(X) X(void) X(int) X(std::string)
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  // Single token names of the policies, as macro arguments cannot contain commas
+  template <class R> using instantiations_std_result_policy = policy::default_policy<R, std::error_code, void>;
+  template <class R> using instantiations_std_outcome_policy = policy::default_policy<R, std::error_code, std::exception_ptr>;
+  template <class R> using instantiations_status_result_policy = experimental::policy::default_status_result_policy<R, experimental::system_code>;
+  template <class R> using instantiations_status_outcome_policy = experimental::policy::default_status_outcome_policy<R, experimental::system_code, std::exception_ptr>;
+}  // namespace detail
+
+OUTCOME_V2_NAMESPACE_END
+
+#define OUTCOME_INSTANTIATE_STD_RESULT(R) OUTCOME_INSTANTIATE_BASIC_RESULT(R, std::error_code, OUTCOME_V2_NAMESPACE::detail::instantiations_std_result_policy<R>);
+#define OUTCOME_INSTANTIATE_STD_OUTCOME(R) OUTCOME_INSTANTIATE_BASIC_OUTCOME(R, std::error_code, std::exception_ptr, OUTCOME_V2_NAMESPACE::detail::instantiations_std_outcome_policy<R>);
+#define OUTCOME_INSTANTIATE_STATUS_RESULT(R) OUTCOME_INSTANTIATE_BASIC_RESULT_BASES(R, OUTCOME_V2_NAMESPACE::experimental::system_code, OUTCOME_V2_NAMESPACE::detail::instantiations_status_result_policy<R>);
+#define OUTCOME_INSTANTIATE_STATUS_OUTCOME(R) OUTCOME_INSTANTIATE_BASIC_OUTCOME_BASES(R, OUTCOME_V2_NAMESPACE::experimental::system_code, std::exception_ptr, OUTCOME_V2_NAMESPACE::detail::instantiations_status_outcome_policy<R>);
+
+/* Unless the instantiations themselves are being compiled, tell the compiler that they are
+compiled elsewhere, so translation units using these types need not instantiate their member
+functions. Define OUTCOME_DISABLE_EXTERN_INSTANTIATIONS to instantiate them as usual.
+*/
+#ifndef OUTCOME_INSTANTIATIONS_EXTERN
+#define OUTCOME_INSTANTIATIONS_EXTERN extern
+#endif
+
+#ifndef OUTCOME_DISABLE_EXTERN_INSTANTIATIONS
+OUTCOME_INSTANTIATIONS_RESULT_TYPES(OUTCOME_INSTANTIATE_STD_RESULT)
+OUTCOME_INSTANTIATIONS_OUTCOME_TYPES(OUTCOME_INSTANTIATE_STD_OUTCOME)
+OUTCOME_INSTANTIATIONS_RESULT_TYPES(OUTCOME_INSTANTIATE_STATUS_RESULT)
+OUTCOME_INSTANTIATIONS_OUTCOME_TYPES(OUTCOME_INSTANTIATE_STATUS_OUTCOME)
+#endif
+
+#endif
@@ -30,7 +30,7 @@ Distributed under the Boost Software License, Version 1.0.
 #include <iostream>
 #include <sstream>
 
-OUTCOME_V2_NAMESPACE_BEGIN
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace detail
 {
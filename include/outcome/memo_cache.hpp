@@ -0,0 +1,331 @@
+/* A concurrent memoising cache for functions returning results
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_MEMO_CACHE_HPP
+#define OUTCOME_MEMO_CACHE_HPP
+
+#include "basic_result.hpp"
+#include "detail/spin_wait.hpp"
+
+#include <chrono>
+#ifndef __cpp_lib_atomic_wait
+#include <condition_variable>
+#endif
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+//! Counters kept by a `memo_cache`.
+struct memo_cache_stats
+{
+  //! Lookups which found a cached success.
+  uint64_t hits{0};
+  //! Lookups which found a cached failure.
+  uint64_t negative_hits{0};
+  //! Lookups which invoked the function.
+  uint64_t misses{0};
+  /*! Lookups which waited upon, and received the result of, another thread's invocation of the
+  function for the same key. These are not also counted as hits or negative hits.
+  */
+  uint64_t coalesced{0};
+};
+
+namespace detail
+{
+  static constexpr size_t memo_cache_line_size = 64;
+
+  // A cached result, constructed in place once the function returns
+  template <class Result> struct memo_entry
+  {
+    static constexpr unsigned pending = 0, ready = 1, abandoned = 2;
+    std::atomic<unsigned> state{pending};
+    std::chrono::steady_clock::time_point expires;
+    union {
+      empty_type _empty;
+      Result result;
+    };
+#ifndef __cpp_lib_atomic_wait
+    // Without atomic waits, waiters sleep upon these rather than yield until the function returns
+    std::mutex lock;
+    std::condition_variable changed;
+#endif
+
+    memo_entry() noexcept
+        : _empty{}
+    {
+    }
+    memo_entry(const memo_entry &) = delete;
+    memo_entry &operator=(const memo_entry &) = delete;
+    ~memo_entry()
+    {
+      if(state.load(std::memory_order_acquire) == ready)
+      {
+        result.~Result();  // NOLINT
+      }
+    }
+
+    // Moves the entry out of pending into s, waking any waiters
+    void publish(unsigned s)
+    {
+#ifdef __cpp_lib_atomic_wait
+      state.store(s, std::memory_order_release);
+      spin_wait_notify_all(state);
+#else
+      {
+        std::lock_guard<std::mutex> g(lock);
+        state.store(s, std::memory_order_release);
+      }
+      changed.notify_all();
+#endif
+    }
+    // Waits until the entry is no longer pending, returning its new state
+    unsigned wait()
+    {
+#ifdef __cpp_lib_atomic_wait
+      return spin_wait_while_equal(state, pending);
+#else
+      unsigned ret;
+      std::unique_lock<std::mutex> g(lock);
+      while((ret = state.load(std::memory_order_acquire)) == pending)
+      {
+        changed.wait(g);
+      }
+      return ret;
+#endif
+    }
+  };
+
+  // Padded rather than aligned, so shards can be heap allocated before C++ 17
+  template <class Key, class Result, class Hash, class KeyEqual> struct memo_shard
+  {
+    std::mutex lock;
+    std::unordered_map<Key, std::shared_ptr<memo_entry<Result>>, Hash, KeyEqual> map;
+    std::atomic<uint64_t> hits{0}, negative_hits{0}, misses{0}, coalesced{0};
+    char _pad[memo_cache_line_size];
+  };
+}  // namespace detail
+
+/*! A concurrent cache of the `Result`s, which must be `basic_result`s, returned by a function of
+`Key`. Successes are cached for `value_ttl`, failures for `error_ttl`, so repeatedly failing
+lookups do not each reach the backend.
+
+Keys are spread over a power of two number of shards, each a lock protected hash table of
+entries, so lookups of different keys rarely contend. The lock is only held to find or insert an
+entry, never whilst the function runs. Concurrent lookups of a key not yet cached are coalesced:
+only the first invokes the function, and the others wait upon its result, which is constructed
+in place within the entry. If the function throws, the exception propagates to its caller, and
+any waiters retry.
+*/
+template <class Key, class Result, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>> class memo_cache
+{
+  static_assert(is_basic_result_v<Result>, "memo_cache requires the cached type to be a basic_result");
+  using _entry = detail::memo_entry<Result>;
+  using _shard = detail::memo_shard<Key, Result, Hash, KeyEqual>;
+  using _clock = std::chrono::steady_clock;
+
+  std::unique_ptr<_shard[]> _shards;
+  size_t _shard_mask;
+  Hash _hash;
+  _clock::duration _value_ttl, _error_ttl;
+
+  _shard &_shard_for(const Key &k) const noexcept
+  {
+    // Fibonacci hash the high bits, so shard choice is independent of bucket choice
+    const auto h = static_cast<uint64_t>(_hash(k)) * UINT64_C(0x9E3779B97F4A7C15);
+    return _shards[static_cast<size_t>(h >> 32) & _shard_mask];
+  }
+  static _clock::time_point _expiry(_clock::time_point now, _clock::duration ttl) noexcept { return (ttl >= _clock::time_point::max() - now) ? _clock::time_point::max() : now + ttl; }
+
+public:
+  using key_type = Key;
+  using result_type = Result;
+  using duration = _clock::duration;
+
+  /*! Constructs a cache of `shards` shards, rounded up to a power of two, which caches successes
+  for `value_ttl` and failures for `error_ttl`. Zero TTLs disable caching, but not coalescing.
+  */
+  explicit memo_cache(duration value_ttl = duration::max(), duration error_ttl = std::chrono::seconds(1), size_t shards = 64)
+      : _value_ttl(value_ttl)
+      , _error_ttl(error_ttl)
+  {
+    size_t n = 1;
+    while(n < shards)
+    {
+      n <<= 1;
+    }
+    _shards.reset(new _shard[n]);
+    _shard_mask = n - 1;
+  }
+
+  /*! Returns the cached result for `k` if there is one which has not expired. Otherwise returns
+  the result of `f(k)`, caching it, unless another thread is already invoking the function for
+  `k`, in which case that result is waited upon and returned.
+  */
+  template <class F> Result get_or_compute(const Key &k, F &&f)
+  {
+    _shard &s = _shard_for(k);
+    for(;;)
+    {
+      std::shared_ptr<_entry> e;
+      bool owner = false;
+      {
+        std::lock_guard<std::mutex> g(s.lock);
+        auto it = s.map.find(k);
+        if(it != s.map.end())
+        {
+          const unsigned state = it->second->state.load(std::memory_order_acquire);
+          if(state == _entry::pending || (state == _entry::ready && _clock::now() < it->second->expires))
+          {
+            e = it->second;
+          }
+        }
+        if(!e)
+        {
+          e = std::make_shared<_entry>();
+          s.map[k] = e;
+          owner = true;
+        }
+      }
+      if(owner)
+      {
+        s.misses.fetch_add(1, std::memory_order_relaxed);
+#ifdef __cpp_exceptions
+        try
+#endif
+        {
+          new(&e->result) Result(f(k));  // NOLINT
+        }
+#ifdef __cpp_exceptions
+        catch(...)
+        {
+          {
+            std::lock_guard<std::mutex> g(s.lock);
+            auto it = s.map.find(k);
+            if(it != s.map.end() && it->second == e)
+            {
+              s.map.erase(it);
+            }
+          }
+          e->publish(_entry::abandoned);
+          throw;
+        }
+#endif
+        e->expires = _expiry(_clock::now(), e->result.has_value() ? _value_ttl : _error_ttl);
+        e->publish(_entry::ready);
+        return e->result;
+      }
+      unsigned state = e->state.load(std::memory_order_acquire);
+      if(state == _entry::pending)
+      {
+        state = e->wait();
+        if(state == _entry::ready)
+        {
+          // Counted as coalesced only, not also as a hit
+          s.coalesced.fetch_add(1, std::memory_order_relaxed);
+          return e->result;
+        }
+      }
+      else if(state == _entry::ready)
+      {
+        (e->result.has_value() ? s.hits : s.negative_hits).fetch_add(1, std::memory_order_relaxed);
+        return e->result;
+      }
+      // The invoker threw, so try again
+    }
+  }
+
+  //! Removes any cached result for `k`. Lookups already waiting upon it are unaffected.
+  void erase(const Key &k)
+  {
+    _shard &s = _shard_for(k);
+    std::lock_guard<std::mutex> g(s.lock);
+    s.map.erase(k);
+  }
+  //! Removes every cached result.
+  void clear()
+  {
+    for(size_t i = 0; i <= _shard_mask; i++)
+    {
+      std::lock_guard<std::mutex> g(_shards[i].lock);
+      _shards[i].map.clear();
+    }
+  }
+  //! Removes every expired result, returning how many were removed.
+  size_t purge_expired()
+  {
+    size_t ret = 0;
+    const auto now = _clock::now();
+    for(size_t i = 0; i <= _shard_mask; i++)
+    {
+      std::lock_guard<std::mutex> g(_shards[i].lock);
+      auto &map = _shards[i].map;
+      for(auto it = map.begin(); it != map.end();)
+      {
+        const unsigned state = it->second->state.load(std::memory_order_acquire);
+        if(state == _entry::ready && now >= it->second->expires)
+        {
+          it = map.erase(it);
+          ++ret;
+        }
+        else
+        {
+          ++it;
+        }
+      }
+    }
+    return ret;
+  }
+  //! The number of entries, including expired and in flight ones.
+  size_t size() const
+  {
+    size_t ret = 0;
+    for(size_t i = 0; i <= _shard_mask; i++)
+    {
+      std::lock_guard<std::mutex> g(_shards[i].lock);
+      ret += _shards[i].map.size();
+    }
+    return ret;
+  }
+  //! A snapshot of the counters, summed over all shards.
+  memo_cache_stats stats() const noexcept
+  {
+    memo_cache_stats ret;
+    for(size_t i = 0; i <= _shard_mask; i++)
+    {
+      ret.hits += _shards[i].hits.load(std::memory_order_relaxed);
+      ret.negative_hits += _shards[i].negative_hits.load(std::memory_order_relaxed);
+      ret.misses += _shards[i].misses.load(std::memory_order_relaxed);
+      ret.coalesced += _shards[i].coalesced.load(std::memory_order_relaxed);
+    }
+    return ret;
+  }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,54 @@
+/* A result type with the fewest possible standard library includes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_MINIMAL_RESULT_HPP
+#define OUTCOME_MINIMAL_RESULT_HPP
+
+/* If this is the first Outcome header included, the standard library headers included are only
+<cstdint>, <initializer_list>, <new>, <type_traits> and <utility>, as <new> is needed to construct
+in place. Compilers other than GCC and clang also need <cstdlib> and <cstring>, and if C++
+exceptions are disabled, <cstdio> and <cstdlib> are included to report any exception Outcome
+would have thrown. As some inline functions are then defined differently, such as those reporting
+the misuse of narrow observers, which cannot use assert(), Outcome is then in a namespace of its
+own, so results cannot be passed to translation units which included other Outcome headers first.
+*/
+#if !defined(OUTCOME_V2_CONFIG_HPP) && !defined(OUTCOME_MINIMAL_INCLUDES)
+#define OUTCOME_MINIMAL_INCLUDES 1
+#endif
+
+#include "basic_result.hpp"
+#include "policy/terminate.hpp"
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! A `basic_result` which by default calls `std::abort()` on any wide observation of a value or
+error which is not present. Neither `std::error_code` nor `std::exception_ptr` is supported, use
+`std_result` or `std_outcome` for those.
+*/
+template <class R, class S, class NoValuePolicy = policy::terminate>  //
+using minimal_result = basic_result<R, S, NoValuePolicy>;
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,330 @@
+/* Parallel traversal of result returning functions
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_PARALLEL_HPP
+#define OUTCOME_PARALLEL_HPP
+
+#include "basic_result.hpp"
+
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  // Atomics written by different threads are kept on separate cache lines
+  static constexpr size_t parallel_cache_line_size = 64;
+
+  /* The single place where the winning failure is kept. The first failing
+  worker to claim the slot move constructs its basic_result into it, and
+  every other worker observes the claim as a request to stop scheduling.
+  */
+  template <class Result> class parallel_first_failure
+  {
+    static constexpr unsigned _empty_state = 0, _claimed_state = 1, _published_state = 2;
+    alignas(parallel_cache_line_size) std::atomic<unsigned> _state{_empty_state};
+    alignas(parallel_cache_line_size) std::atomic<bool> _have_exception{false};
+    std::exception_ptr _exception;
+    union {
+      empty_type _empty;
+      Result _result;
+    };
+
+  public:
+    parallel_first_failure() noexcept
+        : _empty{}
+    {
+    }
+    parallel_first_failure(const parallel_first_failure &) = delete;
+    parallel_first_failure &operator=(const parallel_first_failure &) = delete;
+    ~parallel_first_failure()
+    {
+      if(_state.load(std::memory_order_acquire) == _published_state)
+      {
+        _result.~Result();  // NOLINT
+      }
+    }
+
+    // True if any worker has failed, and no more work should be scheduled
+    bool cancelled() const noexcept { return _state.load(std::memory_order_relaxed) != _empty_state; }
+
+    // Returns false if some other worker got there first
+    bool try_set(Result &&r) noexcept(std::is_nothrow_move_constructible<Result>::value)
+    {
+      unsigned expected = _empty_state;
+      if(!_state.compare_exchange_strong(expected, _claimed_state, std::memory_order_acq_rel, std::memory_order_relaxed))
+      {
+        return false;
+      }
+      new(&_result) Result(static_cast<Result &&>(r));  // NOLINT
+      _state.store(_published_state, std::memory_order_release);
+      return true;
+    }
+    // Any exception thrown by a worker cancels everybody, first one thrown wins
+    void set_exception(std::exception_ptr e) noexcept
+    {
+      if(!_have_exception.exchange(true, std::memory_order_acq_rel))
+      {
+        _exception = static_cast<std::exception_ptr &&>(e);
+      }
+      unsigned expected = _empty_state;
+      _state.compare_exchange_strong(expected, _claimed_state, std::memory_order_acq_rel, std::memory_order_relaxed);
+    }
+
+    // Only to be called once all workers have been joined
+    bool has_result() const noexcept { return _state.load(std::memory_order_acquire) == _published_state; }
+    Result &&result() noexcept { return static_cast<Result &&>(_result); }  // NOLINT
+    std::exception_ptr &exception() noexcept { return _exception; }
+  };
+
+  // Uninitialised storage for the collected values, with a per chunk count of how many were constructed
+  template <class T> class parallel_value_slots
+  {
+    struct _storage_type
+    {
+      alignas(T) unsigned char _bytes[sizeof(T)];
+    };
+    std::unique_ptr<_storage_type[]> _values;
+    std::unique_ptr<size_t[]> _constructed;
+    size_t _chunk_size, _chunks;
+
+  public:
+    parallel_value_slots(size_t items, size_t chunk_size, size_t chunks)
+        : _values(new _storage_type[items])
+        , _constructed(new size_t[chunks]())
+        , _chunk_size(chunk_size)
+        , _chunks(chunks)
+    {
+    }
+    parallel_value_slots(const parallel_value_slots &) = delete;
+    parallel_value_slots &operator=(const parallel_value_slots &) = delete;
+    ~parallel_value_slots()
+    {
+      for(size_t c = 0; c < _chunks; c++)
+      {
+        for(size_t n = 0; n < _constructed[c]; n++)
+        {
+          (*this)[c * _chunk_size + n].~T();
+        }
+      }
+    }
+    T &operator[](size_t idx) noexcept { return *reinterpret_cast<T *>(&_values[idx]); }  // NOLINT
+    template <class U> void construct(size_t idx, U &&v) { new(&_values[idx]) T(static_cast<U &&>(v)); }  // NOLINT
+    void set_constructed(size_t chunk, size_t count) noexcept { _constructed[chunk] = count; }
+  };
+  template <> class parallel_value_slots<void>
+  {
+  public:
+    parallel_value_slots(size_t /*unused*/, size_t /*unused*/, size_t /*unused*/) noexcept {}
+    void set_constructed(size_t /*unused*/, size_t /*unused*/) noexcept {}
+  };
+
+  template <class Result> struct parallel_traverse_types
+  {
+    static_assert(is_basic_result_v<Result>, "parallel_traverse() requires the callable to return a basic_result");
+    static_assert(!std::is_void<typename Result::error_type>::value, "parallel_traverse() requires a basic_result with an error type");
+    using value_type = typename Result::value_type;
+    using collected_type = std::conditional_t<std::is_void<value_type>::value, void, std::vector<value_type>>;
+    using result_type = typename Result::template rebind<collected_type>;
+  };
+
+  // Returns false if the invocation failed
+  template <class Result, class RandomIt, class F> inline bool parallel_traverse_invoke(parallel_value_slots<void> & /*unused*/, size_t /*unused*/, RandomIt it, F &f, parallel_first_failure<Result> &failure)
+  {
+    Result r = f(*it);
+    if(!r.has_value())
+    {
+      failure.try_set(static_cast<Result &&>(r));
+      return false;
+    }
+    return true;
+  }
+  template <class Result, class T, class RandomIt, class F> inline bool parallel_traverse_invoke(parallel_value_slots<T> &slots, size_t idx, RandomIt it, F &f, parallel_first_failure<Result> &failure)
+  {
+    Result r = f(*it);
+    if(!r.has_value())
+    {
+      failure.try_set(static_cast<Result &&>(r));
+      return false;
+    }
+    slots.construct(idx, static_cast<Result &&>(r).assume_value());
+    return true;
+  }
+
+  template <class ResultType, class T> inline ResultType parallel_traverse_collect(parallel_value_slots<T> &slots, size_t items)
+  {
+    std::vector<T> ret;
+    ret.reserve(items);
+    for(size_t n = 0; n < items; n++)
+    {
+      ret.push_back(static_cast<T &&>(slots[n]));
+    }
+    return ResultType{in_place_type<typename ResultType::value_type>, static_cast<std::vector<T> &&>(ret)};
+  }
+  template <class ResultType> inline ResultType parallel_traverse_collect(parallel_value_slots<void> & /*unused*/, size_t /*unused*/) { return ResultType{success()}; }
+}  // namespace detail
+
+/*! Applies `f`, which must return a `basic_result<U, E, P>`, to every item in the random access
+range `[first, last)` using up to `concurrency` threads, of which the calling thread is one. If
+`concurrency` is zero, `std::thread::hardware_concurrency()` is used.
+
+Items are claimed in chunks of `chunk_size` items (zero chooses a size which keeps each chunk's
+output at least a cache line long, with around eight chunks per thread) from a single atomic
+cursor, so idle workers naturally take over the remaining work of busy ones.
+
+\returns A `basic_result<std::vector<U>, E, P>` (`basic_result<void, E, P>` if `U` is `void`)
+holding every value in input order, or the failure returned by the first invocation of `f` to
+fail. As soon as any invocation fails, no more chunks are scheduled and in flight chunks stop
+at their next item. Which failure wins is unspecified if more than one invocation fails.
+\throws If `f` throws, the first exception thrown is rethrown in the calling thread once all
+workers have stopped.
+*/
+template <class RandomIt, class F>
+inline typename detail::parallel_traverse_types<std::decay_t<decltype(std::declval<F &>()(*std::declval<RandomIt>()))>>::result_type  //
+parallel_traverse(RandomIt first, RandomIt last, F &&f, size_t concurrency = 0, size_t chunk_size = 0)
+{
+  static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<RandomIt>::iterator_category>::value, "parallel_traverse() requires random access iterators");
+  using invoke_result_type = std::decay_t<decltype(std::declval<F &>()(*std::declval<RandomIt>()))>;
+  using types = detail::parallel_traverse_types<invoke_result_type>;
+  using value_type = typename types::value_type;
+  using result_type = typename types::result_type;
+
+  const auto items = static_cast<size_t>(last - first);
+  if(concurrency == 0)
+  {
+    concurrency = std::thread::hardware_concurrency();
+    if(concurrency == 0)
+    {
+      concurrency = 1;
+    }
+  }
+  if(chunk_size == 0)
+  {
+    const size_t per_cache_line = detail::parallel_cache_line_size / sizeof(detail::devoid<value_type>);
+    const size_t per_thread = (items + concurrency * 8 - 1) / (concurrency * 8);
+    chunk_size = (per_cache_line > per_thread) ? per_cache_line : per_thread;
+    if(chunk_size == 0)
+    {
+      chunk_size = 1;
+    }
+  }
+  const size_t chunks = (items + chunk_size - 1) / chunk_size;
+  if(concurrency > chunks)
+  {
+    concurrency = (chunks > 0) ? chunks : 1;
+  }
+
+  detail::parallel_value_slots<value_type> slots(items, chunk_size, chunks);
+  detail::parallel_first_failure<invoke_result_type> failure;
+  alignas(detail::parallel_cache_line_size) std::atomic<size_t> next_chunk{0};
+
+  /* Not noexcept, as the callable, and the move of a failure into the first failure slot
+  or of a value into its slot, may throw. Whatever throws becomes the first failure, so
+  nothing escapes into std::thread.
+  */
+  auto worker = [&]() {
+    for(;;)
+    {
+      if(failure.cancelled())
+      {
+        return;
+      }
+      const size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+      if(chunk >= chunks)
+      {
+        return;
+      }
+      const size_t begin = chunk * chunk_size, end = (begin + chunk_size < items) ? (begin + chunk_size) : items;
+      size_t idx = begin;
+#ifdef __cpp_exceptions
+      try
+#endif
+      {
+        while(idx < end && !failure.cancelled() && detail::parallel_traverse_invoke(slots, idx, first + idx, f, failure))
+        {
+          ++idx;
+        }
+      }
+#ifdef __cpp_exceptions
+      catch(...)
+      {
+        failure.set_exception(std::current_exception());
+      }
+#endif
+      slots.set_constructed(chunk, idx - begin);
+    }
+  };
+
+  {
+    std::vector<std::thread> threads;
+    struct join_all
+    {
+      std::vector<std::thread> &threads;
+      ~join_all()
+      {
+        for(auto &t : threads)
+        {
+          t.join();
+        }
+      }
+    } _{threads};
+#ifdef __cpp_exceptions
+    try
+#endif
+    {
+      threads.reserve(concurrency - 1);
+      for(size_t n = 1; n < concurrency; n++)
+      {
+        threads.emplace_back(worker);
+      }
+    }
+#ifdef __cpp_exceptions
+    catch(...)
+    {
+      // Couldn't launch all the threads asked for, so make do with those we got
+    }
+#endif
+    worker();
+  }
+#ifdef __cpp_exceptions
+  if(failure.exception())
+  {
+    std::rethrow_exception(failure.exception());
+  }
+#endif
+  if(failure.has_result())
+  {
+    return result_type{in_place_type<typename result_type::error_type>, static_cast<invoke_result_type &&>(failure.result()).assume_error()};
+  }
+  return detail::parallel_traverse_collect<result_type>(slots, items);
+}
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,157 @@
+/* Policy recording incorrect narrow observations into a per thread log
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_POLICY_ALL_NARROW_LOGGED_HPP
+#define OUTCOME_POLICY_ALL_NARROW_LOGGED_HPP
+
+#include "all_narrow.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// How many of its most recent incorrect observations each thread retains
+#ifndef OUTCOME_NARROW_VIOLATION_LOG_ENTRIES
+#define OUTCOME_NARROW_VIOLATION_LOG_ENTRIES 64
+#endif
+
+#if OUTCOME_LOG_NARROW_VIOLATIONS && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace policy
+{
+  //! Which observation of a result or outcome was incorrect
+  enum class narrow_violation_kind : unsigned char
+  {
+    value,
+    error,
+    exception
+  };
+
+  //! An incorrect narrow observation recorded by `all_narrow_logged`
+  struct narrow_violation
+  {
+    const void *call_site;       // the return address into the function which observed
+    const void *object;          // the result or outcome observed
+    uint32_t status;             // its status bits when observed
+    narrow_violation_kind kind;  // what was observed
+  };
+
+  /*! The most recent incorrect narrow observations made by a thread. Only the thread owning
+  a log writes to it, so recording takes no lock, never allocates and never fails, overwriting
+  the oldest entry when full.
+  */
+  class narrow_violation_log
+  {
+    narrow_violation _entries[OUTCOME_NARROW_VIOLATION_LOG_ENTRIES];
+    size_t _recorded{0};
+
+  public:
+    constexpr narrow_violation_log() noexcept
+        : _entries{}
+    {
+    }
+    narrow_violation_log(const narrow_violation_log &) = delete;
+    narrow_violation_log &operator=(const narrow_violation_log &) = delete;
+
+    //! The number of entries retained
+    size_t size() const noexcept { return (_recorded < OUTCOME_NARROW_VIOLATION_LOG_ENTRIES) ? _recorded : OUTCOME_NARROW_VIOLATION_LOG_ENTRIES; }
+    //! True if nothing has been recorded since the last `clear()`
+    bool empty() const noexcept { return _recorded == 0; }
+    //! The number of entries recorded since the last `clear()`, including those overwritten
+    size_t recorded() const noexcept { return _recorded; }
+    //! The `n`th oldest entry retained
+    const narrow_violation &operator[](size_t n) const noexcept { return _entries[(_recorded - size() + n) % OUTCOME_NARROW_VIOLATION_LOG_ENTRIES]; }
+    //! Forgets all the entries
+    void clear() noexcept { _recorded = 0; }
+    //! Records an entry
+    void push_back(const narrow_violation &v) noexcept { _entries[(_recorded++) % OUTCOME_NARROW_VIOLATION_LOG_ENTRIES] = v; }
+  };
+
+  /*! The log of the calling thread. It is constant initialised and trivially destructible, so
+  no guard is checked to access it, and it can be read at any time during the life of the thread.
+  */
+  inline narrow_violation_log &this_thread_narrow_violations() noexcept
+  {
+    static OUTCOME_THREAD_LOCAL narrow_violation_log log;
+    return log;
+  }
+
+#if OUTCOME_LOG_NARROW_VIOLATIONS
+  namespace detail
+  {
+    // Out of line, and called from the observers and checks forced inline, so its return address
+    // identifies the code which observed
+    OUTCOME_COLD_NOINLINE inline void record_narrow_violation(const void *object, uint32_t status, narrow_violation_kind kind) noexcept
+    {
+#ifdef _MSC_VER
+      const void *call_site = _ReturnAddress();
+#else
+      const void *call_site = __builtin_return_address(0);
+#endif
+      this_thread_narrow_violations().push_back({call_site, object, status, kind});
+    }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL 
+type definition  all_narrow_logged. Potential doc page: `all_narrow_logged`
+*/
+  struct all_narrow_logged : base
+  {
+    template <class Impl> OUTCOME_NARROW_VIOLATION_FORCEINLINE static constexpr void narrow_value_check(Impl &&self) noexcept
+    {
+      if(!base::_has_value(self))
+      {
+        detail::record_narrow_violation(&self, base::_status(self), narrow_violation_kind::value);
+      }
+    }
+    template <class Impl> OUTCOME_NARROW_VIOLATION_FORCEINLINE static constexpr void narrow_error_check(Impl &&self) noexcept
+    {
+      if(!base::_has_error(self))
+      {
+        detail::record_narrow_violation(&self, base::_status(self), narrow_violation_kind::error);
+      }
+    }
+    template <class Impl> OUTCOME_NARROW_VIOLATION_FORCEINLINE static constexpr void narrow_exception_check(Impl &&self) noexcept
+    {
+      if(!base::_has_exception(self))
+      {
+        detail::record_narrow_violation(&self, base::_status(self), narrow_violation_kind::exception);
+      }
+    }
+    template <class Impl> OUTCOME_NARROW_VIOLATION_FORCEINLINE static constexpr void wide_value_check(Impl &&self) { narrow_value_check(static_cast<Impl &&>(self)); }
+    template <class Impl> OUTCOME_NARROW_VIOLATION_FORCEINLINE static constexpr void wide_error_check(Impl &&self) { narrow_error_check(static_cast<Impl &&>(self)); }
+    template <class Impl> OUTCOME_NARROW_VIOLATION_FORCEINLINE static constexpr void wide_exception_check(Impl &&self) { narrow_exception_check(static_cast<Impl &&>(self)); }
+  };
+#else
+  using all_narrow_logged = all_narrow;
+#endif
+}  // namespace policy
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
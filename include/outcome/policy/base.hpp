@@ -27,7 +27,9 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include "../config.hpp"
 
+#if !OUTCOME_MINIMAL_INCLUDES || !(defined(__GNUC__) || defined(__clang__))
 #include <cassert>
+#endif
 
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
@@ -48,7 +50,14 @@ SIGNATURE NOT RECOGNISED
 #endif
     void _ub(Impl && /*unused*/)
     {
+#if OUTCOME_MINIMAL_INCLUDES && (defined(__GNUC__) || defined(__clang__))
+// There is no <cassert> in minimal mode, whose namespace differs so this cannot break the ODR
+#ifndef NDEBUG
+      __builtin_trap();
+#endif
+#else
       assert(false);  // NOLINT
+#endif
 #if defined(__GNUC__) || defined(__clang__)
       __builtin_unreachable();
 #elif defined(_MSC_VER)
@@ -60,6 +69,7 @@ SIGNATURE NOT RECOGNISED
     template <class Impl> static constexpr bool _has_error(Impl &&self) noexcept { return (self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_error) != 0; }
     template <class Impl> static constexpr bool _has_exception(Impl &&self) noexcept { return (self._state._status & OUTCOME_V2_NAMESPACE::detail::status_have_exception) != 0; }
     template <class Impl> static constexpr bool _has_error_is_errno(Impl &&self) noexcept { return (self._state._status & OUTCOME_V2_NAMESPACE::detail::status_error_is_errno) != 0; }
+    template <class Impl> static constexpr auto _status(Impl &&self) noexcept { return self._state._status; }
 
     template <class Impl> static constexpr void _set_has_value(Impl &&self, bool v) noexcept { v ? self._state._status |= OUTCOME_V2_NAMESPACE::detail::status_have_value : self._state._status &= ~OUTCOME_V2_NAMESPACE::detail::status_have_value; }
     template <class Impl> static constexpr void _set_has_error(Impl &&self, bool v) noexcept { v ? self._state._status |= OUTCOME_V2_NAMESPACE::detail::status_have_error : self._state._status &= ~OUTCOME_V2_NAMESPACE::detail::status_have_error; }
@@ -46,24 +46,23 @@ type definition  error_code_throw_as_system_error. Potential doc page: NOT FOUND
         }
         if(base::_has_error(std::forward<Impl>(self)))
         {
-          // ADL discovered
-          outcome_throw_as_system_error_with_payload(base::_error(std::forward<Impl>(self)));
+          detail::throw_as_system_error_with_payload<bad_outcome_access>(base::_error(std::forward<Impl>(self)));
         }
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no value"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_outcome_access("no value");
       }
     }
     template <class Impl> static constexpr void wide_error_check(Impl &&self)
     {
       if(!base::_has_error(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no error"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_outcome_access("no error");
       }
     }
     template <class Impl> static constexpr void wide_exception_check(Impl &&self)
     {
       if(!base::_has_exception(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no exception"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_outcome_access("no exception");
       }
     }
   };
@@ -48,21 +48,21 @@ type definition  exception_ptr_rethrow. Potential doc page: NOT FOUND
         {
           detail::_rethrow_exception<trait::is_exception_ptr_available<EC>::value>{base::_error(std::forward<Impl>(self))};
         }
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no value"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_outcome_access("no value");
       }
     }
     template <class Impl> static constexpr void wide_error_check(Impl &&self)
     {
       if(!base::_has_error(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no error"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_outcome_access("no error");
       }
     }
     template <class Impl> static constexpr void wide_exception_check(Impl &&self)
     {
       if(!base::_has_exception(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no exception"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_outcome_access("no exception");
       }
     }
   };
@@ -34,6 +34,20 @@ OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace policy
 {
+  namespace detail
+  {
+    /* Out of line, so however much code the payload function generates to throw the error,
+    the wide value check of each result with this error type inlines to a test and a branch.
+    */
+    template <class BadAccess, class Error> QUICKCPPLIB_NORETURN OUTCOME_COLD_NOINLINE inline void throw_as_system_error_with_payload(Error &&error)
+    {
+      // ADL discovered
+      outcome_throw_as_system_error_with_payload(static_cast<Error &&>(error));
+      // If the payload function returned, throw what the wide value check would have next
+      OUTCOME_THROW_EXCEPTION(BadAccess("no value"));  // NOLINT
+    }
+  }  // namespace detail
+
   template <class T, class EC, class E> struct error_code_throw_as_system_error;
   /*! AWAITING HUGO JSON CONVERSION TOOL 
 SIGNATURE NOT RECOGNISED
@@ -46,17 +60,16 @@ SIGNATURE NOT RECOGNISED
       {
         if(base::_has_error(std::forward<Impl>(self)))
         {
-          // ADL discovered
-          outcome_throw_as_system_error_with_payload(base::_error(std::forward<Impl>(self)));
+          detail::throw_as_system_error_with_payload<bad_result_access>(base::_error(std::forward<Impl>(self)));
         }
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no value"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_result_access("no value");
       }
     }
     template <class Impl> static constexpr void wide_error_check(Impl &&self)
     {
       if(!base::_has_error(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no error"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_result_access("no error");
       }
     }
   };
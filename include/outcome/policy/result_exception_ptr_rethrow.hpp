@@ -47,14 +47,14 @@ SIGNATURE NOT RECOGNISED
           // ADL
           rethrow_exception(policy::exception_ptr(base::_error(std::forward<Impl>(self))));
         }
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no value"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_result_access("no value");
       }
     }
     template <class Impl> static constexpr void wide_error_check(Impl &&self)
     {
       if(!base::_has_error(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no error"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_result_access("no error");
       }
     }
   };
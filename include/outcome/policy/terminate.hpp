@@ -27,7 +27,13 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include "base.hpp"
 
+// __builtin_abort() needs no declaration, so <cstdlib> can be avoided on GCC and clang
+#if OUTCOME_MINIMAL_INCLUDES && (defined(__GNUC__) || defined(__clang__))
+#define OUTCOME_POLICY_TERMINATE_ABORT() __builtin_abort()
+#else
 #include <cstdlib>
+#define OUTCOME_POLICY_TERMINATE_ABORT() std::abort()
+#endif
 
 OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
@@ -42,21 +48,21 @@ type definition  terminate. Potential doc page: `terminate`
     {
       if(!base::_has_value(static_cast<Impl &&>(self)))
       {
-        std::abort();
+        OUTCOME_POLICY_TERMINATE_ABORT();
       }
     }
     template <class Impl> static constexpr void wide_error_check(Impl &&self) noexcept
     {
       if(!base::_has_error(static_cast<Impl &&>(self)))
       {
-        std::abort();
+        OUTCOME_POLICY_TERMINATE_ABORT();
       }
     }
     template <class Impl> static constexpr void wide_exception_check(Impl &&self)
     {
       if(!base::_has_exception(static_cast<Impl &&>(self)))
       {
-        std::abort();
+        OUTCOME_POLICY_TERMINATE_ABORT();
       }
     }
   };
@@ -41,21 +41,21 @@ type definition  throw_bad_result_access. Potential doc page: NOT FOUND
     {
       if(!base::_has_value(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no value"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_outcome_access("no value");
       }
     }
     template <class Impl> static constexpr void wide_error_check(Impl &&self)
     {
       if(!base::_has_error(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no error"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_outcome_access("no error");
       }
     }
     template <class Impl> static constexpr void wide_exception_check(Impl &&self)
     {
       if(!base::_has_exception(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_outcome_access("no exception"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_outcome_access("no exception");
       }
     }
   };
@@ -67,16 +67,16 @@ type definition  throw_bad_result_access. Potential doc page: NOT FOUND
       {
         if(base::_has_error(std::forward<Impl>(self)))
         {
-          OUTCOME_THROW_EXCEPTION(bad_result_access_with<EC>(base::_error(std::forward<Impl>(self))));
+          OUTCOME_V2_NAMESPACE::detail::throw_bad_result_access_with<EC>(base::_error(std::forward<Impl>(self)));
         }
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no value"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_result_access("no value");
       }
     }
     template <class Impl> static constexpr void wide_error_check(Impl &&self)
     {
       if(!base::_has_error(std::forward<Impl>(self)))
       {
-        OUTCOME_THROW_EXCEPTION(bad_result_access("no error"));  // NOLINT
+        OUTCOME_V2_NAMESPACE::detail::throw_bad_result_access("no error");
       }
     }
   };
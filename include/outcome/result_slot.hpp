@@ -0,0 +1,263 @@
+/* A single assignment slot for handing a result between threads
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_SLOT_HPP
+#define OUTCOME_RESULT_SLOT_HPP
+
+#include "detail/coroutine_support.hpp"
+#include "detail/spin_wait.hpp"
+#include "std_result.hpp"
+
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  /* Something waiting for a basic_result_slot to be published: a blocked thread, or a
+  suspended coroutine. Waiters link themselves into a list headed in the slot, and live
+  in the waiting thread's stack or the awaiting coroutine's frame, so they outlive the
+  slot's publication for as long as the producer needs them.
+  */
+  struct result_slot_waiter
+  {
+    result_slot_waiter *next{nullptr};
+    void (*wake)(result_slot_waiter *) noexcept {nullptr};
+  };
+  struct result_slot_thread_waiter : result_slot_waiter
+  {
+    std::mutex lock;
+    std::condition_variable cond;
+    bool woken{false};
+
+    result_slot_thread_waiter() noexcept { wake = &_wake; }
+    /* The consumer cannot return from waiting until it reacquires the lock, which the
+    producer holds until it is done with us.
+    */
+    static void _wake(result_slot_waiter *w) noexcept
+    {
+      auto *self = static_cast<result_slot_thread_waiter *>(w);
+      std::lock_guard<std::mutex> g(self->lock);
+      self->woken = true;
+      self->cond.notify_one();
+    }
+  };
+}  // namespace detail
+
+/*! A slot into which a producer thread constructs a `basic_result<R, S, NoValuePolicy>`
+exactly once, and from which a consumer thread retrieves it. Unlike `std::promise` and
+`std::future` there is no shared state to allocate.
+
+The result is constructed in place, then published with a single atomic exchange of the
+head of the list of waiters with a "ready" marker. That exchange is the last access the
+producer makes to the slot, so a consumer which sees the result published may destroy the
+slot at once, even though the producer is still waking the waiters it took from the list.
+
+Consumers may poll with `try_get()`, block with `wait()` which spins before sleeping, or
+`co_await` the slot. Any number of threads and coroutines may wait at once.
+*/
+template <class R, class S, class NoValuePolicy> class basic_result_slot
+{
+public:
+  using result_type = basic_result<R, S, NoValuePolicy>;
+  using value_type = typename result_type::value_type;
+  using error_type = typename result_type::error_type;
+
+private:
+  /* Null, the head of the list of waiters, or `this` once published. We use our own address
+  as the "ready" marker, as it can never be a waiter.
+  */
+  mutable std::atomic<void *> _waiters{nullptr};
+  detail::status_bitfield_type _status{0};  // written before publication, read only after
+  union {
+    detail::empty_type _empty;
+    result_type _result;
+  };
+
+  void _publish() noexcept
+  {
+    _status = _result._iostreams_state()._status;
+    assert(_status != 0);
+    void *head = _waiters.exchange(const_cast<basic_result_slot *>(this), std::memory_order_acq_rel);  // NOLINT
+    // From here on *this may have been destroyed
+    auto *w = static_cast<detail::result_slot_waiter *>(head);
+    while(w != nullptr)
+    {
+      // Waking may destroy the waiter, so read its successor first
+      detail::result_slot_waiter *next = w->next;
+      w->wake(w);
+      w = next;
+    }
+  }
+  // Links `w` into the list of waiters, returning false if already published
+  bool _add_waiter(detail::result_slot_waiter *w) const noexcept
+  {
+    void *head = _waiters.load(std::memory_order_acquire);
+    do
+    {
+      if(head == this)
+      {
+        return false;
+      }
+      w->next = static_cast<detail::result_slot_waiter *>(head);
+    } while(!_waiters.compare_exchange_weak(head, w, std::memory_order_acq_rel, std::memory_order_acquire));
+    return true;
+  }
+  void _wait(unsigned spins) const noexcept
+  {
+    // Spinning on a uniprocessor only delays the thread we are waiting upon
+    static const bool uniprocessor = std::thread::hardware_concurrency() == 1;
+    if(uniprocessor)
+    {
+      spins = 0;
+    }
+    for(unsigned n = 0; n < spins; n++)
+    {
+      if(ready())
+      {
+        return;
+      }
+      detail::spin_pause();
+    }
+    detail::result_slot_thread_waiter w;
+    if(_add_waiter(&w))
+    {
+      std::unique_lock<std::mutex> g(w.lock);
+      w.cond.wait(g, [&] { return w.woken; });
+    }
+  }
+
+public:
+  basic_result_slot() noexcept
+      : _empty{}
+  {
+  }
+  basic_result_slot(const basic_result_slot &) = delete;
+  basic_result_slot(basic_result_slot &&) = delete;
+  basic_result_slot &operator=(const basic_result_slot &) = delete;
+  basic_result_slot &operator=(basic_result_slot &&) = delete;
+  ~basic_result_slot()
+  {
+    if(ready())
+    {
+      _result.~result_type();  // NOLINT
+    }
+  }
+
+  /*! Constructs the result in place from `args`, then publishes it. May be called once only
+  until `reset()`.
+  */
+  template <class... Args> void set(Args &&... args) noexcept(std::is_nothrow_constructible<result_type, Args...>::value)
+  {
+    assert(!ready());
+    new(&_result) result_type(static_cast<Args &&>(args)...);  // NOLINT
+    _publish();
+  }
+  //! Constructs a successful result in place from `args`, then publishes it.
+  template <class... Args> void emplace_value(Args &&... args) noexcept(std::is_nothrow_constructible<result_type, in_place_type_t<typename result_type::value_type_if_enabled>, Args...>::value)
+  {
+    set(in_place_type<typename result_type::value_type_if_enabled>, static_cast<Args &&>(args)...);
+  }
+  //! Constructs an unsuccessful result in place from `args`, then publishes it.
+  template <class... Args> void emplace_error(Args &&... args) noexcept(std::is_nothrow_constructible<result_type, in_place_type_t<typename result_type::error_type_if_enabled>, Args...>::value)
+  {
+    set(in_place_type<typename result_type::error_type_if_enabled>, static_cast<Args &&>(args)...);
+  }
+
+  //! True if the result has been published.
+  bool ready() const noexcept { return _waiters.load(std::memory_order_acquire) == this; }
+  //! The published status bitfield, or zero if not ready yet.
+  detail::status_bitfield_type status() const noexcept { return ready() ? _status : 0; }
+
+  //! Returns the result if it has been published, else null. Never blocks.
+  result_type *try_get() noexcept { return ready() ? &_result : nullptr; }
+  //! \overload
+  const result_type *try_get() const noexcept { return ready() ? &_result : nullptr; }
+
+  //! Blocks until the result has been published, spinning for `spins` iterations before sleeping.
+  result_type &wait(unsigned spins = 4096) noexcept
+  {
+    _wait(spins);
+    return _result;
+  }
+  //! \overload
+  const result_type &wait(unsigned spins = 4096) const noexcept
+  {
+    _wait(spins);
+    return _result;
+  }
+  //! Blocks until the result has been published, then moves it out of the slot.
+  result_type take(unsigned spins = 4096) noexcept(std::is_nothrow_move_constructible<result_type>::value) { return static_cast<result_type &&>(wait(spins)); }
+
+  /*! Destroys any published result, so the slot can be set again. Must not race with
+  any producer or consumer.
+  */
+  void reset() noexcept
+  {
+    if(ready())
+    {
+      _result.~result_type();  // NOLINT
+      _status = 0;
+    }
+    _waiters.store(nullptr, std::memory_order_relaxed);
+  }
+
+#if OUTCOME_HAVE_COROUTINES
+  //! An awaitable which resumes the awaiting coroutine once the result has been published.
+  class awaitable : detail::result_slot_waiter
+  {
+    basic_result_slot *_slot;
+    detail::coroutine_handle<> _h;
+
+    static void _wake(detail::result_slot_waiter *w) noexcept { static_cast<awaitable *>(w)->_h.resume(); }
+
+  public:
+    explicit awaitable(basic_result_slot *slot) noexcept
+        : _slot(slot)
+    {
+      wake = &_wake;
+    }
+    bool await_ready() const noexcept { return _slot->ready(); }
+    bool await_suspend(detail::coroutine_handle<> h) noexcept
+    {
+      _h = h;
+      // If this fails, the producer published in between await_ready() and now
+      return _slot->_add_waiter(this);
+    }
+    result_type &await_resume() noexcept { return _slot->_result; }
+  };
+  awaitable operator co_await() noexcept { return awaitable(this); }
+#endif
+};
+
+/*! A `basic_result_slot` for a `result<R, S>`.
+*/
+template <class R, class S = std::error_code, class NoValuePolicy = policy::default_policy<R, S, void>>  //
+using result_slot = basic_result_slot<R, S, NoValuePolicy>;
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,251 @@
+/* Zero copy views of results stored in memory mapped records
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_RESULT_VIEW_HPP
+#define OUTCOME_RESULT_VIEW_HPP
+
+#include "bad_access.hpp"
+#include "basic_result.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+/*! The layout of a fixed size record holding a `basic_result<T, E>`, for trivially copyable
+`T` and `E`. A record is the result's status as a host endian `uint32_t`, then the value or error
+at `payload_offset`, padded so consecutive records remain aligned for both `T` and `E`.
+*/
+template <class T, class E> struct result_record
+{
+  static_assert(std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value, "result_record requires a trivially copyable, non pointer, value type");
+  static_assert(std::is_trivially_copyable<E>::value && !std::is_pointer<E>::value, "result_record requires a trivially copyable, non pointer, error type");
+
+  //! The alignment which records require.
+  static constexpr size_t alignment = (alignof(T) > alignof(E)) ? ((alignof(T) > alignof(uint32_t)) ? alignof(T) : alignof(uint32_t)) : ((alignof(E) > alignof(uint32_t)) ? alignof(E) : alignof(uint32_t));
+  //! The offset of the value or error within a record.
+  static constexpr size_t payload_offset = (sizeof(uint32_t) + alignment - 1) / alignment * alignment;
+  //! The size of a record, which is also the distance between consecutive records.
+  static constexpr size_t size = (payload_offset + ((sizeof(T) > sizeof(E)) ? sizeof(T) : sizeof(E)) + alignment - 1) / alignment * alignment;
+
+  /*! Writes `v` as a record into the `size` bytes at `out`, which must be suitably aligned.
+  Unused bytes are zeroed, so records have no indeterminate content.
+  */
+  template <class P> static void store(void *out, const basic_result<T, E, P> &v) noexcept
+  {
+    assert(reinterpret_cast<uintptr_t>(out) % alignment == 0);  // NOLINT
+    auto *p = static_cast<char *>(out);
+    memset(p, 0, size);
+    const uint32_t status = v._iostreams_state()._status & (detail::status_have_value | detail::status_have_error | detail::status_2byte_mask);
+    memcpy(p, &status, sizeof(status));
+    if(v.has_value())
+    {
+      memcpy(p + payload_offset, &v.assume_value(), sizeof(T));
+    }
+    else if(v.has_error())
+    {
+      memcpy(p + payload_offset, &v.assume_error(), sizeof(E));
+    }
+  }
+};
+
+/*! A read only view of a `basic_result<T, E>` stored as a `result_record<T, E>`, such as within a
+memory mapped file, whose value or error is referenced in place rather than copied. Its observers
+mirror those of `basic_result` with `policy::throw_bad_result_access`, and it supplies the members
+which the default `try_operation_*` hooks look for, so it can be the subject of `OUTCOME_TRY`. Being
+a `ValueOrError`, it can also be explicitly converted into a `basic_result` which copies it.
+*/
+template <class T, class E> class result_view
+{
+  using _record = result_record<T, E>;
+  const char *_p;
+
+  uint32_t _status() const noexcept
+  {
+    uint32_t ret;
+    memcpy(&ret, _p, sizeof(ret));
+    return ret;
+  }
+
+public:
+  using value_type = T;
+  using error_type = E;
+
+  //! Views the record at `record`, which must be aligned to `result_record<T, E>::alignment`.
+  explicit result_view(const void *record) noexcept
+      : _p(static_cast<const char *>(record))
+  {
+    assert(reinterpret_cast<uintptr_t>(record) % _record::alignment == 0);  // NOLINT
+  }
+
+  //! The address of the record being viewed.
+  const void *data() const noexcept { return _p; }
+
+  //! True if the record holds a value.
+  bool has_value() const noexcept { return (_status() & detail::status_have_value) != 0; }
+  //! True if the record holds an error.
+  bool has_error() const noexcept { return (_status() & detail::status_have_error) != 0; }
+  //! True if the record holds an error.
+  bool has_failure() const noexcept { return has_error(); }
+  //! True if the record holds a value.
+  explicit operator bool() const noexcept { return has_value(); }
+  //! The spare storage bits of the stored result.
+  uint16_t spare_storage() const noexcept { return static_cast<uint16_t>(_status() >> detail::status_2byte_shift); }
+
+  //! A reference to the value in place, without checking that there is one.
+  const T &assume_value() const noexcept { return *reinterpret_cast<const T *>(_p + _record::payload_offset); }  // NOLINT
+  //! A reference to the error in place, without checking that there is one.
+  const E &assume_error() const noexcept { return *reinterpret_cast<const E *>(_p + _record::payload_offset); }  // NOLINT
+  //! A reference to the value in place, throwing `bad_result_access_with<E>` if there is none.
+  const T &value() const
+  {
+    if(!has_value())
+    {
+      if(has_error())
+      {
+        OUTCOME_THROW_EXCEPTION(bad_result_access_with<E>(assume_error()));
+      }
+      OUTCOME_THROW_EXCEPTION(bad_result_access("no value"));
+    }
+    return assume_value();
+  }
+  //! A reference to the error in place, throwing `bad_result_access` if there is none.
+  const E &error() const
+  {
+    if(!has_error())
+    {
+      OUTCOME_THROW_EXCEPTION(bad_result_access("no error"));
+    }
+    return assume_error();
+  }
+  //! A copy of the error as a `failure_type`, as is returned by `OUTCOME_TRY`.
+  failure_type<E> as_failure() const noexcept { return failure(assume_error()); }
+};
+
+/*! An iterator over contiguous `result_record<T, E>`s, dereferencing to `result_view<T, E>`.
+As it dereferences to a proxy rather than a reference, it is only a legacy input iterator,
+though it is a C++ 20 random access iterator.
+*/
+template <class T, class E> class result_view_iterator
+{
+  using _record = result_record<T, E>;
+  const char *_p{nullptr};
+
+public:
+  using iterator_category = std::input_iterator_tag;
+#ifdef __cpp_lib_ranges
+  using iterator_concept = std::random_access_iterator_tag;
+#endif
+  using value_type = result_view<T, E>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = result_view<T, E>;
+
+  result_view_iterator() = default;
+  explicit result_view_iterator(const void *record) noexcept
+      : _p(static_cast<const char *>(record))
+  {
+  }
+
+  reference operator*() const noexcept { return reference(_p); }
+  reference operator[](difference_type n) const noexcept { return reference(_p + n * static_cast<difference_type>(_record::size)); }
+  result_view_iterator &operator++() noexcept
+  {
+    _p += _record::size;
+    return *this;
+  }
+  result_view_iterator operator++(int) noexcept
+  {
+    result_view_iterator ret(*this);
+    _p += _record::size;
+    return ret;
+  }
+  result_view_iterator &operator--() noexcept
+  {
+    _p -= _record::size;
+    return *this;
+  }
+  result_view_iterator operator--(int) noexcept
+  {
+    result_view_iterator ret(*this);
+    _p -= _record::size;
+    return ret;
+  }
+  result_view_iterator &operator+=(difference_type n) noexcept
+  {
+    _p += n * static_cast<difference_type>(_record::size);
+    return *this;
+  }
+  result_view_iterator &operator-=(difference_type n) noexcept
+  {
+    _p -= n * static_cast<difference_type>(_record::size);
+    return *this;
+  }
+  friend result_view_iterator operator+(result_view_iterator a, difference_type n) noexcept { return a += n; }
+  friend result_view_iterator operator+(difference_type n, result_view_iterator a) noexcept { return a += n; }
+  friend result_view_iterator operator-(result_view_iterator a, difference_type n) noexcept { return a -= n; }
+  friend difference_type operator-(result_view_iterator a, result_view_iterator b) noexcept { return (a._p - b._p) / static_cast<difference_type>(_record::size); }
+  friend bool operator==(result_view_iterator a, result_view_iterator b) noexcept { return a._p == b._p; }
+  friend bool operator!=(result_view_iterator a, result_view_iterator b) noexcept { return a._p != b._p; }
+  friend bool operator<(result_view_iterator a, result_view_iterator b) noexcept { return a._p < b._p; }
+  friend bool operator>(result_view_iterator a, result_view_iterator b) noexcept { return a._p > b._p; }
+  friend bool operator<=(result_view_iterator a, result_view_iterator b) noexcept { return a._p <= b._p; }
+  friend bool operator>=(result_view_iterator a, result_view_iterator b) noexcept { return a._p >= b._p; }
+};
+
+/*! A range of the `result_record<T, E>`s in a contiguous, suitably aligned, region of memory such
+as a memory mapped file. Any trailing bytes too few to hold a whole record are ignored.
+*/
+template <class T, class E> class result_view_span
+{
+  using _record = result_record<T, E>;
+  const char *_p;
+  size_t _count;
+
+public:
+  using iterator = result_view_iterator<T, E>;
+  using value_type = result_view<T, E>;
+
+  result_view_span(const void *data, size_t bytes) noexcept
+      : _p(static_cast<const char *>(data))
+      , _count(bytes / _record::size)
+  {
+    assert(reinterpret_cast<uintptr_t>(data) % _record::alignment == 0);  // NOLINT
+  }
+
+  //! The number of records.
+  size_t size() const noexcept { return _count; }
+  //! True if there are no records.
+  bool empty() const noexcept { return _count == 0; }
+  //! A view of the `n`th record.
+  value_type operator[](size_t n) const noexcept { return value_type(_p + n * _record::size); }
+  iterator begin() const noexcept { return iterator(_p); }
+  iterator end() const noexcept { return iterator(_p + _count * _record::size); }
+};
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
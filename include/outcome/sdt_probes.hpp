@@ -0,0 +1,193 @@
+/* Static tracepoints on the failure paths of Outcome
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef OUTCOME_SDT_PROBES_HPP
+#define OUTCOME_SDT_PROBES_HPP
+
+#include "config.hpp"
+
+/* If OUTCOME_ENABLE_SDT_PROBES is 1, Outcome places static tracepoints, which perf, bpftrace
+and SystemTap see as the USDT probes of provider `outcome`:
+
+- `result_failure`: a `basic_result` is constructed with an error by a converting or in place
+constructor. Copies and moves, including from other results, do not fire it.
+- `outcome_failure`: a `basic_outcome` is constructed with an error or exception by a converting
+or in place constructor. Copies and moves, including from other outcomes, do not fire it.
+- `try_failure`: `OUTCOME_TRY` returns the failure of its operand.
+- `status_code_throw`: the wide value observer of a `status_result` or `status_outcome` throws
+its status code.
+
+Each has four arguments: the address of the object, the id of the domain of its error, the value
+of its error, and the return address of the function in which the probe is. The domain id is
+that of a status code domain, the address of the `std::error_category` of a `std::error_code`,
+or zero, and the value is zero if it is not integral. A probe is a nop and a `.note.stapsdt`
+ELF note describing it, so without a tracer attached it costs only that its arguments are
+computed. Only ELF targets on x64 and AArch64 built with GCC or clang have probes.
+
+The probes in the construction hooks are replaced by any hooks customised for a type.
+*/
+#ifndef OUTCOME_ENABLE_SDT_PROBES
+#define OUTCOME_ENABLE_SDT_PROBES 0
+#endif
+
+#ifndef OUTCOME_SDT_PROBES_AVAILABLE
+#if defined(__ELF__) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__aarch64__))
+#define OUTCOME_SDT_PROBES_AVAILABLE 1
+#else
+#define OUTCOME_SDT_PROBES_AVAILABLE 0
+#endif
+#endif
+
+#if OUTCOME_SDT_PROBES_AVAILABLE
+/* Places the probe `name` of `provider` with four arguments convertible to `int64_t`, emitting
+the same ELF note as `STAP_PROBE4()` of <sys/sdt.h>, without needing that header.
+*/
+#define OUTCOME_SDT_PROBE4(provider, name, a1, a2, a3, a4)                                                                                                                          \
+  __asm__ __volatile__("990: nop\n"                                                                                                                                                 \
+                       ".pushsection .note.stapsdt,\"?\",\"note\"\n"                                                                                                                \
+                       ".balign 4\n"                                                                                                                                                \
+                       ".4byte 992f-991f, 994f-993f, 3\n"                                                                                                                           \
+                       "991: .asciz \"stapsdt\"\n"                                                                                                                                  \
+                       "992: .balign 4\n"                                                                                                                                           \
+                       "993: .8byte 990b\n"                                                                                                                                         \
+                       ".8byte _.stapsdt.base\n"                                                                                                                                    \
+                       ".8byte 0\n"                                                                                                                                                 \
+                       ".asciz \"" #provider "\"\n"                                                                                                                                 \
+                       ".asciz \"" #name "\"\n"                                                                                                                                     \
+                       ".asciz \"-8@%0 -8@%1 -8@%2 -8@%3\"\n"                                                                                                                       \
+                       "994: .balign 4\n"                                                                                                                                           \
+                       ".popsection\n"                                                                                                                                              \
+                       ".ifndef _.stapsdt.base\n"                                                                                                                                   \
+                       ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"                                                                                      \
+                       ".weak _.stapsdt.base\n"                                                                                                                                     \
+                       ".hidden _.stapsdt.base\n"                                                                                                                                   \
+                       "_.stapsdt.base: .space 1\n"                                                                                                                                 \
+                       ".size _.stapsdt.base, 1\n"                                                                                                                                  \
+                       ".popsection\n"                                                                                                                                              \
+                       ".endif\n"                                                                                                                                                   \
+                       :                                                                                                                                                            \
+                       : "nor"(static_cast<int64_t>(a1)), "nor"(static_cast<int64_t>(a2)), "nor"(static_cast<int64_t>(a3)), "nor"(static_cast<int64_t>(a4)))
+#else
+#define OUTCOME_SDT_PROBE4(provider, name, a1, a2, a3, a4) ((void) (a1), (void) (a2), (void) (a3), (void) (a4))
+#endif
+
+#if OUTCOME_ENABLE_SDT_PROBES && OUTCOME_SDT_PROBES_AVAILABLE
+//! Fires the probe `name` on the failure of the object at `ptr`, if not constant evaluated
+#define OUTCOME_SDT_FAILURE(name, ptr) OUTCOME_V2_NAMESPACE::detail::sdt_probe_##name(ptr)
+#else
+#define OUTCOME_SDT_FAILURE(name, ptr) ((void) (ptr))
+#endif
+
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  template <class T> using sdt_is_integral = std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value>;
+  template <class T> constexpr inline int64_t sdt_value(const T &v, std::true_type /*unused*/) noexcept { return static_cast<int64_t>(v); }
+  template <class T> constexpr inline int64_t sdt_value(const T & /*unused*/, std::false_type /*unused*/) noexcept { return 0; }
+
+  /* The domain id and value which the probes report for an error of type `E`. Specialised for
+  the error types which have a domain.
+  */
+  template <class E> struct sdt_error_info
+  {
+    static constexpr uint64_t domain(const E & /*unused*/) noexcept { return 0; }
+    static constexpr int64_t value(const E &v) noexcept { return sdt_value(v, sdt_is_integral<E>()); }
+  };
+
+#if OUTCOME_ENABLE_SDT_PROBES && OUTCOME_SDT_PROBES_AVAILABLE
+  // The error of a result or outcome, if it has one
+  template <class T, class E = std::decay_t<decltype(std::declval<const T &>().assume_error())>, std::enable_if_t<!std::is_void<E>::value, bool> = true, class = decltype(std::declval<const T &>().has_error())>
+  inline void sdt_error_of(const T &x, uint64_t &domain, int64_t &value, int /*unused*/) noexcept
+  {
+    if(x.has_error())
+    {
+      domain = sdt_error_info<E>::domain(x.assume_error());
+      value = sdt_error_info<E>::value(x.assume_error());
+    }
+  }
+  template <class T> inline void sdt_error_of(const T & /*unused*/, uint64_t & /*unused*/, int64_t & /*unused*/, ...) noexcept {}
+
+  // Always inlined, so the probe is where the failure is, and its return address is of that function
+  template <class T> __attribute__((always_inline)) inline void sdt_fire_result_failure(const T *x) noexcept
+  {
+    uint64_t domain = 0;
+    int64_t value = 0;
+    sdt_error_of(*x, domain, value, 5);
+    OUTCOME_SDT_PROBE4(outcome, result_failure, reinterpret_cast<intptr_t>(x), domain, value, reinterpret_cast<intptr_t>(__builtin_return_address(0)));
+  }
+  template <class T> __attribute__((always_inline)) inline void sdt_fire_outcome_failure(const T *x) noexcept
+  {
+    uint64_t domain = 0;
+    int64_t value = 0;
+    sdt_error_of(*x, domain, value, 5);
+    OUTCOME_SDT_PROBE4(outcome, outcome_failure, reinterpret_cast<intptr_t>(x), domain, value, reinterpret_cast<intptr_t>(__builtin_return_address(0)));
+  }
+  template <class T> __attribute__((always_inline)) inline void sdt_fire_try_failure(const T *x) noexcept
+  {
+    uint64_t domain = 0;
+    int64_t value = 0;
+    sdt_error_of(*x, domain, value, 5);
+    OUTCOME_SDT_PROBE4(outcome, try_failure, reinterpret_cast<intptr_t>(x), domain, value, reinterpret_cast<intptr_t>(__builtin_return_address(0)));
+  }
+  template <class T> __attribute__((always_inline)) inline void sdt_fire_status_code_throw(const T *x) noexcept
+  {
+    OUTCOME_SDT_PROBE4(outcome, status_code_throw, reinterpret_cast<intptr_t>(x), sdt_error_info<T>::domain(*x), sdt_error_info<T>::value(*x), reinterpret_cast<intptr_t>(__builtin_return_address(0)));
+  }
+
+  template <class T> constexpr inline void sdt_probe_result_failure(const T *x) noexcept
+  {
+    if(!OUTCOME_IS_CONSTANT_EVALUATED() && x->has_failure())
+    {
+      sdt_fire_result_failure(x);
+    }
+  }
+  template <class T> constexpr inline void sdt_probe_outcome_failure(const T *x) noexcept
+  {
+    if(!OUTCOME_IS_CONSTANT_EVALUATED() && x->has_failure())
+    {
+      sdt_fire_outcome_failure(x);
+    }
+  }
+  template <class T> constexpr inline void sdt_probe_try_failure(const T *x) noexcept
+  {
+    if(!OUTCOME_IS_CONSTANT_EVALUATED())
+    {
+      sdt_fire_try_failure(x);
+    }
+  }
+  template <class T> constexpr inline void sdt_probe_status_code_throw(const T *x) noexcept
+  {
+    if(!OUTCOME_IS_CONSTANT_EVALUATED())
+    {
+      sdt_fire_status_code_throw(x);
+    }
+  }
+#endif
+}  // namespace detail
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
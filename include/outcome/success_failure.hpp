@@ -27,7 +27,7 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include "config.hpp"
 
-OUTCOME_V2_NAMESPACE_BEGIN
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
 type definition template <class T> success_type. Potential doc page: `success_type<T>`
@@ -232,12 +232,12 @@ namespace detail
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-template <class T> static constexpr bool is_success_type = detail::is_success_type<std::decay_t<T>>::value;
+template <class T> OUTCOME_INLINE_CONSTEXPR bool is_success_type = detail::is_success_type<std::decay_t<T>>::value;
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-template <class T> static constexpr bool is_failure_type = detail::is_failure_type<std::decay_t<T>>::value;
+template <class T> OUTCOME_INLINE_CONSTEXPR bool is_failure_type = detail::is_failure_type<std::decay_t<T>>::value;
 
 OUTCOME_V2_NAMESPACE_END
 
@@ -27,7 +27,7 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include "config.hpp"
 
-OUTCOME_V2_NAMESPACE_BEGIN
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace trait
 {
@@ -35,7 +35,7 @@ namespace trait
 SIGNATURE NOT RECOGNISED
 */
   template <class R>                                                             //
-  static constexpr bool type_can_be_used_in_basic_result =                       //
+  OUTCOME_INLINE_CONSTEXPR bool type_can_be_used_in_basic_result =               //
   (!std::is_reference<R>::value                                                  //
    && !OUTCOME_V2_NAMESPACE::detail::is_in_place_type_t<std::decay_t<R>>::value  //
    && !is_success_type<R>                                                        //
@@ -61,6 +61,17 @@ type definition  is_error_type_enum. Potential doc page: NOT FOUND
     static constexpr bool value = false;
   };
 
+  /*! True if moving a `T` into new storage and destroying the original is equivalent to copying its
+  bytes, so two `T` can be swapped by swapping their bytes. Trivially copyable types are. Specialise
+  this to `true` for types which are not trivially copyable but whose objects never point into
+  themselves nor are pointed to by others, such as most smart pointers and containers. `basic_result`
+  and `basic_outcome` then swap their storage of such types by swapping its bytes.
+  */
+  template <class T> struct is_trivially_relocatable
+  {
+    static constexpr bool value = std::is_trivially_copyable<T>::value;
+  };
+
   namespace detail
   {
     template <class T> using devoid = OUTCOME_V2_NAMESPACE::detail::devoid<T>;
@@ -30,7 +30,7 @@ Distributed under the Boost Software License, Version 1.0.
 #include <exception>
 #include <system_error>
 
-OUTCOME_V2_NAMESPACE_BEGIN
+OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 #ifdef __cpp_exceptions
 /*! AWAITING HUGO JSON CONVERSION TOOL 
@@ -0,0 +1,728 @@
+/* Waiting upon the first failure or the first success of many results
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2019
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef OUTCOME_WHEN_ALL_HPP
+#define OUTCOME_WHEN_ALL_HPP
+
+#include "result_slot.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#ifdef __cpp_exceptions
+#include <exception>
+#endif
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+OUTCOME_V2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  // The policies all being templated on value, error and exception, rebinds one to a new value type
+  template <class Policy, class T> struct when_rebind_policy
+  {
+    using type = Policy;
+  };
+  template <template <class, class, class> class Policy, class U, class E, class X, class T> struct when_rebind_policy<Policy<U, E, X>, T>
+  {
+    using type = Policy<T, E, X>;
+  };
+  template <class Result, class T> struct when_rebind_result;
+  template <class R, class S, class P, class T> struct when_rebind_result<basic_result<R, S, P>, T>
+  {
+    using type = basic_result<T, S, typename when_rebind_policy<P, T>::type>;
+  };
+
+  template <class Result> struct when_all_types
+  {
+    static_assert(is_basic_result_v<Result>, "when_all() requires sources producing a basic_result");
+    static_assert(!std::is_void<typename Result::error_type>::value, "when_all() requires a basic_result with an error type");
+    using value_type = typename Result::value_type;
+    using collected_type = std::conditional_t<std::is_void<value_type>::value, void, std::vector<value_type>>;
+    using result_type = typename when_rebind_result<Result, collected_type>::type;
+  };
+  template <class Result> struct when_any_types
+  {
+    static_assert(is_basic_result_v<Result>, "when_any() requires sources producing a basic_result");
+    using result_type = Result;
+  };
+
+  template <class Result> struct result_slot_for;
+  template <class R, class S, class P> struct result_slot_for<basic_result<R, S, P>>
+  {
+    using type = basic_result_slot<R, S, P>;
+  };
+
+  /* The state shared between the consumer of a group and its producers, allocated
+  once together with storage for every producer's result. A single atomic word counts
+  the producers yet to report, whether the consumer still holds the group, and whether
+  the group has been decided. Whoever brings the word to zero frees the state.
+  */
+  template <class Result, bool Any> class when_state
+  {
+  public:
+    using result_type = typename std::conditional_t<Any, when_any_types<Result>, when_all_types<Result>>::result_type;
+
+  private:
+    static constexpr size_t _decided_bit = 1, _consumer_bit = 2, _producer_unit = 4;
+    struct _slot
+    {
+      alignas(Result) unsigned char storage[sizeof(Result)];
+      bool filled;
+    };
+    static_assert(alignof(_slot) <= alignof(std::max_align_t), "over aligned results are not supported");
+
+    std::atomic<size_t> _count;
+    size_t _size;
+    size_t _index{0};
+    typename result_slot_for<result_type>::type _completion;
+#ifdef __cpp_exceptions
+    // Set before the completion is published, if the group was decided by an exception
+    std::exception_ptr _exception;
+#endif
+
+    static constexpr size_t _slots_offset() noexcept { return (sizeof(when_state) + alignof(_slot) - 1) / alignof(_slot) * alignof(_slot); }
+    _slot *_slots() noexcept { return reinterpret_cast<_slot *>(reinterpret_cast<char *>(this) + _slots_offset()); }  // NOLINT
+    Result &_result(size_t idx) noexcept { return *reinterpret_cast<Result *>(_slots()[idx].storage); }                // NOLINT
+
+    explicit when_state(size_t n) noexcept
+        : _count(n * _producer_unit + _consumer_bit)
+        , _size(n)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        _slots()[i].filled = false;
+      }
+    }
+    ~when_state()
+    {
+      for(size_t i = 0; i < _size; i++)
+      {
+        if(_slots()[i].filled)
+        {
+          _result(i).~Result();
+        }
+      }
+    }
+    void _destroy() noexcept
+    {
+      this->~when_state();
+      ::operator delete(this);
+    }
+
+    static constexpr bool _decisive(const Result &r) noexcept { return Any ? r.has_value() : !r.has_value(); }
+    // Completes the group with the decisive result at idx
+    void _complete_with(size_t idx, std::false_type /*all*/) { _completion.emplace_error(static_cast<Result &&>(_result(idx)).assume_error()); }
+    void _complete_with(size_t idx, std::true_type /*any*/) { _completion.set(static_cast<Result &&>(_result(idx))); }
+    // Completes the group once every producer reported without any being decisive
+    template <class T> void _complete_all(std::false_type /*all*/, T * /*unused*/)
+    {
+      std::vector<T> ret;
+      ret.reserve(_size);
+      for(size_t i = 0; i < _size; i++)
+      {
+        ret.push_back(static_cast<Result &&>(_result(i)).assume_value());
+      }
+      _completion.emplace_value(static_cast<std::vector<T> &&>(ret));
+    }
+    void _complete_all(std::false_type /*all*/, void * /*unused*/) { _completion.emplace_value(); }
+    template <class T> void _complete_all(std::true_type /*any*/, T * /*unused*/)
+    {
+      // Every source failed, so report the failure of the first
+      _index = 0;
+      _completion.set(static_cast<Result &&>(_result(0)));
+    }
+    void _complete_all() { _complete_all(std::integral_constant<bool, Any>(), static_cast<typename Result::value_type *>(nullptr)); }
+#ifdef __cpp_exceptions
+    // Completes the decided group with the exception e, which the consumer rethrows
+    void _complete_with_exception(std::exception_ptr e) noexcept
+    {
+      _exception = static_cast<std::exception_ptr &&>(e);
+      _completion.emplace_error();
+    }
+    // If not yet decided, the group is decided by the exception e
+    void _decide_with_exception(std::exception_ptr e) noexcept
+    {
+      if((_count.fetch_or(_decided_bit, std::memory_order_acq_rel) & _decided_bit) == 0)
+      {
+        _complete_with_exception(static_cast<std::exception_ptr &&>(e));
+      }
+    }
+#endif
+    /* Completes the decided group by f, else with the exception it throws, as allocating the
+    vector of values or moving a value or error into the completion may throw. Either way the
+    completion is published, so a decided group is never left without a result.
+    */
+    template <class F> void _complete(F &&f) noexcept
+    {
+#ifdef __cpp_exceptions
+      try
+#endif
+      {
+        f();
+      }
+#ifdef __cpp_exceptions
+      catch(...)
+      {
+        _complete_with_exception(std::current_exception());
+      }
+#endif
+    }
+
+    void _release_producer() noexcept
+    {
+      size_t old = _count.load(std::memory_order_relaxed);
+      for(;;)
+      {
+        if(old / _producer_unit == 1 && (old & _decided_bit) == 0)
+        {
+          // The last producer of an undecided group decides it before letting go
+          if(_count.compare_exchange_weak(old, old | _decided_bit, std::memory_order_acq_rel, std::memory_order_relaxed))
+          {
+            _complete([this] { _complete_all(); });
+            old = _count.fetch_sub(_producer_unit, std::memory_order_acq_rel);
+            break;
+          }
+        }
+        else if(_count.compare_exchange_weak(old, old - _producer_unit, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      if(old / _producer_unit == 1 && (old & _consumer_bit) == 0)
+      {
+        _destroy();
+      }
+    }
+
+  public:
+    static when_state *create(size_t n)
+    {
+      void *p = ::operator new(_slots_offset() + n * sizeof(_slot));
+      auto *ret = new(p) when_state(n);
+      if(n == 0)
+      {
+        ret->_count.fetch_or(_decided_bit, std::memory_order_relaxed);
+        ret->_complete([ret] { ret->_complete_all(); });
+      }
+      return ret;
+    }
+    when_state(const when_state &) = delete;
+    when_state &operator=(const when_state &) = delete;
+
+    size_t size() const noexcept { return _size; }
+    size_t index() const noexcept { return _index; }
+    typename result_slot_for<result_type>::type &completion() noexcept { return _completion; }
+    bool cancelled() const noexcept { return (_count.load(std::memory_order_acquire) & _decided_bit) != 0; }
+    // Rethrows the exception which decided the group, if any. Only meaningful once completed.
+    void rethrow() const
+    {
+#ifdef __cpp_exceptions
+      if(_exception)
+      {
+        std::rethrow_exception(_exception);
+      }
+#endif
+    }
+
+    template <class U> void set(size_t idx, U &&r)
+    {
+      assert(idx < _size);
+      // The producer is released however this returns
+      struct release_producer
+      {
+        when_state *self;
+        ~release_producer() { self->_release_producer(); }
+      } _{this};
+      // Once decided, further results are discarded
+      if(!cancelled())
+      {
+#ifdef __cpp_exceptions
+        try
+#endif
+        {
+          new(_slots()[idx].storage) Result(static_cast<U &&>(r));  // NOLINT
+        }
+#ifdef __cpp_exceptions
+        catch(...)
+        {
+          _decide_with_exception(std::current_exception());
+          throw;
+        }
+#endif
+        _slots()[idx].filled = true;
+        if(_decisive(_result(idx)) && (_count.fetch_or(_decided_bit, std::memory_order_acq_rel) & _decided_bit) == 0)
+        {
+          _index = idx;
+          _complete([this, idx] { _complete_with(idx, std::integral_constant<bool, Any>()); });
+        }
+      }
+    }
+#ifdef __cpp_exceptions
+    void set_exception(std::exception_ptr e) noexcept
+    {
+      _decide_with_exception(static_cast<std::exception_ptr &&>(e));
+      _release_producer();
+    }
+#endif
+    // If not yet decided, the group is cancelled without a result
+    void discard() noexcept
+    {
+      _count.fetch_or(_decided_bit, std::memory_order_acq_rel);
+      _release_producer();
+    }
+    // The consumer letting go also cancels any remaining producers
+    void release_consumer() noexcept
+    {
+      size_t old = _count.load(std::memory_order_relaxed);
+      while(!_count.compare_exchange_weak(old, (old | _decided_bit) & ~_consumer_bit, std::memory_order_acq_rel, std::memory_order_relaxed))
+      {
+      }
+      if(old / _producer_unit == 0)
+      {
+        _destroy();
+      }
+    }
+  };
+}  // namespace detail
+
+/*! A group of `size()` producers each delivering one `Result`, which is decided by the first
+failure (`when_all_group`) or the first success (`when_any_group`) to be delivered, or else
+once every producer has delivered. Result storage for every producer is allocated once, in
+the same allocation as the group's state, and completion is tracked by a single atomic word.
+
+Once decided, `cancelled()` becomes true for every producer, and any further results delivered
+are discarded. Producers which observe `cancelled()` may call `discard()` instead of `set()`.
+Every producer must call exactly one of `set()` or `discard()`, and the shared state is only
+freed once they have, so dropping the group early is always safe. If the construction of a
+result in `set()` throws, or a producer calls `set_exception()`, the group is decided by that
+exception if it was not already, as it is if making the result of the group throws. `wait()`,
+`take()`, `try_get()` and `co_await` then rethrow it. The default constructor of the error type
+must not throw, as it is used to complete the group in that case.
+
+The consumer may poll with `try_get()`, block with `wait()`, or `co_await` the group.
+*/
+template <class Result, bool Any> class basic_when_group
+{
+  using _state_type = detail::when_state<Result, Any>;
+  _state_type *_state;
+
+  static _state_type *_create(size_t n)
+  {
+    if(Any && n == 0)
+    {
+      OUTCOME_THROW_EXCEPTION(std::invalid_argument("a when_any_group needs at least one producer"));
+    }
+    return _state_type::create(n);
+  }
+
+public:
+  //! The type of the individual results delivered by producers.
+  using source_type = Result;
+  //! The type of the result of the group.
+  using result_type = typename _state_type::result_type;
+
+  //! The interface given to producers.
+  class producer
+  {
+    _state_type *_state;
+
+  public:
+    explicit producer(_state_type *state) noexcept
+        : _state(state)
+    {
+    }
+    //! True if the group has been decided, so no more results are wanted.
+    bool cancelled() const noexcept { return _state->cancelled(); }
+    //! Delivers the result of producer `idx`, constructing it in place from `r`.
+    template <class U> void set(size_t idx, U &&r) { _state->set(idx, static_cast<U &&>(r)); }
+    /*! Reports that a producer will not deliver a result. If the group has not been decided,
+    this cancels it, and its result never becomes available.
+    */
+    void discard() noexcept { _state->discard(); }
+#ifdef __cpp_exceptions
+    /*! Reports that a producer failed with the exception `e` instead of delivering a result. If
+    the group has not been decided, this decides it, and the consumer rethrows `e`.
+    */
+    void set_exception(std::exception_ptr e) noexcept { _state->set_exception(static_cast<std::exception_ptr &&>(e)); }
+#endif
+  };
+
+  /*! Constructs a group of `n` producers.
+  \throws `std::invalid_argument` if a `when_any_group` is given no producers, as it could never be decided.
+  */
+  explicit basic_when_group(size_t n)
+      : _state(_create(n))
+  {
+  }
+  basic_when_group(const basic_when_group &) = delete;
+  basic_when_group(basic_when_group &&o) noexcept
+      : _state(o._state)
+  {
+    o._state = nullptr;
+  }
+  basic_when_group &operator=(const basic_when_group &) = delete;
+  basic_when_group &operator=(basic_when_group &&o) noexcept
+  {
+    if(this != &o)
+    {
+      this->~basic_when_group();
+      new(this) basic_when_group(static_cast<basic_when_group &&>(o));
+    }
+    return *this;
+  }
+  //! Cancels any remaining producers.
+  ~basic_when_group()
+  {
+    if(_state != nullptr)
+    {
+      _state->release_consumer();
+    }
+  }
+
+  //! The number of producers.
+  size_t size() const noexcept { return _state->size(); }
+  //! The producer interface.
+  producer get_producer() const noexcept { return producer(_state); }
+  //! True if the group has been decided.
+  bool cancelled() const noexcept { return _state->cancelled(); }
+  //! The index of the producer whose result decided the group. Only meaningful once `ready()`.
+  size_t index() const noexcept { return _state->index(); }
+
+  //! True if the result of the group is available.
+  bool ready() const noexcept { return _state->completion().ready(); }
+  //! Returns the result of the group if available, else null. Never blocks.
+  result_type *try_get()
+  {
+    result_type *ret = _state->completion().try_get();
+    if(ret != nullptr)
+    {
+      _state->rethrow();
+    }
+    return ret;
+  }
+  //! Blocks until the result of the group is available.
+  result_type &wait(unsigned spins = 4096)
+  {
+    result_type &ret = _state->completion().wait(spins);
+    _state->rethrow();
+    return ret;
+  }
+  //! Blocks until the result of the group is available, then moves it out.
+  result_type take(unsigned spins = 4096)
+  {
+    wait(spins);
+    return _state->completion().take(spins);
+  }
+#if OUTCOME_HAVE_COROUTINES
+  //! The awaitable of the result of the group, rethrowing any exception which decided it.
+  class awaitable
+  {
+    _state_type *_state;
+    decltype(std::declval<_state_type &>().completion().operator co_await()) _completion;
+
+  public:
+    explicit awaitable(_state_type *state) noexcept
+        : _state(state)
+        , _completion(state->completion().operator co_await())
+    {
+    }
+    bool await_ready() const noexcept { return _completion.await_ready(); }
+    bool await_suspend(detail::coroutine_handle<> h) noexcept { return _completion.await_suspend(h); }
+    result_type &await_resume()
+    {
+      _state->rethrow();
+      return _completion.await_resume();
+    }
+  };
+  awaitable operator co_await() noexcept { return awaitable(_state); }
+#endif
+};
+
+/*! A `basic_when_group` decided by the first failure, whose result is a `basic_result`
+of a `std::vector` of every value in producer order (`void` if the values are `void`).
+*/
+template <class Result> using when_all_group = basic_when_group<Result, false>;
+/*! A `basic_when_group` decided by the first success, whose result is that success, else
+the failure delivered by the first producer.
+*/
+template <class Result> using when_any_group = basic_when_group<Result, true>;
+
+namespace detail
+{
+  // Sources with a std::future like interface
+  template <class F> inline auto when_source_ready(F &f) -> decltype(f.wait_for(std::chrono::seconds(0)) == decltype(f.wait_for(std::chrono::seconds(0)))::ready)
+  {
+    using status = decltype(f.wait_for(std::chrono::seconds(0)));
+    return f.wait_for(std::chrono::seconds(0)) == status::ready;
+  }
+  template <class F> inline auto when_source_get(F &f) -> decltype(f.get()) { return f.get(); }
+  // Result slots
+  template <class R, class S, class P> inline bool when_source_ready(basic_result_slot<R, S, P> &s) noexcept { return s.ready(); }
+  template <class R, class S, class P> inline basic_result<R, S, P> when_source_get(basic_result_slot<R, S, P> &s) { return s.take(); }
+
+  template <class It> using when_source_result_t = std::decay_t<decltype(when_source_get(*std::declval<It>()))>;
+
+  template <class Group, class It> inline typename Group::result_type when_poll(It first, It last)
+  {
+    const auto n = static_cast<size_t>(std::distance(first, last));
+    Group group(n);
+    auto producer = group.get_producer();
+    std::unique_ptr<bool[]> pending(new bool[n]);
+    for(size_t i = 0; i < n; i++)
+    {
+      pending[i] = true;
+    }
+    {
+      // The producers not yet handed to set() are discarded, even if a source throws
+      size_t remaining = n;
+      struct discard_remaining
+      {
+        decltype(producer) &p;
+        size_t &count;
+        ~discard_remaining()
+        {
+          for(; count > 0; --count)
+          {
+            p.discard();
+          }
+        }
+      } _{producer, remaining};
+      while(remaining > 0 && !producer.cancelled())
+      {
+        bool progress = false;
+        It it = first;
+        for(size_t i = 0; i < n && !producer.cancelled(); i++, ++it)
+        {
+          if(pending[i] && when_source_ready(*it))
+          {
+            pending[i] = false;
+            progress = true;
+            auto &&r = when_source_get(*it);
+            // set() releases the producer even if it throws
+            --remaining;
+            producer.set(i, static_cast<decltype(r) &&>(r));
+          }
+        }
+        if(!progress)
+        {
+          std::this_thread::yield();
+        }
+      }
+    }
+    return group.take();
+  }
+}  // namespace detail
+
+/*! Waits upon every source in `[first, last)`, each of which is either a `basic_result_slot`
+or has a `std::future` like `wait_for()` and `get()` returning a `basic_result<T, E, P>`,
+returning early on the first failure. Sources are polled, with the calling thread yielding
+between passes where nothing became ready, and sources still pending once a failure is seen
+are left alone.
+
+\returns A `basic_result<std::vector<T>, E, P>` (`basic_result<void, E, P>` if `T` is `void`)
+holding every value in source order, or the first failure seen.
+*/
+template <class It> inline typename when_all_group<detail::when_source_result_t<It>>::result_type when_all(It first, It last) { return detail::when_poll<when_all_group<detail::when_source_result_t<It>>>(first, last); }
+
+/*! Waits upon the sources in `[first, last)`, as per `when_all()`, returning early on the first
+success.
+
+\returns The first success seen, else the failure of the first source.
+\throws `std::invalid_argument` if `[first, last)` is empty.
+*/
+template <class It> inline typename when_any_group<detail::when_source_result_t<It>>::result_type when_any(It first, It last) { return detail::when_poll<when_any_group<detail::when_source_result_t<It>>>(first, last); }
+
+#if OUTCOME_HAVE_COROUTINES
+namespace detail
+{
+  /* The frames of the coroutines awaiting each source of a co_when_all() or co_when_any() are
+  carved from a single allocation, made when the first is created, as every frame of the same
+  coroutine has the same size. Frames of sources still being awaited once the group is decided
+  outlive the awaitable, so the allocation is freed once the arena and every frame have let go.
+  */
+  class when_frame_arena
+  {
+    struct _header
+    {
+      std::atomic<size_t> count;
+    };
+    static constexpr size_t _align = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    // Each frame is preceded by a pointer to the header
+    static constexpr size_t _prefix = (sizeof(_header *) + _align - 1) / _align * _align;
+    static constexpr size_t _round(size_t v) noexcept { return (v + _align - 1) / _align * _align; }
+
+    _header *_block{nullptr};
+    size_t _n, _used{0}, _slot_size{0};
+
+    static void _release(_header *h) noexcept
+    {
+      if(h->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        h->~_header();
+        ::operator delete(h);
+      }
+    }
+
+  public:
+    explicit when_frame_arena(size_t n) noexcept
+        : _n(n)
+    {
+    }
+    when_frame_arena(const when_frame_arena &) = delete;
+    when_frame_arena &operator=(const when_frame_arena &) = delete;
+    ~when_frame_arena()
+    {
+      if(_block != nullptr)
+      {
+        _release(_block);
+      }
+    }
+    void *allocate(size_t size)
+    {
+      if(_block == nullptr)
+      {
+        _slot_size = _prefix + _round(size);
+        _block = new(::operator new(_round(sizeof(_header)) + _n * _slot_size)) _header{{1}};
+      }
+      assert(_used < _n && _prefix + size <= _slot_size);
+      char *slot = reinterpret_cast<char *>(_block) + _round(sizeof(_header)) + _used++ * _slot_size;  // NOLINT
+      _block->count.fetch_add(1, std::memory_order_relaxed);
+      *reinterpret_cast<_header **>(slot + _prefix - sizeof(_header *)) = _block;  // NOLINT
+      return slot + _prefix;
+    }
+    static void deallocate(void *p) noexcept { _release(*reinterpret_cast<_header **>(static_cast<char *>(p) - sizeof(_header *))); }  // NOLINT
+  };
+
+  // A coroutine which runs eagerly, and cleans up after itself, with its frame in a when_frame_arena
+  struct when_task
+  {
+    struct promise_type
+    {
+      template <class... Args> static void *operator new(size_t size, when_frame_arena &arena, Args &... /*unused*/) { return arena.allocate(size); }
+      static void operator delete(void *p, size_t /*unused*/) noexcept { when_frame_arena::deallocate(p); }
+      when_task get_return_object() noexcept { return {}; }
+      OUTCOME_COROUTINE_NAMESPACE::suspend_never initial_suspend() noexcept { return {}; }
+      OUTCOME_COROUTINE_NAMESPACE::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() noexcept {}
+      // when_await_one() lets no exception escape
+      void unhandled_exception() noexcept { std::terminate(); }
+    };
+  };
+
+  template <class A> inline auto when_get_awaiter(A &a) -> decltype(a.operator co_await()) { return a.operator co_await(); }
+  template <class A> inline auto when_get_awaiter(A &a) -> decltype(a.await_resume(), a) { return a; }
+  template <class It> using when_awaitable_result_t = std::decay_t<decltype(when_get_awaiter(*std::declval<It>()).await_resume())>;
+
+  template <class Producer, class Result, class A> inline when_task when_await_one(when_frame_arena & /*unused*/, Producer producer, size_t idx, A &a)
+  {
+    if(producer.cancelled())
+    {
+      producer.discard();
+      co_return;
+    }
+#ifdef __cpp_exceptions
+    // If awaiting the source or converting its result throws, the group is decided by that
+    // exception, which the awaiting coroutine rethrows. If set() throws, it already has been.
+    bool delivering = false;
+    try
+    {
+      Result r(co_await a);
+      delivering = true;
+      producer.set(idx, static_cast<Result &&>(r));
+    }
+    catch(...)
+    {
+      if(!delivering)
+      {
+        producer.set_exception(std::current_exception());
+      }
+    }
+#else
+    producer.set(idx, Result(co_await a));
+#endif
+  }
+
+  template <class Group, class It> class when_awaitable
+  {
+    using _source_type = typename Group::source_type;
+    Group _group;
+    It _first;
+    when_frame_arena _frames;
+    // Waits upon the completion of the group, so must live as long as we are suspended
+    decltype(std::declval<Group &>().operator co_await()) _completion;
+
+  public:
+    when_awaitable(It first, It last)
+        : _group(static_cast<size_t>(std::distance(first, last)))
+        , _first(first)
+        , _frames(_group.size())
+        , _completion(_group.operator co_await())
+    {
+    }
+    bool await_ready() const noexcept { return _group.ready(); }
+    bool await_suspend(coroutine_handle<> h)
+    {
+      auto producer = _group.get_producer();
+      It it = _first;
+      for(size_t i = 0; i < _group.size(); i++, ++it)
+      {
+        when_await_one<decltype(producer), _source_type>(_frames, producer, i, *it);
+      }
+      return _completion.await_suspend(h);
+    }
+    typename Group::result_type await_resume() { return _group.take(); }
+  };
+}  // namespace detail
+
+/*! Returns an awaitable which, when awaited, awaits every awaitable in `[first, last)`
+concurrently, each of which must produce a `basic_result<T, E, P>`, and resumes the awaiting
+coroutine on the first failure, or once all have succeeded. If awaiting an awaitable, or converting
+what it produces into a result, throws before then, the awaiting coroutine is resumed and rethrows
+that exception instead. Awaitables not yet awaited once the group is decided are never awaited.
+Those already being awaited cannot be cancelled, so they must eventually complete, and must
+outlive their completion; their results are discarded.
+
+Each awaitable is awaited by a coroutine of its own, as awaiting needs a coroutine to resume,
+but the frames of those coroutines are carved from a single allocation.
+
+\returns As per `when_all()`.
+*/
+template <class It> inline detail::when_awaitable<when_all_group<detail::when_awaitable_result_t<It>>, It> co_when_all(It first, It last) { return {first, last}; }
+
+/*! As per `co_when_all()`, but resuming on the first success.
+\throws `std::invalid_argument` if `[first, last)` is empty.
+
+\returns As per `when_any()`.
+*/
+template <class It> inline detail::when_awaitable<when_any_group<detail::when_awaitable_result_t<It>>, It> co_when_any(It first, It last) { return {first, last}; }
+#endif
+
+OUTCOME_V2_NAMESPACE_END
+
+#endif
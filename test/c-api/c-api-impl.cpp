@@ -0,0 +1,63 @@
+/* The C++ half of the pure C unit testing for the C API of status codes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/experimental/status_code_c_api.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts allocations, which the POSIX domain makes for every message, so the test can check that cached messages do not allocate
+static std::atomic<int> allocations{0};
+void *operator new(std::size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if(void *ret = malloc(size))
+  {
+    return ret;
+  }
+  abort();
+}
+void *operator new(std::size_t size, const std::nothrow_t & /*unused*/) noexcept
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return malloc(size);
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, std::size_t /*unused*/) noexcept { free(p); }
+
+using namespace OUTCOME_V2_NAMESPACE::experimental;
+
+static cxx_status_code_system to_c(system_code &&sc)
+{
+  cxx_status_code_system ret;
+  memcpy(&ret, &sc, sizeof(ret));
+  new(&sc) system_code;  // the C struct now owns the code, and these codes are trivial anyway
+  return ret;
+}
+
+extern "C" cxx_status_code_system make_generic_code(int errcode) { return to_c(generic_code(static_cast<errc>(errcode))); }
+extern "C" cxx_status_code_system make_posix_code(int errcode) { return to_c(posix_code(errcode)); }
+extern "C" cxx_status_code_system make_empty_code(void) { return to_c(system_code()); }
+extern "C" int c_api_message_allocations(void) { return allocations.load(std::memory_order_relaxed); }
@@ -0,0 +1,107 @@
+/* Pure C unit testing for the C API of status codes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/experimental/result.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Implemented in C++ */
+extern struct cxx_status_code_system make_generic_code(int errcode);
+extern struct cxx_status_code_system make_posix_code(int errcode);
+extern struct cxx_status_code_system make_empty_code(void);
+extern int c_api_message_allocations(void);
+
+static int failures;
+
+#define CHECK(expr)                                                                                                                                                                                                                                                                                                            \
+  if(!(expr))                                                                                                                                                                                                                                                                                                                  \
+  {                                                                                                                                                                                                                                                                                                                            \
+    fprintf(stderr, "%s:%d CHECK FAILED: %s\n", __FILE__, __LINE__, #expr);                                                                                                                                                                                                                                                    \
+    ++failures;                                                                                                                                                                                                                                                                                                                \
+  }
+
+int main(void)
+{
+  char buffer[256], small[4];
+  struct cxx_status_code_system generic = make_generic_code(EINVAL), posix = make_posix_code(ENOENT), empty = make_empty_code();
+  size_t len;
+  int n, allocations;
+
+  /* Domain ids are stable */
+  CHECK(cxx_status_code_system_domain_id(&generic) == 0x746d6354f4f733e9ULL);
+  CHECK(cxx_status_code_system_domain_id(&posix) == 0xa59a56fe5f310933ULL);
+  CHECK(cxx_status_code_system_domain_id(&empty) == 0);
+
+  /* Domain names */
+  len = cxx_status_code_system_domain_name(&generic, buffer, sizeof(buffer));
+  CHECK(len == strlen("generic domain") && strcmp(buffer, "generic domain") == 0);
+  len = cxx_status_code_system_domain_name(&posix, buffer, sizeof(buffer));
+  CHECK(len == strlen("posix domain") && strcmp(buffer, "posix domain") == 0);
+  len = cxx_status_code_system_domain_name(&posix, small, sizeof(small));
+  CHECK(len == strlen("posix domain") && strcmp(small, "pos") == 0);
+  len = cxx_status_code_system_domain_name(&empty, buffer, sizeof(buffer));
+  CHECK(len == 0 && buffer[0] == 0);
+
+  /* Messages match strerror() for errno codes, and truncate like snprintf() */
+  len = cxx_status_code_system_message(&posix, buffer, sizeof(buffer));
+  CHECK(len == strlen(strerror(ENOENT)) && strcmp(buffer, strerror(ENOENT)) == 0);
+  len = cxx_status_code_system_message(&generic, buffer, sizeof(buffer));
+  CHECK(len == strlen(buffer) && len > 0);
+  len = cxx_status_code_system_message(&posix, small, sizeof(small));
+  CHECK(len == strlen(strerror(ENOENT)) && strlen(small) == 3 && strncmp(small, strerror(ENOENT), 3) == 0);
+  CHECK(cxx_status_code_system_message(&posix, NULL, 0) == strlen(strerror(ENOENT)));
+  CHECK(cxx_status_code_system_message(&empty, buffer, sizeof(buffer)) == 0);
+
+  /* Repeated messages come from the cache, so do not allocate */
+  allocations = c_api_message_allocations();
+  for(n = 0; n < 1000; n++)
+  {
+    cxx_status_code_system_message(&posix, buffer, sizeof(buffer));
+    cxx_status_code_system_message(&generic, buffer, sizeof(buffer));
+  }
+  CHECK(c_api_message_allocations() == allocations);
+  /* Whereas a message not yet cached does */
+  posix = make_posix_code(EACCES);
+  cxx_status_code_system_message(&posix, buffer, sizeof(buffer));
+  CHECK(c_api_message_allocations() > allocations);
+  CHECK(strcmp(buffer, strerror(EACCES)) == 0);
+  posix = make_posix_code(ENOENT);
+
+  /* Equivalence with errno values works across domains */
+  CHECK(cxx_status_code_system_equivalent_errno(&generic, EINVAL));
+  CHECK(!cxx_status_code_system_equivalent_errno(&generic, ENOENT));
+  CHECK(cxx_status_code_system_equivalent_errno(&posix, ENOENT));
+  CHECK(!cxx_status_code_system_equivalent_errno(&posix, EINVAL));
+  CHECK(!cxx_status_code_system_equivalent_errno(&empty, 0));
+
+  if(failures > 0)
+  {
+    fprintf(stderr, "FAILED with %d failures\n", failures);
+    return 1;
+  }
+  printf("PASSED\n");
+  return 0;
+}
@@ -0,0 +1,57 @@
+#!/usr/bin/python3
+# Check that no function calling status code domains checks a static initialisation guard
+#
+# File created: (C) 2019 Niall Douglas http://www.nedproductions.biz/
+# File created: Oct 2019
+#
+# Compiles status_code_domains.cpp for each C++ standard Outcome supports,
+# disassembles it, and fails if any function in it calls __cxa_guard_acquire,
+# which a status code domain, or its name() string, which is a function local
+# static rather than constant initialised would cause.
+#
+# Usage: CXXFLAGS=... check_static_init_guards.py [compiler ...]
+
+import sys
+import os
+import subprocess
+import tempfile
+import shlex
+
+import count_opcodes
+
+
+_standards_ = ["c++14", "c++17", "c++2a"]
+_guard_ = "__cxa_guard_acquire"
+
+
+def check(src_file : str, compiler : str, standard : str) -> list:
+    out_file = os.path.join(tempfile.gettempdir(), "check_static_init_guards." + compiler.replace("/", "_") + "." + standard)
+    print("[*] Compiling '" + src_file + "' with " + compiler + " -std=" + standard + "...", file=sys.stderr)
+    subprocess.check_output([compiler, "-std=" + standard, "-DNDEBUG", "-O3"] + shlex.split(os.environ.get("CXXFLAGS", "")) + [src_file, "-o", out_file],
+                            stderr=subprocess.STDOUT, universal_newlines=True)
+    asm = subprocess.check_output(["objdump", "-C", "-d", out_file], universal_newlines=True)
+    os.remove(out_file)
+    functions = count_opcodes.parse(asm.splitlines(), "objdump")
+    return sorted(name for name, ops in functions.items() if not name.startswith(_guard_) and any(("<" + _guard_) in op for op in ops))
+
+
+compilers = sys.argv[1:] if len(sys.argv) > 1 else ["g++", "clang++"]
+here = os.path.dirname(os.path.abspath(__file__))
+failed = False
+for compiler in compilers:
+    for standard in _standards_:
+        try:
+            guarded = check(os.path.join(here, "status_code_domains.cpp"), compiler, standard)
+        except OSError as e:
+            print("[-] Skipping " + compiler + ": " + str(e), file=sys.stderr)
+            break
+        except subprocess.CalledProcessError as e:
+            print("[-] " + compiler + " -std=" + standard + " failed to compile:\n" + e.output)
+            failed = True
+            continue
+        for name in guarded:
+            print("[-] " + compiler + " -std=" + standard + ": " + name + " calls " + _guard_)
+            failed = True
+        if not guarded:
+            print("[+] " + compiler + " -std=" + standard + ": no calls to " + _guard_)
+sys.exit(1 if failed else 0)
@@ -56,6 +56,15 @@ limits = {
 "min_option_next"                              : { 'gcc' :  5, 'clang' :  5, 'msvc' :  5 },
 "min_result_construct_value_move_destruct"     : { 'gcc' :  5, 'clang' :  5, 'msvc' :  5 },
 "min_result_next"                              : { 'gcc' :  5, 'clang' :  5, 'msvc' :  5 },
+"min_std_result_get_value"                     : { 'gcc' : 10, 'clang' : 10 },
+}
+
+#
+# Contains upper bounds on number of ops in the cold parts split out of test1,
+# in the same format as limits
+#
+cold_limits = {
+"min_std_result_get_value"                     : { 'gcc' : 10 },
 }
 
 
@@ -121,6 +130,7 @@ def test_single(func : str, src_file : str, compiler : str, indent : int):
     if count == -1:
         print("[-] No call to " + func + " found.", file=sys.stderr)
         sys.exit(0)
+    cold_count = count_opcodes.count_cold_opcodes(asm_file, func)
     try:
         os.remove(asm_file)
     except OSError as e:
@@ -132,6 +142,9 @@ def test_single(func : str, src_file : str, compiler : str, indent : int):
     if test_name in limits and compiler in limits[test_name] and limits[test_name][compiler] < count:
         xml_string += '  '*(indent+1) + '<failure message="Opcodes generated ' + \
             str(count) + ' exceeds limit ' + str(limits[test_name][compiler]) + '"/>\n'
+    if test_name in cold_limits and compiler in cold_limits[test_name] and cold_limits[test_name][compiler] < cold_count:
+        xml_string += '  '*(indent+1) + '<failure message="Cold opcodes generated ' + \
+            str(cold_count) + ' exceeds limit ' + str(cold_limits[test_name][compiler]) + '"/>\n'
     xml_string += '  '*(indent+2) + '<system-out>\n' + output + '\n' + \
                   '  '*(indent+2) + '</system-out>\n' + \
                   '  '*indent + '</testcase>\n'
@@ -57,13 +57,13 @@ _get_function_name_ = \
     }
 
 _is_instruction_ = \
-    { # ---> at least 2 spaces
+    { # ---> at least 1 space (objdump pads addresses to 4 digits)
       # ---> address, i.e. some HEX numbers
       # ---> colon :
       # ---> more HEX numbers and spaces
       # ---> asm instruction, i.e. a word of latin characters
       # ---> arguments
-      'objdump' : lambda l: re.match(r"^[ ]{2,}[0-9a-f]+:\s*[0-9a-f ]+\s+[a-z]+.*$", l) \
+      'objdump' : lambda l: re.match(r"^[ ]+[0-9a-f]+:\s*[0-9a-f ]+\s+[a-z]+.*$", l) \
                                 is not None 
 
       # the same, except that the line starts with exactly two spaces
@@ -87,10 +87,17 @@ _get_call_target_ = \
     }
 
 _is_our_function_ = \
-    { 'objdump' : lambda f: lambda l: (f in l) and ('-0x' not in l)
+    { 'objdump' : lambda f: lambda l: (f in l) and ('-0x' not in l) and not _is_cold_part_['objdump'](l)
     , 'dumpbin' : lambda f: lambda l: (f in l) and ('?dtor' not in l)
     }
 
+# GCC moves the paths of a function which only lead to cold code, such as
+# throwing an exception, into a separate "[clone .cold]" part in .text.unlikely
+_is_cold_part_ = \
+    { 'objdump' : lambda l: '[clone .cold' in l or l.endswith('.cold')
+    , 'dumpbin' : lambda l: False
+    }
+
 
 def parse(input_file : str, file_type : str) -> dict:
     functions = {}
@@ -216,4 +223,14 @@ def count_opcodes(input_file : str, func : str):
     is_normal = _is_normal_instruction_[file_type]
     count = sum(map(is_normal, opcodes))
 
-    return count, opcodes
\ No newline at end of file
+    return count, opcodes
+
+def count_cold_opcodes(input_file : str, func : str) -> int:
+    """Returns the number of opcodes in the cold parts split out of func"""
+    file_type = 'objdump' if os.name == 'posix' else 'dumpbin'
+    with open(input_file, "rt") as ih:
+        functions = parse(ih, file_type)
+    is_cold = _is_cold_part_[file_type]
+    is_normal = _is_normal_instruction_[file_type]
+    return sum(sum(map(is_normal, opcodes)) for name, opcodes in functions.items()
+               if is_cold(name) and name.startswith(func + '('))
@@ -0,0 +1,116 @@
+/* Canned codegen quality test sequences
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* The domains which status codes refer to must be constant initialised, so calling their
+functions never checks a static initialisation guard. check_static_init_guards.py compiles
+this file and fails if any function in it calls __cxa_guard_acquire.
+*/
+
+#include "../../include/outcome/experimental/status_code_constant_domain.hpp"
+#include "../../include/outcome/experimental/status_code_from_enum.hpp"
+
+#include <cstring>
+
+using namespace OUTCOME_V2_NAMESPACE::experimental;
+
+enum class custom_enum
+{
+  success,
+  failure
+};
+namespace OUTCOME_V2_NAMESPACE
+{
+  namespace experimental
+  {
+    template <> struct enum_status_code_traits<custom_enum>
+    {
+      static constexpr const char *domain_name = "custom_enum";
+      static constexpr unsigned long long domain_id = 0x5b3a9fd1c6e27048;
+      static constexpr enum_status_code_mapping<custom_enum> mappings[] = {
+      {custom_enum::success, "success", errc::success},  //
+      {custom_enum::failure, "failure", errc::invalid_argument}};
+    };
+#if __cplusplus < 201700L && (!defined(_MSVC_LANG) || _MSVC_LANG < 201700L)
+    constexpr enum_status_code_mapping<custom_enum> enum_status_code_traits<custom_enum>::mappings[];
+#endif
+  }  // namespace experimental
+}  // namespace OUTCOME_V2_NAMESPACE
+
+class _custom_domain;
+using custom_code = status_code<_custom_domain>;
+class _custom_domain final : public constant_status_code_domain<_custom_domain>
+{
+  template <class> friend class SYSTEM_ERROR2_NAMESPACE::status_code;
+  using _base = constant_status_code_domain<_custom_domain>;
+
+public:
+  using value_type = int;
+  static constexpr const char *domain_name = "custom domain";
+
+  constexpr _custom_domain() noexcept : _base(0x9f1e4a0c73b2d685) {}
+
+protected:
+  virtual bool _do_failure(const status_code<void> &code) const noexcept override final { return static_cast<const custom_code &>(code).value() != 0; }  // NOLINT
+  virtual bool _do_equivalent(const status_code<void> &code1, const status_code<void> &code2) const noexcept override final  // NOLINT
+  {
+    return code2.domain() == *this && static_cast<const custom_code &>(code1).value() == static_cast<const custom_code &>(code2).value();  // NOLINT
+  }
+  virtual generic_code _generic_code(const status_code<void> &code) const noexcept override final  // NOLINT
+  {
+    return static_cast<const custom_code &>(code).value() != 0 ? generic_code(errc::invalid_argument) : generic_code(errc::success);  // NOLINT
+  }
+  virtual string_ref _do_message(const status_code<void> &code) const noexcept override final  // NOLINT
+  {
+    return string_ref(static_cast<const custom_code &>(code).value() != 0 ? "failure" : "success");  // NOLINT
+  }
+  SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> & /*unused*/) const override final { abort(); }  // NOLINT
+};
+
+extern QUICKCPPLIB_NOINLINE size_t test1(const generic_code &a, const generic_code &b)
+{
+  return a.message().size() + a.equivalent(b);
+}
+extern QUICKCPPLIB_NOINLINE size_t test2(const posix_code &a, const generic_code &b)
+{
+  return a.message().size() + a.equivalent(b);
+}
+extern QUICKCPPLIB_NOINLINE size_t test3(const system_code &a, const system_code &b)
+{
+  return a.message().size() + a.equivalent(b) + strlen(a.domain().name().c_str());
+}
+extern QUICKCPPLIB_NOINLINE size_t test4(const enum_status_code<custom_enum> &a, const generic_code &b)
+{
+  return a.message().size() + a.equivalent(b) + strlen(a.domain().name().c_str());
+}
+extern QUICKCPPLIB_NOINLINE size_t test5(const custom_code &a, const system_code &b)
+{
+  return a.message().size() + a.equivalent(b) + strlen(a.domain().name().c_str());
+}
+
+int main(void)
+{
+  generic_code g(errc::invalid_argument);
+  posix_code p(EINVAL);
+  size_t n = test1(g, g) + test2(p, g) + test3(p, g) + test4(enum_status_code<custom_enum>(in_place, custom_enum::failure), g) + test5(custom_code(in_place, 1), system_code(custom_code(in_place, 1)));
+  return n == 0;
+}
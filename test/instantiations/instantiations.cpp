@@ -0,0 +1,55 @@
+/* Unit testing for the compiled library of explicit instantiations
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/instantiations.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+// Linked against outcome_instantiations, so the member functions used here are not instantiated in this translation unit
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / instantiations, "Tests that the extern template results and outcomes link against the compiled instantiations")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  result<int> a(5), b(make_error_code(std::errc::invalid_argument));
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(b.error() == std::errc::invalid_argument);
+  BOOST_CHECK(!b.has_value() && b.has_error() && b.has_failure());
+  result<void> c(success());
+  BOOST_CHECK(c.has_value());
+  c.value();
+  result<std::string> d("niall");
+  BOOST_CHECK(d.value() == "niall");
+  BOOST_CHECK(std::move(d).assume_value() == "niall");
+  outcome<int> e(b.error());
+  BOOST_CHECK(e.error() == std::errc::invalid_argument);
+  BOOST_CHECK(!e.has_exception());
+#ifdef __cpp_exceptions
+  BOOST_CHECK_THROW(e.value(), std::system_error);
+  outcome<std::string> f(std::make_exception_ptr(std::runtime_error("hi")));
+  BOOST_CHECK(f.has_exception());
+  BOOST_CHECK_THROW(f.value(), std::runtime_error);
+#endif
+  experimental::status_result<int> g(experimental::errc::invalid_argument);
+  BOOST_CHECK(g.error() == experimental::errc::invalid_argument);
+  experimental::status_outcome<void> h(experimental::success());
+  BOOST_CHECK(h.has_value());
+}
@@ -0,0 +1,112 @@
+/* Unit testing for importing Outcome as a C++ Module
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+// The standard library is not exported by the module, so include what is used before the import
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <system_error>
+
+import outcome;
+
+#include "../../include/outcome/try_macros.hpp"
+
+static int failures;
+
+#define CHECK(expr)                                                                                                                                                                                                                                                                                                            \
+  if(!(expr))                                                                                                                                                                                                                                                                                                                  \
+  {                                                                                                                                                                                                                                                                                                                            \
+    fprintf(stderr, "%s:%d CHECK FAILED: %s\n", __FILE__, __LINE__, #expr);                                                                                                                                                                                                                                                    \
+    ++failures;                                                                                                                                                                                                                                                                                                                \
+  }
+
+using namespace OUTCOME_V2_NAMESPACE;
+
+static result<int> parse(const std::string &s)
+{
+  if(s.empty() || s[0] < '0' || s[0] > '9')
+  {
+    return std::errc::invalid_argument;
+  }
+  return s[0] - '0';
+}
+
+static result<int> twice(const std::string &s)
+{
+  OUTCOME_TRY(v, parse(s));
+  return v * 2;
+}
+
+static outcome<std::string> describe(const std::string &s)
+{
+  OUTCOME_TRY(v, twice(s));
+  return std::to_string(v);
+}
+
+#if !defined(OUTCOME_MODULE_DISABLE_EXPERIMENTAL)
+static experimental::status_result<int> checked(int v)
+{
+  if(v < 0)
+  {
+    return experimental::generic_code(experimental::errc::invalid_argument);
+  }
+  return v;
+}
+
+static experimental::status_outcome<int> checked_twice(int v)
+{
+  OUTCOME_TRY(r, checked(v));
+  return r * 2;
+}
+#endif
+
+int main()
+{
+  CHECK(twice("4").value() == 8);
+  CHECK(twice("x").error() == std::errc::invalid_argument);
+  CHECK(describe("3").value() == "6");
+  CHECK(describe("").error() == std::errc::invalid_argument);
+  CHECK(!describe("").has_exception());
+  result<void> v(success());
+  CHECK(v.has_value() && !v.has_error());
+  outcome<int> o(failure(std::make_error_code(std::errc::io_error)));
+  CHECK(o.has_error() && o.error() == std::errc::io_error);
+#ifdef __cpp_exceptions
+  try
+  {
+    o.value();
+    CHECK(false);
+  }
+  catch(const std::system_error &e)
+  {
+    CHECK(e.code() == std::errc::io_error);
+  }
+#endif
+#if !defined(OUTCOME_MODULE_DISABLE_EXPERIMENTAL)
+  CHECK(checked_twice(5).value() == 10);
+  CHECK(checked_twice(-1).has_error());
+  CHECK(checked_twice(-1).error().value() == EINVAL);
+#endif
+  return failures != 0;
+}
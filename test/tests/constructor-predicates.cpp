@@ -0,0 +1,104 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#if OUTCOME_USE_CXX_CONCEPTS
+namespace constructor_predicates_test
+{
+  namespace detail = OUTCOME_V2_NAMESPACE::detail;
+  // The predicates of basic_outcome subsume those of basic_result, so these overloads are not ambiguous
+  template <class T>
+  requires detail::result_value_converting_constructible<int, std::error_code, T>
+  constexpr int which() { return 1; }
+  template <class T>
+  requires detail::outcome_value_converting_constructible<int, std::error_code, std::exception_ptr, T>
+  constexpr int which() { return 2; }
+  static_assert(which<int>() == 2, "");
+  static_assert(which<short>() == 2, "");
+}  // namespace constructor_predicates_test
+#endif
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / constructor - predicates, "Tests that the constructor predicates choose the same constructors with and without C++ Concepts")
+{
+  namespace out = OUTCOME_V2_NAMESPACE;
+  struct udt
+  {
+    int a{0};
+    explicit udt(int v)
+        : a(v)
+    {
+    }
+    udt() = default;
+  };
+  enum class errc2
+  {
+    einval = EINVAL
+  };
+  using result_int = out::result<int>;
+  using result_udt = out::result<udt>;
+  using result_int_long = out::result<int, long>;
+  using result_string = out::result<std::string>;
+  using outcome_int = out::outcome<int>;
+
+  // Value converting constructor, only where unambiguous
+  static_assert(std::is_convertible<int, result_int>::value, "");
+  static_assert(std::is_convertible<short, result_int>::value, "");
+  static_assert(std::is_convertible<const char *, result_string>::value, "");
+  static_assert(!std::is_convertible<int, result_udt>::value, "");
+  static_assert(!std::is_convertible<int, result_int_long>::value, "");
+  static_assert(!std::is_constructible<result_int_long, int>::value, "");
+  static_assert(std::is_convertible<int, outcome_int>::value, "");
+
+  // Error converting constructor, and the error condition converting constructor from error code enums
+  static_assert(std::is_convertible<std::error_code, result_int>::value, "");
+  static_assert(std::is_convertible<std::errc, result_int>::value, "");
+  static_assert(!std::is_convertible<errc2, result_int>::value, "");
+  static_assert(std::is_convertible<std::error_code, outcome_int>::value, "");
+
+  // In place construction, implicit only where unambiguous
+  static_assert(std::is_constructible<result_udt, out::in_place_type_t<udt>, int>::value, "");
+  static_assert(std::is_constructible<result_int, out::in_place_type_t<std::error_code>, int, const std::error_category &>::value, "");
+  static_assert(!std::is_constructible<result_udt, int>::value, "");
+  static_assert(std::is_constructible<result_int, int, const std::error_category &>::value, "");
+  static_assert(!std::is_constructible<result_int, out::in_place_type_t<std::string>>::value, "");
+
+  // Compatible conversion is explicit
+  static_assert(std::is_constructible<out::result<long>, result_int>::value, "");
+  static_assert(!std::is_convertible<result_int, out::result<long>>::value, "");
+  static_assert(!std::is_constructible<result_int, out::result<std::string>>::value, "");
+  static_assert(std::is_constructible<outcome_int, result_int>::value, "");
+
+  // And the constructors chosen put the input where expected
+  result_int a(5), b(std::errc::invalid_argument), c(EINVAL, std::generic_category());
+  BOOST_CHECK(a.has_value() && a.value() == 5);
+  BOOST_CHECK(b.has_error() && b.error() == std::errc::invalid_argument);
+  BOOST_CHECK(c.has_error() && c.error() == std::errc::invalid_argument);
+  result_udt d(out::in_place_type<udt>, 5);
+  BOOST_CHECK(d.has_value() && d.value().a == 5);
+  outcome_int e(std::make_exception_ptr(5));
+  BOOST_CHECK(e.has_exception());
+  out::result<long> f(a);
+  BOOST_CHECK(f.has_value() && f.value() == 5);
+}
@@ -0,0 +1,129 @@
+/* Unit testing for the error provenance of error_provenance.hpp
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#define OUTCOME_ENABLE_ERROR_PROVENANCE 1
+#define OUTCOME_ERROR_PROVENANCE_ENTRIES 64
+
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+namespace error_provenance_test
+{
+  namespace oc = OUTCOME_V2_NAMESPACE;
+  using result = oc::result<int, std::error_code>;
+  using outcome = oc::outcome<int, std::error_code>;
+
+  inline result origin(int x)
+  {
+    if(x < 0)
+    {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    return x;
+  }
+  inline result middle(int x)
+  {
+    OUTCOME_TRY(v, origin(x));
+    return v + 1;
+  }
+  inline outcome top(int x)
+  {
+    OUTCOME_TRY(v, middle(x));
+    return v + 1;
+  }
+
+  // Not a result nor an outcome, so has no provenance
+  struct unhooked
+  {
+    bool failed{false};
+    unhooked() = default;
+    unhooked(oc::failure_type<std::error_code> && /*unused*/)
+        : failed(true)
+    {
+    }
+  };
+  inline unhooked into_unhooked(int x)
+  {
+    OUTCOME_TRYV(origin(x));
+    return {};
+  }
+}  // namespace error_provenance_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / error_provenance, "Tests that error provenance records where failures originated and the OUTCOME_TRY they passed through")
+{
+  using namespace error_provenance_test;
+  const void *call_sites[8];
+
+  // Successes have no provenance, and record nothing
+  const uint32_t recorded = oc::error_provenance().recorded();
+  result s = top(5).value();
+  BOOST_CHECK(s.value() == 7);
+  BOOST_CHECK(oc::hooks::spare_storage(&s) == 0);
+  BOOST_CHECK(oc::error_provenance_backtrace(s, call_sites, 8) == 0);
+  BOOST_CHECK(oc::error_provenance().recorded() == recorded);
+
+  // A failure has one entry for where it originated
+  result e = origin(-1);
+  BOOST_REQUIRE(oc::hooks::spare_storage(&e) != 0);
+  BOOST_REQUIRE(oc::error_provenance_backtrace(e, call_sites, 8) == 1);
+  BOOST_CHECK(call_sites[0] != nullptr);
+  BOOST_CHECK(oc::error_provenance()[oc::hooks::spare_storage(&e)].previous == 0);
+
+  // Each OUTCOME_TRY it passes through adds an entry before it, including into an outcome
+  outcome o = top(-1);
+  BOOST_CHECK(o.error() == std::errc::invalid_argument);
+  BOOST_REQUIRE(oc::error_provenance_backtrace(o, call_sites, 8) == 3);
+  BOOST_CHECK(call_sites[0] != nullptr);
+  BOOST_CHECK(call_sites[1] != nullptr);
+  BOOST_CHECK(call_sites[2] != nullptr);
+  BOOST_CHECK(oc::error_provenance_backtrace(o, call_sites, 2) == 2);
+  // The hops were taken by the failures returned, so the next failure originates afresh
+  BOOST_CHECK(oc::error_provenance_backtrace(origin(-2), call_sites, 8) == 1);
+
+  // The hop of an OUTCOME_TRY returning into anything else is discarded, not taken by the next failure
+  BOOST_CHECK(into_unhooked(-3).failed);
+  result e2 = origin(-4);
+  BOOST_CHECK(oc::error_provenance_backtrace(e2, call_sites, 8) == 1);
+  BOOST_CHECK(oc::error_provenance()[oc::hooks::spare_storage(&e2)].previous == 0);
+
+  // Copies and compatible conversions keep the provenance
+  outcome o2(o);
+  BOOST_CHECK(oc::hooks::spare_storage(&o2) == oc::hooks::spare_storage(&o));
+  oc::outcome<long, std::error_code> o3(o);
+  BOOST_CHECK(oc::hooks::spare_storage(&o3) == oc::hooks::spare_storage(&o));
+
+  // When the table wraps, indices stay valid and backtraces end
+  for(int n = 0; n < 200; n++)
+  {
+    auto r = middle(-n - 1);
+    BOOST_CHECK(oc::hooks::spare_storage(&r) != 0);
+    BOOST_CHECK(oc::hooks::spare_storage(&r) < OUTCOME_ERROR_PROVENANCE_ENTRIES);
+    BOOST_CHECK(oc::error_provenance_backtrace(r, call_sites, 8) == 2);
+  }
+
+  // Constant evaluation is unaffected
+  static constexpr oc::result<int, long, oc::policy::terminate> c(oc::in_place_type<int>, 5), d(oc::in_place_type<long>, 6L);
+  static_assert(c.value() == 5, "");
+  static_assert(d.error() == 6L, "");
+}
@@ -0,0 +1,130 @@
+/* Unit testing for batches of results in the C API
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/experimental/status_result_batch.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+CXX_DECLARE_RESULT_BATCH_SYSTEM(test_batch, int);
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / c_api / batch, "Tests that batches of results are laid out as the C API expects")
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  std::vector<status_result<int>> results;
+  for(int n = 0; n < 200; n++)
+  {
+    if(n % 7 == 3)
+    {
+      results.emplace_back(generic_code(errc::invalid_argument));
+    }
+    else if(n == 151)
+    {
+      results.emplace_back(posix_code(EIO));
+    }
+    else
+    {
+      results.emplace_back(n);
+    }
+  }
+  status_result_batch<int> batch(std::move(results));
+  BOOST_CHECK(batch.count() == 200);
+  BOOST_CHECK(batch.error_count() == 30);
+
+  // C can walk the successes and failures
+  CXX_RESULT_BATCH_SYSTEM(test_batch) b = batch.c_view<CXX_RESULT_BATCH_SYSTEM(test_batch)>();
+  BOOST_CHECK(b.count == 200);
+  BOOST_CHECK(b.error_count == 30);
+  size_t failures = 0;
+  CXX_RESULT_BATCH_FOR_EACH_FAILURE(b, idx, erroridx)
+  {
+    BOOST_CHECK(!CXX_RESULT_BATCH_HAS_VALUE(b, idx));
+    BOOST_CHECK(erroridx == failures++);
+    if(idx == 151)
+    {
+      BOOST_CHECK(CXX_RESULT_BATCH_ERROR_IS_ERRNO(b, erroridx));
+      BOOST_CHECK(b.errors[erroridx].value == EIO);
+    }
+    else
+    {
+      BOOST_CHECK(idx % 7 == 3);
+      BOOST_CHECK(CXX_RESULT_BATCH_ERROR_IS_ERRNO(b, erroridx));
+      BOOST_CHECK(b.errors[erroridx].value == EINVAL);
+    }
+  }
+  BOOST_CHECK(failures == 30);
+  for(size_t idx = 0; idx < b.count; idx++)
+  {
+    BOOST_CHECK(CXX_RESULT_BATCH_HAS_VALUE(b, idx) == (idx % 7 != 3 && idx != 151));
+    BOOST_CHECK(!CXX_RESULT_BATCH_HAS_VALUE(b, idx) || b.values[idx] == static_cast<int>(idx));
+  }
+
+  // Failures are found across bitmap words, and not beyond the end
+  status_result_batch<int> sparse;
+  for(int n = 0; n < 300; n++)
+  {
+    if(n == 5 || n == 64 || n == 299)
+    {
+      sparse.push_back(posix_code(EIO));
+    }
+    else
+    {
+      sparse.push_back(n);
+    }
+  }
+  auto s = sparse.c_view<CXX_RESULT_BATCH_SYSTEM(test_batch)>();
+  BOOST_CHECK(cxx_result_batch_next_failure(s.success, s.count, 0) == 5);
+  BOOST_CHECK(cxx_result_batch_next_failure(s.success, s.count, 6) == 64);
+  BOOST_CHECK(cxx_result_batch_next_failure(s.success, s.count, 65) == 299);
+  BOOST_CHECK(cxx_result_batch_next_failure(s.success, 299, 65) == 299);
+  BOOST_CHECK(cxx_result_batch_next_failure(s.success, 250, 65) == 250);
+
+  // And the results convert back
+  auto back = batch.release();
+  BOOST_CHECK(batch.count() == 0);
+  BOOST_REQUIRE(back.size() == 200);
+  for(size_t idx = 0; idx < back.size(); idx++)
+  {
+    if(idx % 7 == 3)
+    {
+      BOOST_CHECK(back[idx].error() == errc::invalid_argument);
+    }
+    else if(idx == 151)
+    {
+      BOOST_CHECK(back[idx].error() == errc::io_error);
+    }
+    else
+    {
+      BOOST_CHECK(back[idx].value() == static_cast<int>(idx));
+    }
+  }
+  auto back2 = to_status_results(sparse.view());
+  BOOST_REQUIRE(back2.size() == 300);
+  BOOST_CHECK(back2[64].error() == errc::io_error);
+  BOOST_CHECK(back2[65].value() == 65);
+  // An empty error has no domain to ask, and is not an errno
+  sparse.push_back(system_code());
+  s = sparse.c_view<CXX_RESULT_BATCH_SYSTEM(test_batch)>();
+  BOOST_CHECK(s.error_count == 4);
+  BOOST_CHECK(CXX_RESULT_BATCH_ERROR_IS_ERRNO(s, 2));
+  BOOST_CHECK(!CXX_RESULT_BATCH_ERROR_IS_ERRNO(s, 3));
+}
@@ -0,0 +1,171 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/status_code_from_enum.hpp"
+#include "../../include/outcome/try.hpp"
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+namespace arithmetic
+{
+  enum class errc
+  {
+    success,
+    divide_by_zero,
+    integer_divide_overflows,
+    not_integer_division
+  };
+  // Deliberately not in the order of its values, so lookups must search
+  enum class sparse_errc
+  {
+    ok = 0,
+    overflow = 75,
+    domain = 33
+  };
+}  // namespace arithmetic
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace experimental
+{
+  template <> struct enum_status_code_traits<arithmetic::errc>
+  {
+    static constexpr const char *domain_name = "arithmetic error domain";
+    static constexpr unsigned long long domain_id = 0x290f170194f0c6c7;
+    static constexpr enum_status_code_mapping<arithmetic::errc> mappings[] = {
+    {arithmetic::errc::success, "success", errc::success},                                               //
+    {arithmetic::errc::divide_by_zero, "divide by zero", errc::argument_out_of_domain},                  //
+    {arithmetic::errc::integer_divide_overflows, "integer divide overflows", errc::value_too_large},     //
+    {arithmetic::errc::not_integer_division, "not integer division", errc::unknown}                      //
+    };
+  };
+  template <> struct enum_status_code_traits<arithmetic::sparse_errc>
+  {
+    static constexpr const char *domain_name = "sparse arithmetic error domain";
+    static constexpr unsigned long long domain_id = 0x8c0b4ab6d4b5f5e1;
+    static constexpr enum_status_code_mapping<arithmetic::sparse_errc> mappings[] = {
+    {arithmetic::sparse_errc::ok, "ok", errc::success},                                       //
+    {arithmetic::sparse_errc::overflow, "overflow", errc::value_too_large},                   //
+    {arithmetic::sparse_errc::domain, "domain", errc::argument_out_of_domain}                 //
+    };
+  };
+#if __cplusplus < 201700L && (!defined(_MSVC_LANG) || _MSVC_LANG < 201700L)
+  constexpr enum_status_code_mapping<arithmetic::errc> enum_status_code_traits<arithmetic::errc>::mappings[];
+  constexpr enum_status_code_mapping<arithmetic::sparse_errc> enum_status_code_traits<arithmetic::sparse_errc>::mappings[];
+#endif
+}  // namespace experimental
+OUTCOME_V2_NAMESPACE_END
+
+namespace arithmetic
+{
+  inline OUTCOME_V2_NAMESPACE::experimental::enum_status_code<errc> make_status_code(errc e) { return OUTCOME_V2_NAMESPACE::experimental::enum_status_code<errc>(SYSTEM_ERROR2_NAMESPACE::in_place, e); }
+  inline OUTCOME_V2_NAMESPACE::experimental::enum_status_code<sparse_errc> make_status_code(sparse_errc e) { return OUTCOME_V2_NAMESPACE::experimental::enum_status_code<sparse_errc>(SYSTEM_ERROR2_NAMESPACE::in_place, e); }
+}  // namespace arithmetic
+
+static OUTCOME_V2_NAMESPACE::experimental::status_result<int> safe_divide(int i, int j)
+{
+  if(j == 0)
+  {
+    return arithmetic::errc::divide_by_zero;
+  }
+  if(i % j != 0)
+  {
+    return arithmetic::errc::not_integer_division;
+  }
+  return i / j;
+}
+
+static OUTCOME_V2_NAMESPACE::experimental::status_result<int> twice_divided(int i, int j)
+{
+  OUTCOME_TRY(v, safe_divide(i, j));
+  return v * 2;
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / from_enum, "Tests that status code domains generated from enum tables work as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  using arithmetic_code = enum_status_code<arithmetic::errc>;
+  using sparse_code = enum_status_code<arithmetic::sparse_errc>;
+
+  static_assert(std::is_final<_enum_status_code_domain<arithmetic::errc>>::value, "generated domains must be final");
+  static_assert(_enum_status_code_domain<arithmetic::errc>::generic(arithmetic::errc::divide_by_zero) == errc::argument_out_of_domain, "lookups must be constexpr");
+  static_assert(_enum_status_code_domain<arithmetic::sparse_errc>::generic(arithmetic::sparse_errc::domain) == errc::argument_out_of_domain, "lookups must be constexpr");
+
+  arithmetic_code a(arithmetic::errc::divide_by_zero), s(arithmetic::errc::success);
+  BOOST_CHECK(0 == strcmp(a.domain().name().c_str(), "arithmetic error domain"));
+  BOOST_CHECK(a.domain().id() == 0x290f170194f0c6c7);
+  BOOST_CHECK(0 == strcmp(a.message().c_str(), "divide by zero"));
+  BOOST_CHECK(0 == strcmp(arithmetic_code(static_cast<arithmetic::errc>(99)).message().c_str(), "unknown"));
+  BOOST_CHECK(a.failure());
+  BOOST_CHECK(s.success());
+  BOOST_CHECK(a == errc::argument_out_of_domain);
+  BOOST_CHECK(a != errc::value_too_large);
+  BOOST_CHECK(arithmetic_code(arithmetic::errc::not_integer_division) != errc::unknown);
+
+  sparse_code o(arithmetic::sparse_errc::overflow);
+  BOOST_CHECK(0 == strcmp(o.message().c_str(), "overflow"));
+  BOOST_CHECK(0 == strcmp(sparse_code(arithmetic::sparse_errc::domain).message().c_str(), "domain"));
+  BOOST_CHECK(o.failure());
+  BOOST_CHECK(sparse_code(arithmetic::sparse_errc::ok).success());
+  // Different domains are equivalent through their generic codes
+  BOOST_CHECK(o == arithmetic_code(arithmetic::errc::integer_divide_overflows));
+  BOOST_CHECK(a != o);
+
+  // The direct comparisons must agree with those through the virtual functions of erased codes
+  const arithmetic::errc values[] = {arithmetic::errc::success, arithmetic::errc::divide_by_zero, arithmetic::errc::integer_divide_overflows, arithmetic::errc::not_integer_division};
+  for(auto x : values)
+  {
+    for(auto y : values)
+    {
+      arithmetic_code cx(x), cy(y);
+      system_code ex(cx), ey(cy);
+      BOOST_CHECK((cx == cy) == (ex == ey));
+      BOOST_CHECK((cx == y) == (ex == ey));
+      BOOST_CHECK((x == cy) == (ex == ey));
+      BOOST_CHECK((cx == cy) == (x == y));
+    }
+  }
+  BOOST_CHECK(arithmetic_code() == arithmetic_code());
+  BOOST_CHECK(arithmetic_code() != a);
+  BOOST_CHECK(arithmetic_code() != arithmetic::errc::success);
+
+  auto r = twice_divided(6, 3);
+  BOOST_CHECK(r.has_value() && r.value() == 4);
+  r = twice_divided(6, 0);
+  BOOST_CHECK(r.has_error() && r.error() == arithmetic::errc::divide_by_zero);
+  BOOST_CHECK(r.error() == errc::argument_out_of_domain);
+  r = twice_divided(6, 4);
+  BOOST_CHECK(r.has_error() && r.error() == arithmetic::errc::not_integer_division && r.error() != arithmetic::errc::divide_by_zero);
+#ifdef __cpp_exceptions
+  try
+  {
+    a.throw_exception();
+    BOOST_CHECK(false);
+  }
+  catch(const status_error<_enum_status_code_domain<arithmetic::errc>> &e)
+  {
+    BOOST_CHECK(e.code() == arithmetic::errc::divide_by_zero);
+  }
+#endif
+}
@@ -0,0 +1,165 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/status_code_from_enum.hpp"
+#include "../../include/outcome/experimental/status_code_std_interop.hpp"
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <climits>
+#include <cstring>
+
+namespace interop
+{
+  enum class errc
+  {
+    success,
+    no_such_thing,
+    too_big
+  };
+  enum class big_errc : unsigned
+  {
+    success,
+    int_min = 0x80000000u,
+    uint_max = 0xffffffffu
+  };
+}  // namespace interop
+
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace experimental
+{
+  template <> struct enum_status_code_traits<interop::errc>
+  {
+    static constexpr const char *domain_name = "interop error domain";
+    static constexpr unsigned long long domain_id = 0x5d2f6ab1c03e9e47;
+    static constexpr enum_status_code_mapping<interop::errc> mappings[] = {
+    {interop::errc::success, "success", errc::success},                             //
+    {interop::errc::no_such_thing, "no such thing", errc::no_such_file_or_directory},  //
+    {interop::errc::too_big, "too big", errc::value_too_large}                      //
+    };
+  };
+  template <> struct enum_status_code_traits<interop::big_errc>
+  {
+    static constexpr const char *domain_name = "interop big error domain";
+    static constexpr unsigned long long domain_id = 0x8e41c7d2a35f0b19;
+    static constexpr enum_status_code_mapping<interop::big_errc> mappings[] = {
+    {interop::big_errc::success, "success", errc::success},                //
+    {interop::big_errc::int_min, "int min", errc::unknown},                //
+    {interop::big_errc::uint_max, "uint max", errc::value_too_large}  //
+    };
+  };
+#if __cplusplus < 201700L && (!defined(_MSVC_LANG) || _MSVC_LANG < 201700L)
+  constexpr enum_status_code_mapping<interop::errc> enum_status_code_traits<interop::errc>::mappings[];
+  constexpr enum_status_code_mapping<interop::big_errc> enum_status_code_traits<interop::big_errc>::mappings[];
+#endif
+}  // namespace experimental
+OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / std_interop, "Tests that conversions between std::error_code and status_code work as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  using interop_code = enum_status_code<interop::errc>;
+
+  // std::error_code to status code
+  {
+    system_code sc = to_status_code(std::make_error_code(std::errc::no_such_file_or_directory));
+    BOOST_CHECK(sc.domain() == generic_code_domain);
+    BOOST_CHECK(sc == errc::no_such_file_or_directory);
+    sc = to_status_code(std::error_code(ENOENT, std::system_category()));
+#ifndef _WIN32
+    BOOST_CHECK(sc.domain() == posix_code_domain);
+    BOOST_CHECK(sc == posix_code(ENOENT));
+#endif
+    BOOST_CHECK(sc == errc::no_such_file_or_directory);
+    BOOST_CHECK(to_status_code(std::error_code()).success());
+    // Other categories go through their default error conditions
+    sc = to_status_code(std::make_error_code(std::io_errc::stream));
+    BOOST_CHECK(sc.domain() == generic_code_domain);
+    BOOST_CHECK(sc == errc::unknown);
+  }
+
+  // Status code to std::error_code
+  {
+    std::error_code ec = to_error_code(generic_code(errc::permission_denied));
+    BOOST_CHECK(ec == std::make_error_code(std::errc::permission_denied));
+    ec = to_error_code(system_code(generic_code(errc::permission_denied)));
+    BOOST_CHECK(ec == std::make_error_code(std::errc::permission_denied));
+#ifndef _WIN32
+    ec = to_error_code(posix_code(EACCES));
+    BOOST_CHECK(ec == std::error_code(EACCES, std::system_category()));
+#endif
+    BOOST_CHECK(!to_error_code(system_code()));
+
+    // Any other domain has its own category
+    const interop_code ic(interop::errc::no_such_thing);
+    ec = to_error_code(ic);
+    BOOST_CHECK(ec.value() == static_cast<int>(interop::errc::no_such_thing));
+    BOOST_CHECK(0 == strcmp(ec.category().name(), "interop error domain"));
+    BOOST_CHECK(ec.message() == "no such thing");
+    BOOST_CHECK(ec == std::errc::no_such_file_or_directory);
+    BOOST_CHECK(ec != std::errc::value_too_large);
+    // The typed and erased forms share that category, and it is found again in every conversion
+    BOOST_CHECK(to_error_code(system_code(ic)) == ec);
+    BOOST_CHECK(&to_error_code(interop_code(interop::errc::too_big)).category() == &ec.category());
+    BOOST_CHECK(to_error_code(interop_code(interop::errc::too_big)) == std::errc::value_too_large);
+
+    // And converts back into the status code it was made from
+    system_code sc = to_status_code(ec);
+    BOOST_CHECK(sc.domain() == ic.domain());
+    BOOST_CHECK(sc == ic);
+    BOOST_CHECK(0 == strcmp(sc.message().c_str(), "no such thing"));
+
+    // Values which do not fit into an int cannot round trip, as the int would come back sign extended
+    BOOST_CHECK(to_error_code(enum_status_code<interop::big_errc>(interop::big_errc::int_min)) == std::make_error_code(std::errc::value_too_large));
+    BOOST_CHECK(to_error_code(system_code(enum_status_code<interop::big_errc>(interop::big_errc::uint_max))) == std::make_error_code(std::errc::value_too_large));
+    // Whereas negative values do
+    const interop_code neg(static_cast<interop::errc>(INT_MIN));
+    ec = to_error_code(neg);
+    BOOST_CHECK(ec.value() == INT_MIN);
+    BOOST_CHECK(&ec.category() == &to_error_code(ic).category());
+    sc = to_status_code(ec);
+    BOOST_CHECK(sc.domain() == neg.domain());
+    BOOST_CHECK(sc == neg);
+  }
+
+  // Results convert both ways through the explicit converting constructors
+  {
+    OUTCOME_V2_NAMESPACE::std_result<int> r(5), e(std::make_error_code(std::errc::invalid_argument));
+    status_result<long> sr(r), se(e);
+    BOOST_CHECK(sr.has_value() && sr.value() == 5);
+    BOOST_CHECK(se.has_error() && se.error() == errc::invalid_argument);
+    OUTCOME_V2_NAMESPACE::std_result<long> rr(sr), re(se);
+    BOOST_CHECK(rr.has_value() && rr.value() == 5);
+    BOOST_CHECK(re.has_error() && re.error() == std::errc::invalid_argument);
+
+    status_result<void> sv(interop_code(interop::errc::too_big));
+    OUTCOME_V2_NAMESPACE::std_result<void> rv(sv);
+    BOOST_CHECK(rv.has_error() && rv.error() == std::errc::value_too_large);
+    status_result<void> sv2(rv);
+    BOOST_CHECK(sv2.has_error() && sv2.error() == interop_code(interop::errc::too_big));
+    BOOST_CHECK((OUTCOME_V2_NAMESPACE::std_result<void>(status_result<void>(success())).has_value()));
+
+    static_assert(!std::is_convertible<status_result<int>, OUTCOME_V2_NAMESPACE::std_result<int>>::value, "conversions must be explicit");
+    static_assert(!std::is_convertible<OUTCOME_V2_NAMESPACE::std_result<int>, status_result<int>>::value, "conversions must be explicit");
+  }
+}
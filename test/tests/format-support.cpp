@@ -0,0 +1,111 @@
+/* Unit testing for outcomes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#ifndef FMT_HEADER_ONLY
+#define FMT_HEADER_ONLY  // avoid needing to link against fmt
+#endif
+
+#include "../../include/outcome/experimental/status_format_support.hpp"
+#include "../../include/outcome/experimental/status_result.hpp"
+#include "../../include/outcome/format_support.hpp"
+#include "../../include/outcome/iostream_support.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / format, "Tests that results and outcomes format as intended with std::format and fmt")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto einval = make_error_code(std::errc::invalid_argument);
+  result<int> a(5), b(einval);
+  result<void> c(success()), d(einval);
+  outcome<std::string> e("niall"), f(einval);
+#ifdef __cpp_exceptions
+  outcome<int> g(std::make_exception_ptr(std::runtime_error("hi"))), h(einval, std::make_exception_ptr(std::system_error(einval)));
+#endif
+  (void) a;
+  (void) b;
+  (void) c;
+  (void) d;
+  (void) e;
+  (void) f;
+#if OUTCOME_HAVE_STD_FORMAT_SUPPORT
+  BOOST_CHECK(std::format("{}", a) == "5");
+  BOOST_CHECK(std::format("{}", b) == "generic:22");
+  BOOST_CHECK(std::format("{:v}|{:e}", b, b) == "|generic:22");
+  BOOST_CHECK(std::format("{:#}", b) == print(b));
+  BOOST_CHECK(std::format("{:#}", formattable_error_code(einval)) == print(b));
+  BOOST_CHECK(std::format("{} {:#}", c, d) == "(+void) " + print(d));
+  BOOST_CHECK(std::format("{} {:#}", e, f) == "niall " + print(f));
+#ifdef __cpp_exceptions
+  BOOST_CHECK(std::format("{}", g) == "std::exception: hi");
+  BOOST_CHECK(std::format("{:#}", h) == print(h));
+#endif
+#endif
+#if OUTCOME_HAVE_FMT_SUPPORT
+  BOOST_CHECK(fmt::format("{}", a) == "5");
+  BOOST_CHECK(fmt::format("{}", b) == "generic:22");
+  BOOST_CHECK(fmt::format("{:v}|{:e}|{:v}", b, b, a) == "|generic:22|5");
+  BOOST_CHECK(fmt::format("{:#}", b) == print(b));
+  BOOST_CHECK(fmt::format("{} {:#}", formattable_error_code(einval), formattable_error_code(einval)) == "generic:22 " + print(b));
+  BOOST_CHECK(fmt::format("{} {:#}", c, d) == "(+void) " + print(d));
+  BOOST_CHECK(fmt::format("{} {:#}", e, f) == "niall " + print(f));
+  BOOST_CHECK(fmt::format("{:e}", e).empty());
+#ifdef __cpp_exceptions
+  BOOST_CHECK(fmt::format("{}", g) == "std::exception: hi");
+  BOOST_CHECK(fmt::format("{:#}", g) == print(g));
+  BOOST_CHECK(fmt::format("{:#}", h) == print(h));
+  BOOST_CHECK(fmt::format("{}", h) == "generic:22");
+  bool threw = false;
+  try
+  {
+    (void) fmt::format(fmt::runtime("{:x}"), a);
+  }
+  catch(const fmt::format_error &)
+  {
+    threw = true;
+  }
+  BOOST_CHECK(threw);
+#endif
+  // Writes straight into the output iterator
+  char buffer[64];
+  auto *end = fmt::format_to(buffer, "{:#}", b);
+  BOOST_CHECK(std::string(buffer, end) == print(b));
+#endif
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / status_code / format, "Tests that status codes, and results of them, format as intended")
+{
+#if OUTCOME_HAVE_FMT_SUPPORT
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  generic_code a(errc::invalid_argument);
+  system_code b(a);
+  status_result<int> c(a);
+  BOOST_CHECK(fmt::format("{}", a) == "Invalid argument");
+  BOOST_CHECK(fmt::format("{:#}", a) == "generic domain: Invalid argument");
+  BOOST_CHECK(fmt::format("{:#}", b) == "generic domain: Invalid argument");
+  BOOST_CHECK(fmt::format("{:e}", c) == "Invalid argument");
+  BOOST_CHECK(fmt::format("{}", generic_code()) == "(empty)");
+#endif
+}
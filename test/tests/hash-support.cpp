@@ -0,0 +1,185 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/experimental/status_hash_support.hpp"
+#include "../../include/outcome/experimental/status_outcome.hpp"
+#include "../../include/outcome/hash_support.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace hash_support_test
+{
+  struct unhashable
+  {
+  };
+
+  // A domain whose values are strings, of which only the first character is significant
+  class _first_char_domain;
+  using first_char_code = SYSTEM_ERROR2_NAMESPACE::status_code<_first_char_domain>;
+  class _first_char_domain : public SYSTEM_ERROR2_NAMESPACE::status_code_domain
+  {
+    template <class> friend class SYSTEM_ERROR2_NAMESPACE::status_code;
+    using _base = SYSTEM_ERROR2_NAMESPACE::status_code_domain;
+
+  public:
+    using value_type = const char *;
+    constexpr _first_char_domain() noexcept : _base(0x4c9e1b7d02a3f568) {}
+    static inline constexpr const _first_char_domain &get();
+    virtual string_ref name() const noexcept override { return string_ref("first char domain"); }  // NOLINT
+    size_t _do_hash(const value_type &v) const noexcept { return static_cast<size_t>(*v); }
+
+  protected:
+    virtual bool _do_failure(const SYSTEM_ERROR2_NAMESPACE::status_code<void> & /*unused*/) const noexcept override { return true; }  // NOLINT
+    virtual bool _do_equivalent(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code1, const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code2) const noexcept override  // NOLINT
+    {
+      return code2.domain() == *this && *static_cast<const first_char_code &>(code1).value() == *static_cast<const first_char_code &>(code2).value();  // NOLINT
+    }
+    virtual SYSTEM_ERROR2_NAMESPACE::generic_code _generic_code(const SYSTEM_ERROR2_NAMESPACE::status_code<void> & /*unused*/) const noexcept override { return SYSTEM_ERROR2_NAMESPACE::errc::unknown; }  // NOLINT
+    virtual string_ref _do_message(const SYSTEM_ERROR2_NAMESPACE::status_code<void> &code) const noexcept override { return string_ref(static_cast<const first_char_code &>(code).value()); }  // NOLINT
+    SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const SYSTEM_ERROR2_NAMESPACE::status_code<void> & /*unused*/) const override { abort(); }  // NOLINT
+  };
+  constexpr _first_char_domain first_char_domain;
+  inline constexpr const _first_char_domain &_first_char_domain::get() { return first_char_domain; }
+}  // namespace hash_support_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / hash_support / result, "Tests that results and outcomes hash consistently with their equality")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using hash_support_test::unhashable;
+  static_assert(!std::is_default_constructible<std::hash<result<unhashable>>>::value, "result of an unhashable type is hashable!");
+  static_assert(!std::is_default_constructible<std::hash<outcome<int, std::error_code, unhashable>>>::value, "outcome of an unhashable type is hashable!");
+  static_assert(std::is_default_constructible<std::hash<result<void>>>::value, "result<void> is not hashable!");
+
+  std::hash<result<int>> h;
+  BOOST_CHECK(h(result<int>(5)) == h(result<int>(5)));
+  BOOST_CHECK(h(result<int>(5)) != h(result<int>(6)));
+  // A value and an error of the same number must not hash the same
+  BOOST_CHECK(h(result<int>(5)) != h(result<int>(std::error_code(5, std::generic_category()))));
+  BOOST_CHECK(h(result<int>(std::error_code(5, std::generic_category()))) == h(result<int>(std::error_code(5, std::generic_category()))));
+  BOOST_CHECK(h(result<int>(std::error_code(5, std::generic_category()))) != h(result<int>(std::error_code(5, std::system_category()))));
+
+  std::hash<result<void>> hv;
+  BOOST_CHECK(hv(success()) == hv(success()));
+  BOOST_CHECK(hv(success()) != hv(std::error_code(5, std::generic_category())));
+
+  std::hash<outcome<int>> ho;
+  auto e = std::make_exception_ptr(std::runtime_error("hi"));
+  BOOST_CHECK(ho(outcome<int>(e)) == ho(outcome<int>(e)));
+  // Only whether there is an exception is hashed
+  BOOST_CHECK(ho(outcome<int>(e)) == ho(outcome<int>(std::make_exception_ptr(std::runtime_error("hi")))));
+  BOOST_CHECK(ho(outcome<int>(e)) != ho(outcome<int>(5)));
+  BOOST_CHECK(ho(outcome<int>(5)) == ho(outcome<int>(5)));
+  BOOST_CHECK(ho(outcome<int>(5)) != ho(outcome<int>(std::error_code(5, std::generic_category()))));
+
+  // Consecutive values must spread over all the bits
+  size_t ored = 0, anded = ~static_cast<size_t>(0);
+  for(int n = 0; n < 64; n++)
+  {
+    ored |= h(result<int>(n));
+    anded &= h(result<int>(n));
+  }
+  BOOST_CHECK(ored == ~static_cast<size_t>(0));
+  BOOST_CHECK(anded == 0);
+
+  std::unordered_set<result<int>> set;
+  for(int n = 0; n < 100; n++)
+  {
+    set.insert(result<int>(n));
+    set.insert(result<int>(std::error_code(n, std::generic_category())));
+  }
+  BOOST_CHECK(set.size() == 200);
+  BOOST_CHECK(set.count(result<int>(50)) == 1);
+  BOOST_CHECK(set.count(result<int>(std::error_code(50, std::generic_category()))) == 1);
+  BOOST_CHECK(set.count(result<int>(std::error_code(50, std::system_category()))) == 0);
+
+  // The transparent hash agrees with std::hash, and across types which compare equal
+  result_hash th;
+  BOOST_CHECK(th(result<int>(5)) == h(result<int>(5)));
+  BOOST_CHECK(th(outcome<int>(5)) == th(result<int>(5)));
+#ifdef __cpp_lib_string_view
+  std::unordered_set<result<std::string>, result_hash, std::equal_to<>> strings;
+  strings.insert(result<std::string>("niall"));
+  BOOST_CHECK(th(result<std::string_view>("niall")) == th(result<std::string>("niall")));
+#ifdef __cpp_lib_generic_unordered_lookup
+  BOOST_CHECK(strings.find(result<std::string_view>("niall")) != strings.end());
+  BOOST_CHECK(strings.find(result<std::string_view>("douglas")) == strings.end());
+#endif
+#endif
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / hash_support / status_code, "Tests that status codes hash their domain and value")
+{
+  using namespace OUTCOME_V2_NAMESPACE::experimental;
+  using hash_support_test::first_char_code;
+  static_assert(!std::is_default_constructible<std::hash<status_code<void>>>::value, "status_code<void> is hashable!");
+
+  std::hash<generic_code> hg;
+  std::hash<posix_code> hp;
+  std::hash<system_code> hs;
+  BOOST_CHECK(hg(generic_code(errc::invalid_argument)) == hg(generic_code(errc::invalid_argument)));
+  BOOST_CHECK(hg(generic_code(errc::invalid_argument)) != hg(generic_code(errc::permission_denied)));
+  // Codes of different domains which are semantically equal must not hash the same
+  BOOST_CHECK(generic_code(errc::invalid_argument) == posix_code(EINVAL));
+  BOOST_CHECK(hg(generic_code(errc::invalid_argument)) != hp(posix_code(EINVAL)));
+  // A code must hash the same as its type erased form
+  BOOST_CHECK(hg(generic_code(errc::invalid_argument)) == hs(system_code(generic_code(errc::invalid_argument))));
+  BOOST_CHECK(hp(posix_code(EINVAL)) == hs(system_code(posix_code(EINVAL))));
+  BOOST_CHECK(hs(system_code()) == hs(system_code()));
+
+  // The domain's _do_hash is used if it has one
+  std::hash<first_char_code> hf;
+  BOOST_CHECK(hf(first_char_code(in_place, "apple")) == hf(first_char_code(in_place, "avocado")));
+  BOOST_CHECK(hf(first_char_code(in_place, "apple")) != hf(first_char_code(in_place, "banana")));
+
+  std::unordered_map<system_code, int, std::hash<system_code>, status_code_equal_to> map;
+  map[generic_code(errc::invalid_argument)] = 1;
+  map[posix_code(EINVAL)] = 2;
+  map[posix_code(ENOENT)] = 3;
+  BOOST_CHECK(map.size() == 3);
+  BOOST_CHECK(map[generic_code(errc::invalid_argument)] == 1);
+  BOOST_CHECK(map[posix_code(EINVAL)] == 2);
+
+  // Typed codes equal, and hash the same as, their type erased forms
+  status_code_equal_to eq;
+  status_code_hash th;
+  BOOST_CHECK(eq(system_code(posix_code(EINVAL)), posix_code(EINVAL)));
+  BOOST_CHECK(eq(generic_code(errc::invalid_argument), system_code(generic_code(errc::invalid_argument))));
+  BOOST_CHECK(!eq(system_code(posix_code(EINVAL)), generic_code(errc::invalid_argument)));
+  BOOST_CHECK(!eq(system_code(posix_code(EINVAL)), posix_code(ENOENT)));
+  BOOST_CHECK(th(posix_code(EINVAL)) == th(system_code(posix_code(EINVAL))));
+  std::unordered_map<system_code, int, status_code_hash, status_code_equal_to> tmap;
+  tmap[system_code(posix_code(EINVAL))] = 2;
+#ifdef __cpp_lib_generic_unordered_lookup
+  BOOST_CHECK(tmap.find(posix_code(EINVAL)) != tmap.end());
+  BOOST_CHECK(tmap.find(generic_code(errc::invalid_argument)) == tmap.end());
+#endif
+
+  std::hash<status_result<int>> hr;
+  BOOST_CHECK(hr(status_result<int>(5)) == hr(status_result<int>(5)));
+  BOOST_CHECK(hr(status_result<int>(generic_code(errc::invalid_argument))) == hr(status_result<int>(generic_code(errc::invalid_argument))));
+  BOOST_CHECK(hr(status_result<int>(generic_code(errc::invalid_argument))) != hr(status_result<int>(posix_code(EINVAL))));
+}
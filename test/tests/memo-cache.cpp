@@ -0,0 +1,131 @@
+/* Unit testing for outcomes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/memo_cache.hpp"
+#include "../../include/outcome/result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / memo_cache, "Tests that memo_cache caches successes and failures, and coalesces concurrent misses")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto enoent = make_error_code(std::errc::no_such_file_or_directory);
+  std::atomic<int> calls{0};
+  auto lookup = [&](int k) -> result<std::string> {
+    ++calls;
+    if(k < 0)
+    {
+      return enoent;
+    }
+    return std::to_string(k);
+  };
+  // Successes and failures are both cached
+  {
+    memo_cache<int, result<std::string>> cache;
+    BOOST_CHECK(cache.get_or_compute(5, lookup).value() == "5");
+    BOOST_CHECK(cache.get_or_compute(5, lookup).value() == "5");
+    BOOST_CHECK(cache.get_or_compute(-1, lookup).error() == enoent);
+    BOOST_CHECK(cache.get_or_compute(-1, lookup).error() == enoent);
+    BOOST_CHECK(calls == 2);
+    BOOST_CHECK(cache.size() == 2);
+    auto stats = cache.stats();
+    BOOST_CHECK(stats.misses == 2);
+    BOOST_CHECK(stats.hits == 1);
+    BOOST_CHECK(stats.negative_hits == 1);
+    BOOST_CHECK(stats.coalesced == 0);
+    cache.erase(5);
+    BOOST_CHECK(cache.get_or_compute(5, lookup).value() == "5");
+    BOOST_CHECK(calls == 3);
+    cache.clear();
+    BOOST_CHECK(cache.size() == 0);
+  }
+  // Failures expire separately from successes
+  {
+    calls = 0;
+    memo_cache<int, result<std::string>> cache(std::chrono::hours(1), std::chrono::milliseconds(0));
+    BOOST_CHECK(cache.get_or_compute(-1, lookup).error() == enoent);
+    BOOST_CHECK(cache.get_or_compute(-1, lookup).error() == enoent);
+    BOOST_CHECK(cache.get_or_compute(1, lookup).value() == "1");
+    BOOST_CHECK(cache.get_or_compute(1, lookup).value() == "1");
+    BOOST_CHECK(calls == 3);
+    BOOST_CHECK(cache.purge_expired() == 1);
+    BOOST_CHECK(cache.size() == 1);
+  }
+#ifdef __cpp_exceptions
+  // A throwing function caches nothing
+  {
+    memo_cache<int, result<int>> cache;
+    bool threw = false;
+    try
+    {
+      (void) cache.get_or_compute(1, [](int) -> result<int> { throw std::runtime_error("hi"); });
+    }
+    catch(const std::runtime_error &)
+    {
+      threw = true;
+    }
+    BOOST_CHECK(threw);
+    BOOST_CHECK(cache.size() == 0);
+    BOOST_CHECK(cache.get_or_compute(1, [](int k) -> result<int> { return k; }).value() == 1);
+  }
+#endif
+  // Concurrent misses of the same key invoke the function once
+  {
+    calls = 0;
+    memo_cache<int, result<std::string>> cache(std::chrono::hours(1), std::chrono::hours(1), 4);
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for(int n = 0; n < 8; n++)
+    {
+      threads.emplace_back([&] {
+        while(!go)
+        {
+          std::this_thread::yield();
+        }
+        for(int k = 0; k < 100; k++)
+        {
+          auto r = cache.get_or_compute(k % 10, [&](int key) -> result<std::string> {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return lookup(key);
+          });
+          BOOST_CHECK(r.value() == std::to_string(k % 10));
+        }
+      });
+    }
+    go = true;
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    BOOST_CHECK(calls == 10);
+    auto stats = cache.stats();
+    BOOST_CHECK(stats.misses == 10);
+    // Each lookup is counted exactly once
+    BOOST_CHECK(stats.hits + stats.coalesced == 800 - 10);
+    BOOST_CHECK(stats.negative_hits == 0);
+  }
+}
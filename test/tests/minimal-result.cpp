@@ -0,0 +1,96 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/minimal_result.hpp"
+#include "../../include/outcome/try.hpp"
+
+// Which standard library headers are included must be checked before the test framework includes more
+#if defined(__cpp_exceptions) && (defined(_GLIBCXX_SYSTEM_ERROR) || defined(_GLIBCXX_STRING) || defined(_GLIBCXX_IOSFWD) || defined(__EXCEPTION__) || defined(_GLIBCXX_CSTRING) || defined(_GLIBCXX_CSTDLIB))
+#define MINIMAL_RESULT_INCLUDED_TOO_MUCH 1
+#elif defined(__cpp_exceptions) && (defined(_LIBCPP_SYSTEM_ERROR) || defined(_LIBCPP_STRING) || defined(_LIBCPP_IOSFWD) || defined(_LIBCPP_EXCEPTION) || defined(_LIBCPP_CSTRING) || defined(_LIBCPP_CSTDLIB))
+#define MINIMAL_RESULT_INCLUDED_TOO_MUCH 1
+#else
+#define MINIMAL_RESULT_INCLUDED_TOO_MUCH 0
+#endif
+
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <cstring>
+
+#define MINIMAL_RESULT_STRINGIZE2(x) #x
+#define MINIMAL_RESULT_STRINGIZE(x) MINIMAL_RESULT_STRINGIZE2(x)
+
+namespace minimal_result_test
+{
+  enum class errc
+  {
+    success,
+    bad_input,
+    too_big
+  };
+  OUTCOME_V2_NAMESPACE::minimal_result<int, errc> parse(int x)
+  {
+    if(x < 0)
+    {
+      return errc::bad_input;
+    }
+    if(x > 100)
+    {
+      return errc::too_big;
+    }
+    return x;
+  }
+  OUTCOME_V2_NAMESPACE::minimal_result<int, errc> doubled(int x)
+  {
+    OUTCOME_TRY(v, parse(x));
+    return v * 2;
+  }
+}  // namespace minimal_result_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / minimal, "Tests that the result with minimal includes works as intended")
+{
+  using namespace minimal_result_test;
+  using OUTCOME_V2_NAMESPACE::minimal_result;
+  BOOST_CHECK(!MINIMAL_RESULT_INCLUDED_TOO_MUCH);
+  // Some inline functions differ in minimal mode, so it has a namespace of its own
+  BOOST_CHECK(strstr(MINIMAL_RESULT_STRINGIZE(OUTCOME_V2_NAMESPACE), "_minimal") != nullptr);
+  static_assert(std::is_same<minimal_result<int, errc>, OUTCOME_V2_NAMESPACE::basic_result<int, errc, OUTCOME_V2_NAMESPACE::policy::terminate>>::value, "minimal_result must default to the terminate policy");
+  static_assert(std::is_trivially_copyable<minimal_result<int, errc>>::value, "minimal_result<int, errc> must be trivially copyable");
+
+  auto r = doubled(5);
+  BOOST_CHECK(r.has_value());
+  BOOST_CHECK(r.value() == 10);
+  r = doubled(-1);
+  BOOST_CHECK(r.has_error());
+  BOOST_CHECK(r.error() == errc::bad_input);
+  auto e = doubled(101);
+  BOOST_CHECK(e.assume_error() == errc::too_big);
+  BOOST_CHECK(r != e);
+  swap(r, e);
+  BOOST_CHECK(r.error() == errc::too_big && e.error() == errc::bad_input);
+
+  minimal_result<void, errc> v(OUTCOME_V2_NAMESPACE::success());
+  BOOST_CHECK(v);
+  v = OUTCOME_V2_NAMESPACE::failure(errc::bad_input);
+  BOOST_CHECK(!v && v.error() == errc::bad_input);
+}
@@ -0,0 +1,103 @@
+/* Unit testing for outcomes
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+// Check and record narrow violations, which is not the default
+#define OUTCOME_LOG_NARROW_VIOLATIONS 1
+
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/policy/all_narrow_logged.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <thread>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / policy / all_narrow_logged, "Tests that the all_narrow_logged policy records incorrect observations without aborting")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using policy::narrow_violation_kind;
+  using result_type = basic_result<int, long, policy::all_narrow_logged>;
+  using outcome_type = basic_outcome<int, long, std::exception_ptr, policy::all_narrow_logged>;
+  static_assert(!std::is_same<policy::all_narrow_logged, policy::all_narrow>::value, "all_narrow_logged should not be all_narrow when logging");
+  auto &log = policy::this_thread_narrow_violations();
+  log.clear();
+
+  // Correct observations record nothing
+  result_type v(in_place_type<int>, 5), e(in_place_type<long>, 6L);
+  BOOST_CHECK(v.assume_value() == 5);
+  BOOST_CHECK(v.value() == 5);
+  BOOST_CHECK(e.assume_error() == 6L);
+  BOOST_CHECK(e.error() == 6L);
+  BOOST_CHECK(log.empty());
+
+  // Incorrect observations are recorded, and the observation continues
+  e.assume_value();
+  BOOST_REQUIRE(log.size() == 1U);
+  BOOST_CHECK(log[0].kind == narrow_violation_kind::value);
+  BOOST_CHECK(log[0].object == static_cast<const void *>(&e));
+  BOOST_CHECK(log[0].call_site != nullptr);
+  BOOST_CHECK((log[0].status & 3U) == 2U);  // had an error and no value
+  (void) v.error();
+  BOOST_REQUIRE(log.size() == 2U);
+  BOOST_CHECK(log[1].kind == narrow_violation_kind::error);
+  BOOST_CHECK(log[1].object == static_cast<const void *>(&v));
+
+  // Each call site is told apart, even without optimisation
+  e.assume_value();
+  e.assume_value();
+  (void) v.error();
+  (void) v.error();
+  BOOST_REQUIRE(log.size() == 6U);
+  BOOST_CHECK(log[2].call_site != log[3].call_site);
+  BOOST_CHECK(log[4].call_site != log[5].call_site);
+  BOOST_CHECK(log[3].call_site != log[4].call_site);
+  log.clear();
+  e.assume_value();
+  (void) v.error();
+
+  outcome_type o(in_place_type<int>, 5);
+  (void) o.assume_exception();
+  BOOST_REQUIRE(log.size() == 3U);
+  BOOST_CHECK(log[2].kind == narrow_violation_kind::exception);
+  BOOST_CHECK(log[2].object == static_cast<const void *>(&o));
+
+  // Other threads have their own logs
+  size_t other = 1;
+  std::thread([&] {
+    other = policy::this_thread_narrow_violations().recorded();
+    (void) v.assume_error();
+  }).join();
+  BOOST_CHECK(other == 0U);
+  BOOST_CHECK(log.size() == 3U);
+
+  // When full, the oldest entries are overwritten
+  log.clear();
+  BOOST_CHECK(log.empty());
+  for(int n = 0; n < OUTCOME_NARROW_VIOLATION_LOG_ENTRIES + 3; n++)
+  {
+    (void) (n & 1 ? v.assume_error() : e.assume_value());
+  }
+  BOOST_CHECK(log.recorded() == OUTCOME_NARROW_VIOLATION_LOG_ENTRIES + 3U);
+  BOOST_CHECK(log.size() == OUTCOME_NARROW_VIOLATION_LOG_ENTRIES);
+  BOOST_CHECK(log[0].kind == narrow_violation_kind::error);  // the 4th recorded
+  BOOST_CHECK(log[log.size() - 1].kind == narrow_violation_kind::value);
+  log.clear();
+}
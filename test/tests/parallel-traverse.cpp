@@ -0,0 +1,122 @@
+/* Unit testing for outcomes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/parallel.hpp"
+#include "../../include/outcome/result.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / parallel_traverse, "Tests that parallel_traverse collects values in order and stops on the first failure")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  std::vector<int> inputs(10000);
+  for(size_t n = 0; n < inputs.size(); n++)
+  {
+    inputs[n] = static_cast<int>(n);
+  }
+
+  // All succeed, values must come back in input order irrespective of thread count
+  for(size_t threads = 1; threads <= 4; threads++)
+  {
+    auto r = parallel_traverse(inputs.begin(), inputs.end(), [](int i) -> result<std::string> { return std::to_string(i); }, threads);
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value().size() == inputs.size());
+    bool allgood = true;
+    for(size_t n = 0; n < inputs.size(); n++)
+    {
+      allgood = allgood && r.value()[n] == std::to_string(n);
+    }
+    BOOST_CHECK(allgood);
+  }
+
+  // A failure is returned, and once seen no new chunks are scheduled
+  {
+    std::atomic<size_t> invoked{0};
+    auto r = parallel_traverse(inputs.begin(), inputs.end(),
+                               [&](int i) -> result<std::string> {
+                                 ++invoked;
+                                 if(i == 100)
+                                 {
+                                   return std::errc::invalid_argument;
+                                 }
+                                 return std::to_string(i);
+                               },
+                               4, 16);
+    BOOST_REQUIRE(r.has_error());
+    BOOST_CHECK(r.error() == std::errc::invalid_argument);
+    BOOST_CHECK(invoked < inputs.size());
+  }
+
+  // Void values, and an empty input
+  {
+    auto r = parallel_traverse(inputs.begin(), inputs.end(), [](int i) -> result<void> {
+      if(i < 0)
+      {
+        return std::errc::invalid_argument;
+      }
+      return success();
+    });
+    BOOST_CHECK(r.has_value());
+    auto e = parallel_traverse(inputs.begin(), inputs.begin(), [](int i) -> result<int> { return i; });
+    BOOST_REQUIRE(e.has_value());
+    BOOST_CHECK(e.value().empty());
+  }
+
+#ifdef __cpp_exceptions
+  // Exceptions thrown by the callable are rethrown in the caller
+  BOOST_CHECK_THROW(parallel_traverse(inputs.begin(), inputs.end(),
+                                      [](int i) -> result<int> {
+                                        if(i == 5000)
+                                        {
+                                          throw std::runtime_error("boom");
+                                        }
+                                        return i;
+                                      },
+                                      4),
+                    std::runtime_error);
+
+  // As are exceptions thrown by moving the failure into place, rather than terminating
+  struct throwing_error
+  {
+    int code{0};
+    throwing_error() = default;
+    explicit throwing_error(int c)
+        : code(c)
+    {
+    }
+    throwing_error(const throwing_error &) = default;
+    throwing_error(throwing_error &&) { throw std::logic_error("move"); }  // NOLINT
+  };
+  BOOST_CHECK_THROW(parallel_traverse(inputs.begin(), inputs.end(),
+                                      [](int i) -> result<int, throwing_error, policy::terminate> {
+                                        if(i == 5000)
+                                        {
+                                          return result<int, throwing_error, policy::terminate>(in_place_type<throwing_error>, i);
+                                        }
+                                        return i;
+                                      },
+                                      4),
+                    std::logic_error);
+#endif
+}
@@ -0,0 +1,202 @@
+/* Unit testing for outcomes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/channel.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / channel, "Tests that result_channel passes results between many producers and consumers")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto einval = make_error_code(std::errc::invalid_argument);
+  // Single threaded semantics
+  {
+    result_channel<result<std::string>> ch(3);
+    BOOST_CHECK(ch.capacity() == 4);
+    BOOST_CHECK(!ch.has_error_tap());
+    BOOST_CHECK(ch.try_emplace(in_place_type<std::string>, 3, 'a'));
+    BOOST_CHECK(ch.try_push(result<std::string>(einval)));
+    BOOST_CHECK(ch.try_emplace("b"));
+    BOOST_CHECK(ch.try_emplace("c"));
+    BOOST_CHECK(!ch.try_emplace("d"));  // full
+    BOOST_CHECK(ch.size() == 4);
+    result<std::string> r{""};
+    BOOST_REQUIRE(ch.try_pop(r));
+    BOOST_CHECK(r.value() == "aaa");
+    std::vector<result<std::string>> batch;
+    BOOST_CHECK(ch.try_pop_n(std::back_inserter(batch), 10) == 3);
+    BOOST_REQUIRE(batch.size() == 3);
+    BOOST_CHECK(batch[0].error() == einval);
+    BOOST_CHECK(batch[2].value() == "c");
+    BOOST_CHECK(!ch.try_pop(r));
+    // Wraps around, and leaves anything unconsumed to be destroyed
+    for(int n = 0; n < 10; n++)
+    {
+      BOOST_CHECK(ch.try_emplace(std::string(50, 'x')));
+      BOOST_CHECK(ch.try_pop(r));
+    }
+    BOOST_CHECK(ch.try_emplace(std::string(50, 'y')));
+  }
+  // Move only elements, and outcomes
+  {
+    result_channel<outcome<std::unique_ptr<int>>> ch(8);
+    ch.emplace(std::unique_ptr<int>(new int(5)));
+    ch.emplace(std::make_exception_ptr(std::runtime_error("hi")));
+    size_t seen = 0;
+    BOOST_CHECK(ch.try_consume_n(
+                [&](outcome<std::unique_ptr<int>> &&o) {
+                  if(seen++ == 0)
+                  {
+                    BOOST_CHECK(*o.value() == 5);
+                  }
+                  else
+                  {
+                    BOOST_CHECK(o.has_exception());
+                  }
+                },
+                8) == 2);
+  }
+  // A throwing construction leaves nothing claimed, and a throwing consumer still releases its batch
+  {
+    static_assert(!std::is_constructible<result_channel<outcome<std::unique_ptr<int>>>, size_t, size_t>::value, "an error tap requires copyable elements");
+    result_channel<result<std::string>> ch(2);
+    BOOST_CHECK_THROW(ch.try_emplace(static_cast<const char *>(nullptr), 1), std::logic_error);
+    BOOST_CHECK(ch.size() == 0);
+    BOOST_CHECK(ch.try_emplace("a"));
+    BOOST_CHECK(ch.try_emplace("b"));
+    BOOST_CHECK_THROW(ch.try_consume_n([](result<std::string> && /*unused*/) { throw std::runtime_error("consumer"); }, 2), std::runtime_error);
+    BOOST_CHECK(ch.size() == 0);
+    BOOST_CHECK(ch.try_emplace("c"));
+    BOOST_CHECK(ch.try_emplace("d"));
+    result<std::string> r{""};
+    BOOST_REQUIRE(ch.try_pop(r));
+    BOOST_CHECK(r.value() == "c");
+  }
+  // The error tap sees only failures, and drops those it has no room for
+  {
+    result_channel<outcome<int>> ch(16, 2);
+    BOOST_REQUIRE(ch.has_error_tap());
+    ch.emplace(1);
+    ch.emplace(einval);
+    ch.emplace(2);
+    ch.emplace(make_error_code(std::errc::not_enough_memory));
+    ch.emplace(std::make_exception_ptr(std::runtime_error("hi")));
+    BOOST_CHECK(ch.size() == 5);
+    BOOST_CHECK(ch.dropped_errors() == 1);
+    outcome<int> o{0};
+    BOOST_REQUIRE(ch.try_pop_error(o));
+    BOOST_CHECK(o.error() == einval);
+    std::vector<outcome<int>> errors;
+    BOOST_CHECK(ch.try_pop_errors(std::back_inserter(errors), 10) == 1);
+    BOOST_CHECK(errors[0].error() == std::errc::not_enough_memory);
+    BOOST_CHECK(!ch.try_pop_error(o));
+    // The main channel still has every element
+    std::vector<outcome<int>> all;
+    BOOST_CHECK(ch.try_pop_n(std::back_inserter(all), 10) == 5);
+  }
+  // Many producers and consumers
+  {
+    static constexpr int producers = 4, consumers = 3, items = 20000;
+    result_channel<result<int>> ch(64, 1024);
+    std::atomic<long long> sum{0}, errors{0}, consumed{0};
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producers; p++)
+    {
+      threads.emplace_back([&] {
+        for(int n = 0; n < items; n++)
+        {
+          if(n % 100 == 0)
+          {
+            ch.emplace(einval);
+          }
+          else
+          {
+            ch.emplace(n);
+          }
+        }
+      });
+    }
+    for(int c = 0; c < consumers; c++)
+    {
+      threads.emplace_back([&] {
+        std::vector<result<int>> batch;
+        while(consumed.load() < producers * items)
+        {
+          batch.clear();
+          size_t n = ch.try_pop_n(std::back_inserter(batch), 16);
+          for(auto &r : batch)
+          {
+            if(r)
+            {
+              sum += r.value();
+            }
+          }
+          consumed += static_cast<long long>(n);
+          if(n == 0)
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    std::thread monitor([&] {
+      result<int> r{0};
+      while(consumed.load() < producers * items)
+      {
+        if(ch.try_pop_error(r))
+        {
+          BOOST_CHECK(!r);
+          ++errors;
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+    monitor.join();
+    long long expected = 0;
+    for(int n = 0; n < items; n++)
+    {
+      expected += (n % 100 == 0) ? 0 : n;
+    }
+    BOOST_CHECK(sum == expected * producers);
+    result<int> r{0};
+    while(ch.try_pop_error(r))
+    {
+      ++errors;
+    }
+    BOOST_CHECK(errors + static_cast<long long>(ch.dropped_errors()) == producers * items / 100);
+  }
+}
@@ -0,0 +1,159 @@
+/* Unit testing for outcomes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/result_slot.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#if OUTCOME_HAVE_COROUTINES
+namespace result_slot_test
+{
+  // Minimal eagerly started, never suspending at the end, coroutine type
+  struct task
+  {
+    struct promise_type
+    {
+      task get_return_object() { return {}; }
+      OUTCOME_COROUTINE_NAMESPACE::suspend_never initial_suspend() noexcept { return {}; }
+      OUTCOME_COROUTINE_NAMESPACE::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() {}
+      void unhandled_exception() { std::terminate(); }
+    };
+  };
+  inline task await_slot(OUTCOME_V2_NAMESPACE::result_slot<std::string> &slot, std::string &out)
+  {
+    auto &r = co_await slot;
+    out = r ? r.value() : "error";
+  }
+}  // namespace result_slot_test
+#endif
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / slot, "Tests that result_slot hands a result between threads")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  // Same thread, polling
+  {
+    result_slot<std::string> slot;
+    BOOST_CHECK(!slot.ready());
+    BOOST_CHECK(slot.try_get() == nullptr);
+    BOOST_CHECK(slot.status() == 0);
+    slot.emplace_value(5, 'a');
+    BOOST_REQUIRE(slot.ready());
+    BOOST_REQUIRE(slot.try_get() != nullptr);
+    BOOST_CHECK(slot.try_get()->value() == "aaaaa");
+    BOOST_CHECK((slot.status() & 1) != 0);  // status_have_value
+    auto r = slot.take();
+    BOOST_CHECK(r.value() == "aaaaa");
+    slot.reset();
+    BOOST_CHECK(!slot.ready());
+    slot.emplace_error(make_error_code(std::errc::invalid_argument));
+    BOOST_CHECK(slot.wait().error() == std::errc::invalid_argument);
+    BOOST_CHECK((slot.status() & 2) != 0);  // status_have_error
+    slot.reset();
+    slot.set(failure(make_error_code(std::errc::not_enough_memory)));
+    BOOST_CHECK(slot.wait().error() == std::errc::not_enough_memory);
+  }
+  // Between threads, blocking with spinning disabled to exercise the sleeping path
+  for(unsigned spins : {0U, 4096U})
+  {
+    std::vector<result_slot<int>> slots(64);
+    std::thread producer([&] {
+      for(size_t n = 0; n < slots.size(); n++)
+      {
+        if(n % 3 == 0)
+        {
+          slots[n].emplace_error(make_error_code(std::errc::invalid_argument));
+        }
+        else
+        {
+          slots[n].emplace_value(static_cast<int>(n));
+        }
+      }
+    });
+    bool allgood = true;
+    for(size_t n = 0; n < slots.size(); n++)
+    {
+      auto &r = slots[n].wait(spins);
+      allgood = allgood && ((n % 3 == 0) ? (r.error() == std::errc::invalid_argument) : (r.value() == static_cast<int>(n)));
+    }
+    producer.join();
+    BOOST_CHECK(allgood);
+  }
+  // The slot may be destroyed as soon as a consumer sees the result, while the producer is still running
+  for(unsigned spins : {0U, 4096U})
+  {
+    for(int n = 0; n < 200; n++)
+    {
+      auto *slot = new result_slot<int>;
+      std::thread producer([slot, n] { slot->emplace_value(n); });
+      BOOST_CHECK(slot->wait(spins).value() == n);
+      delete slot;
+      producer.join();
+    }
+  }
+  // Many threads may wait at once
+  {
+    result_slot<int> slot;
+    std::vector<std::thread> consumers;
+    std::atomic<int> sum{0};
+    for(int n = 0; n < 4; n++)
+    {
+      consumers.emplace_back([&] { sum += slot.wait(0).value(); });
+    }
+    slot.emplace_value(3);
+    for(auto &t : consumers)
+    {
+      t.join();
+    }
+    BOOST_CHECK(sum == 12);
+  }
+  // void results
+  {
+    result_slot<void> slot;
+    std::thread producer([&] { slot.emplace_value(); });
+    BOOST_CHECK(slot.wait().has_value());
+    producer.join();
+  }
+#if OUTCOME_HAVE_COROUTINES
+  // Coroutine awaiting, both when published before and after co_await
+  {
+    result_slot<std::string> slot;
+    std::string out;
+    slot.emplace_value("hello");
+    result_slot_test::await_slot(slot, out);
+    BOOST_CHECK(out == "hello");
+  }
+  {
+    result_slot<std::string> slot;
+    std::string out;
+    result_slot_test::await_slot(slot, out);
+    BOOST_CHECK(out.empty());
+    std::thread producer([&] { slot.emplace_value("world"); });
+    producer.join();
+    BOOST_CHECK(out == "world");
+  }
+#endif
+}
@@ -0,0 +1,120 @@
+/* Unit testing for outcomes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/result.hpp"
+#include "../../include/outcome/result_view.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace result_view_test
+{
+  using OUTCOME_V2_NAMESPACE::checked;
+  using OUTCOME_V2_NAMESPACE::result_view;
+  using record = OUTCOME_V2_NAMESPACE::result_record<uint64_t, int>;
+
+  inline checked<uint64_t, int> twice(result_view<uint64_t, int> v)
+  {
+    OUTCOME_TRY(x, v);
+    return OUTCOME_V2_NAMESPACE::success(x * 2);
+  }
+}  // namespace result_view_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / view, "Tests that result_view references records in place, and works with OUTCOME_TRY")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  using namespace result_view_test;
+  static_assert(record::alignment == alignof(uint64_t), "");
+  static_assert(record::payload_offset == alignof(uint64_t), "");
+  static_assert(record::size == 2 * sizeof(uint64_t), "");
+  static_assert(result_record<uint16_t, char>::size == 8, "");
+  static_assert(std::is_same<std::iterator_traits<result_view_span<uint64_t, int>::iterator>::iterator_category, std::input_iterator_tag>::value, "");
+#ifdef __cpp_lib_ranges
+  static_assert(std::random_access_iterator<result_view_span<uint64_t, int>::iterator>, "");
+#endif
+
+  // Write records as a log writer might
+  std::vector<uint64_t> storage(100 * record::size / sizeof(uint64_t));
+  for(int n = 0; n < 100; n++)
+  {
+    checked<uint64_t, int> r = (n % 10 == 0) ? checked<uint64_t, int>(failure(n)) : checked<uint64_t, int>(success(static_cast<uint64_t>(n)));
+    if(n == 5)
+    {
+      hooks::set_spare_storage(&r, 78);
+    }
+    record::store(reinterpret_cast<char *>(storage.data()) + n * record::size, r);
+  }
+
+  result_view_span<uint64_t, int> span(storage.data(), storage.size() * sizeof(uint64_t) + 3);
+  BOOST_CHECK(span.size() == 100);
+  BOOST_CHECK(span.end() - span.begin() == 100);
+  // Values are referenced in place
+  BOOST_CHECK(span[7].has_value());
+  BOOST_CHECK(span[7].value() == 7);
+  BOOST_CHECK(&span[7].value() == &storage[15]);
+  BOOST_CHECK(span[10].has_error());
+  BOOST_CHECK(span[10].error() == 10);
+  BOOST_CHECK(span[5].spare_storage() == 78);
+  BOOST_CHECK(static_cast<checked<uint64_t, int>>(span[5]).value() == 5);
+  BOOST_CHECK(!static_cast<checked<uint64_t, int>>(span[20]));
+#ifdef __cpp_exceptions
+  bool threw = false;
+  try
+  {
+    (void) span[30].value();
+  }
+  catch(const bad_result_access_with<int> &e)
+  {
+    threw = (e.error() == 30);
+  }
+  BOOST_CHECK(threw);
+#endif
+  // Iterators are random access
+  uint64_t sum = 0;
+  size_t errors = 0;
+  for(auto v : span)
+  {
+    if(v)
+    {
+      sum += v.value();
+    }
+    else
+    {
+      ++errors;
+    }
+  }
+  BOOST_CHECK(sum == 4950 - 450);
+  BOOST_CHECK(errors == 10);
+  BOOST_CHECK(std::count_if(span.begin(), span.end(), [](result_view<uint64_t, int> v) { return v.has_failure(); }) == 10);
+  auto it = span.begin() + 50;
+  BOOST_CHECK((*it).error() == 50);
+  BOOST_CHECK(it[1].value() == 51);
+  BOOST_CHECK((*--it).value() == 49);
+  // OUTCOME_TRY works upon views
+  BOOST_CHECK(twice(span[21]).value() == 42);
+  BOOST_CHECK(twice(span[40]).error() == 40);
+}
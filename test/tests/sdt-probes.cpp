@@ -0,0 +1,176 @@
+/* Unit testing for the static tracepoints of sdt_probes.hpp
+(C) 2013-2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#define OUTCOME_ENABLE_SDT_PROBES 1
+
+#include "../../include/outcome/experimental/status_result.hpp"
+#include "../../include/outcome/outcome.hpp"
+#include "../../include/outcome/try.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+#if OUTCOME_SDT_PROBES_AVAILABLE && defined(__linux__)
+#include <elf.h>
+#endif
+
+namespace sdt_probes_test
+{
+  namespace oc = OUTCOME_V2_NAMESPACE;
+  template <class T> using result = oc::result<T, std::error_code>;
+  template <class T> using outcome = oc::outcome<T, std::error_code>;
+  template <class T> using status_result = oc::experimental::status_result<T>;
+
+  inline result<int> fail(int x)
+  {
+    if(x < 0)
+    {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    return x;
+  }
+  inline result<int> try_fail(int x)
+  {
+    OUTCOME_TRY(v, fail(x));
+    return v + 1;
+  }
+  inline outcome<int> outcome_fail(int x)
+  {
+    if(x < 0)
+    {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    return x;
+  }
+  inline status_result<int> status_fail(int x)
+  {
+    if(x < 0)
+    {
+      return SYSTEM_ERROR2_NAMESPACE::errc::invalid_argument;
+    }
+    return x;
+  }
+
+#if OUTCOME_SDT_PROBES_AVAILABLE && defined(__linux__)
+  // The probe names and argument strings of the stapsdt notes of provider "outcome" in this executable
+  inline std::vector<std::pair<std::string, std::string>> outcome_probes()
+  {
+    std::vector<std::pair<std::string, std::string>> ret;
+    std::ifstream ih("/proc/self/exe", std::ios::binary);
+    std::vector<char> file((std::istreambuf_iterator<char>(ih)), std::istreambuf_iterator<char>());
+    if(file.size() < sizeof(Elf64_Ehdr))
+    {
+      return ret;
+    }
+    Elf64_Ehdr ehdr;
+    memcpy(&ehdr, file.data(), sizeof(ehdr));
+    if(0 != memcmp(ehdr.e_ident, ELFMAG, SELFMAG) || ehdr.e_ident[EI_CLASS] != ELFCLASS64)
+    {
+      return ret;
+    }
+    std::vector<Elf64_Shdr> shdrs(ehdr.e_shnum);
+    memcpy(shdrs.data(), file.data() + ehdr.e_shoff, ehdr.e_shnum * sizeof(Elf64_Shdr));
+    const char *shstrtab = file.data() + shdrs[ehdr.e_shstrndx].sh_offset;
+    for(auto &shdr : shdrs)
+    {
+      if(shdr.sh_type != SHT_NOTE || 0 != strcmp(shstrtab + shdr.sh_name, ".note.stapsdt"))
+      {
+        continue;
+      }
+      size_t offset = 0;
+      while(offset + sizeof(Elf64_Nhdr) <= shdr.sh_size)
+      {
+        Elf64_Nhdr nhdr;
+        memcpy(&nhdr, file.data() + shdr.sh_offset + offset, sizeof(nhdr));
+        const char *name = file.data() + shdr.sh_offset + offset + sizeof(nhdr);
+        const char *desc = name + ((nhdr.n_namesz + 3) & ~3U);
+        if(nhdr.n_type == 3 && 0 == strcmp(name, "stapsdt"))
+        {
+          // The probe, base and semaphore addresses, then the provider, name and arguments
+          const char *provider = desc + 3 * 8;
+          const char *probe = provider + strlen(provider) + 1;
+          const char *args = probe + strlen(probe) + 1;
+          if(0 == strcmp(provider, "outcome"))
+          {
+            ret.emplace_back(probe, args);
+          }
+        }
+        offset += sizeof(nhdr) + ((nhdr.n_namesz + 3) & ~3U) + ((nhdr.n_descsz + 3) & ~3U);
+      }
+    }
+    return ret;
+  }
+#endif
+}  // namespace sdt_probes_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / sdt_probes, "Tests that the static tracepoints are placed, and change nothing else")
+{
+  using namespace sdt_probes_test;
+  // The probes do not change behaviour
+  BOOST_CHECK(fail(5).value() == 5);
+  BOOST_CHECK(fail(-5).error() == std::errc::invalid_argument);
+  BOOST_CHECK(try_fail(5).value() == 6);
+  BOOST_CHECK(try_fail(-5).error() == std::errc::invalid_argument);
+  BOOST_CHECK(outcome_fail(-5).error() == std::errc::invalid_argument);
+  BOOST_CHECK(status_fail(5).value() == 5);
+  BOOST_CHECK(status_fail(-5).error() == SYSTEM_ERROR2_NAMESPACE::errc::invalid_argument);
+#ifdef __cpp_exceptions
+  try
+  {
+    status_fail(-5).value();
+    BOOST_CHECK(false);
+  }
+  catch(const SYSTEM_ERROR2_NAMESPACE::status_error<void> & /*unused*/)
+  {
+  }
+#endif
+
+  // Constant evaluation is unaffected
+  static constexpr oc::result<int, long, oc::policy::terminate> c(oc::in_place_type<int>, 5), d(oc::in_place_type<long>, 6L);
+  static_assert(c.value() == 5, "");
+  static_assert(d.error() == 6L, "");
+
+#if OUTCOME_SDT_PROBES_AVAILABLE && defined(__linux__)
+  // Each kind of probe has a stapsdt note with four 64 bit arguments
+  auto probes = outcome_probes();
+  std::set<std::string> names;
+  for(auto &probe : probes)
+  {
+    names.insert(probe.first);
+    BOOST_CHECK(std::count(probe.second.begin(), probe.second.end(), '@') == 4);
+    BOOST_CHECK(probe.second.compare(0, 3, "-8@") == 0);
+  }
+  BOOST_CHECK(names.count("result_failure") == 1U);
+  BOOST_CHECK(names.count("outcome_failure") == 1U);
+  BOOST_CHECK(names.count("try_failure") == 1U);
+#ifdef __cpp_exceptions
+  BOOST_CHECK(names.count("status_code_throw") == 1U);
+#endif
+#endif
+}
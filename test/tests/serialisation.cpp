@@ -21,9 +21,12 @@ Distributed under the Boost Software License, Version 1.0.
           http://www.boost.org/LICENSE_1_0.txt)
 */
 
+#include "../../include/outcome/binary_support.hpp"
 #include "../../include/outcome/iostream_support.hpp"
 #include "quickcpplib/boost/test/unit_test.hpp"
 
+#include <vector>
+
 BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / serialisation, "Tests that the outcome serialises and deserialises as intended")
 {
 #if !defined(__APPLE__) || defined(__cpp_exceptions)
@@ -40,3 +43,74 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / serialisation, "Tests that the ou
   BOOST_CHECK(d == e);
 #endif
 }
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / binary_serialisation, "Tests that the outcome binary encodes and decodes as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  char buffer[64];
+  // As above, but through the binary codec
+  outcome<int, std::string, long> d(success(5)), e(failure(""));
+  size_t length = binary_encode(buffer, sizeof(buffer), d);
+  BOOST_CHECK(length == 5);
+  BOOST_CHECK(length == binary_encoded_size(d));
+  BOOST_CHECK(binary_decode(e, buffer, length) == length);
+  BOOST_CHECK(d == e);
+  // Errors, exceptions and errors with exceptions
+  outcome<int, std::string, long> f(failure("niall")), g(failure("", 78L)), h(success(0));
+  length = binary_encode(buffer, sizeof(buffer), f);
+  BOOST_CHECK(length == 7);
+  BOOST_CHECK(binary_decode(h, buffer, length) == length);
+  BOOST_CHECK(h == f);
+  length = binary_encode(buffer, sizeof(buffer), g);
+  BOOST_CHECK(binary_decode(h, buffer, length) == length);
+  BOOST_CHECK(h.has_error() && h.has_exception());
+  BOOST_CHECK(h.assume_exception() == 78);
+  // Truncated input and too small buffers fail
+  BOOST_CHECK(binary_decode(h, buffer, length - 1) == 0);
+  BOOST_CHECK(binary_encode(buffer, length - 1, g) == 0);
+
+  // Error codes of the standard categories, and void values
+  result<void> i(make_error_code(std::errc::no_space_on_device)), j(success());
+  length = binary_encode(buffer, sizeof(buffer), i);
+  BOOST_CHECK(length == 4);
+  BOOST_CHECK(binary_decode(j, buffer, length) == length);
+  BOOST_CHECK(j.error() == std::errc::no_space_on_device);
+  length = binary_encode(buffer, sizeof(buffer), result<void>(success()));
+  BOOST_CHECK(length == 1);
+  BOOST_CHECK(binary_decode(j, buffer, length) == length);
+  BOOST_CHECK(j.has_value());
+  // An outcome with an exception cannot decode into a result
+  length = binary_encode(buffer, sizeof(buffer), g);
+  result<int, std::string> k(0);
+  BOOST_CHECK(binary_decode(k, buffer, length) == 0);
+  BOOST_CHECK(k.value() == 0);
+  // Statuses with neither a value nor a failure, or both, are rejected and leave the target untouched
+  buffer[0] = 0;
+  BOOST_CHECK(binary_decode(k, buffer, 1) == 0);
+  BOOST_CHECK(binary_decode(h, buffer, 1) == 0);
+  BOOST_CHECK(k.value() == 0);
+  BOOST_CHECK(h.assume_exception() == 78);
+  length = binary_encode(buffer, sizeof(buffer), d);
+  buffer[0] |= static_cast<char>(detail::status_have_error);
+  BOOST_CHECK(binary_decode(e, buffer, length) == 0);
+  BOOST_CHECK(e.value() == 5);
+
+  // A stream of records, each decoding where the last ended
+  std::vector<char> log(1024);
+  size_t offset = 0;
+  for(int n = 0; n < 10; n++)
+  {
+    result<std::string> r = (n % 3 == 0) ? result<std::string>(make_error_code(std::errc::io_error)) : result<std::string>(std::string(static_cast<size_t>(n), 'a'));
+    offset += binary_encode(log.data() + offset, log.size() - offset, r);
+  }
+  result<std::string> r("");
+  size_t consumed = 0;
+  for(int n = 0; n < 10; n++)
+  {
+    const size_t used = binary_decode(r, log.data() + consumed, offset - consumed);
+    BOOST_REQUIRE(used > 0);
+    consumed += used;
+    BOOST_CHECK((n % 3 == 0) ? (r.error() == std::errc::io_error) : (r.value().size() == static_cast<size_t>(n)));
+  }
+  BOOST_CHECK(consumed == offset);
+}
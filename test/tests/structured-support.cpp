@@ -0,0 +1,106 @@
+/* Unit testing for structured JSON and CBOR encoding
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+
+#include "../../include/outcome/experimental/status_outcome.hpp"
+#include "../../include/outcome/experimental/structured_support.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <string>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / structured, "Tests that results, outcomes and status codes encode into JSON and CBOR as intended")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  namespace sc = SYSTEM_ERROR2_NAMESPACE;
+  auto json = [](const auto &v) {
+    char buffer[512];
+    return std::string(buffer, experimental::json_encode(buffer, v));
+  };
+  auto cbor = [](const auto &v) {
+    std::string ret;
+    experimental::cbor_encode(std::back_inserter(ret), v);
+    return ret;
+  };
+  const auto einval = make_error_code(std::errc::invalid_argument);
+
+  // JSON
+  BOOST_CHECK(json(result<int>(-5)) == "{\"value\":-5}\n");
+  BOOST_CHECK(json(result<void>(success())) == "{\"value\":null}\n");
+  BOOST_CHECK(json(result<std::string>("a\"b\\c\n")) == "{\"value\":\"a\\\"b\\\\c\\u000a\"}\n");
+  BOOST_CHECK(json(result<double>(0.5)) == "{\"value\":0.5}\n");
+  BOOST_CHECK(json(result<int>(einval)) == "{\"error\":{\"category\":\"generic\",\"value\":22,\"message\":\"" + einval.message() + "\"}}\n");
+  const sc::generic_code gc(sc::errc::invalid_argument);
+  const auto msg = gc.message();
+  const std::string gcjson = "{\"domain\":\"generic domain\",\"id\":\"0x746d6354f4f733e9\",\"value\":22,\"message\":\"" + std::string(msg.data(), msg.size()) + "\"}";
+  BOOST_CHECK(json(gc) == gcjson + "\n");
+  BOOST_CHECK(json(experimental::status_result<int>(gc)) == "{\"error\":" + gcjson + "}\n");
+  BOOST_CHECK(json(sc::generic_code()) == "null\n");
+  BOOST_CHECK(json(sc::system_code(gc)) == gcjson + "\n");
+#ifdef __cpp_exceptions
+  BOOST_CHECK(json(outcome<int>(einval, std::make_exception_ptr(std::runtime_error("boo")))).find(",\"exception\":\"boo\"}") != std::string::npos);
+#endif
+  // Records written consecutively form JSON lines
+  {
+    char buffer[64], *p = buffer;
+    p = experimental::json_encode(p, result<int>(1));
+    p = experimental::json_encode(p, result<int>(2));
+    BOOST_CHECK(std::string(buffer, p) == "{\"value\":1}\n{\"value\":2}\n");
+  }
+
+  // CBOR
+  BOOST_CHECK(cbor(result<int>(5)) == std::string("\xa1\x65value\x05", 8));
+  BOOST_CHECK(cbor(result<int>(-500)) == std::string("\xa1\x65value\x39\x01\xf3", 10));
+  BOOST_CHECK(cbor(result<void>(success())) == std::string("\xa1\x65value\xf6", 8));
+  BOOST_CHECK(cbor(result<bool>(true)) == std::string("\xa1\x65value\xf5", 8));
+  BOOST_CHECK(cbor(result<std::string>("hi")) == std::string("\xa1\x65value\x62hi", 10));
+  BOOST_CHECK(cbor(result<double>(1.5)) == std::string("\xa1\x65value\xfb\x3f\xf8\0\0\0\0\0\0", 16));
+
+  // CBOR of status codes decodes back into system_code
+  {
+    sc::system_code out;
+    const auto a = cbor(gc);
+    BOOST_CHECK(experimental::cbor_decode(out, a.data(), a.size()) == a.size());
+    BOOST_CHECK(out == gc);
+    BOOST_CHECK(out.domain() == sc::generic_code_domain);
+    const auto b = cbor(experimental::status_result<int>(sc::posix_code(ENOENT)));
+    BOOST_CHECK(experimental::cbor_decode(out, b.data(), b.size()) == b.size());
+    BOOST_CHECK(out.domain() == sc::posix_code_domain);
+    BOOST_CHECK(out == sc::errc::no_such_file_or_directory);
+    const auto c = cbor(experimental::status_outcome<int>(sc::system_code(gc)));
+    BOOST_CHECK(experimental::cbor_decode(out, c.data(), c.size()) == c.size());
+    BOOST_CHECK(out == gc);
+    // Sequences decode item by item
+    const auto d = a + b;
+    const size_t used = experimental::cbor_decode(out, d.data(), d.size());
+    BOOST_CHECK(used == a.size());
+    BOOST_CHECK(experimental::cbor_decode(out, d.data() + used, d.size() - used) == b.size());
+    BOOST_CHECK(out.domain() == sc::posix_code_domain);
+    // Successes, truncations and foreign domains do not decode
+    const auto e = cbor(experimental::status_result<int>(5));
+    BOOST_CHECK(experimental::cbor_decode(out, e.data(), e.size()) == 0);
+    BOOST_CHECK(experimental::cbor_decode(out, a.data(), a.size() - 1) == 0);
+    auto f = a;
+    f[f.find("id") + 3] ^= 1;
+    BOOST_CHECK(experimental::cbor_decode(out, f.data(), f.size()) == 0);
+  }
+}
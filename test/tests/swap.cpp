@@ -24,6 +24,13 @@ Distributed under the Boost Software License, Version 1.0.
 #include "../../include/outcome/outcome.hpp"
 #include "quickcpplib/boost/test/unit_test.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
 #ifdef __cpp_exceptions
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -365,3 +372,120 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / swap, "Tests that the outcome swa
   }
 #endif
 }
+
+// A heap allocated string, which is trivially relocatable if Relocatable
+template <bool Relocatable> struct Text
+{
+  std::unique_ptr<std::string> s;
+  Text() = default;
+  explicit Text(std::string v)
+      : s(new std::string(std::move(v)))
+  {
+  }
+  bool operator<(const Text &o) const noexcept { return *s < *o.s; }
+};
+OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct is_trivially_relocatable<Text<true>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+OUTCOME_V2_NAMESPACE_END
+
+// Sorts a copy of the results, errors first, returning how long it took in nanoseconds per result
+template <class T> double sort_results(std::vector<OUTCOME_V2_NAMESPACE::result<T>> &results)
+{
+  using result_type = OUTCOME_V2_NAMESPACE::result<T>;
+  auto begin = std::chrono::high_resolution_clock::now();
+  std::sort(results.begin(), results.end(), [](const result_type &a, const result_type &b) {
+    if(a.has_error() || b.has_error())
+    {
+      return a.has_error() && (b.has_value() || a.error().value() < b.error().value());
+    }
+    return a.value() < b.value();
+  });
+  auto end = std::chrono::high_resolution_clock::now();
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / static_cast<double>(results.size());
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / outcome / swap / relocating, "Tests that trivially relocatable types are swapped by swapping their bytes, and how much faster that sorts")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  static_assert(detail::use_relocating_swap<Text<true>>::value, "Text<true> is not swapped by relocation!");
+  static_assert(!detail::use_relocating_swap<Text<false>>::value, "Text<false> is swapped by relocation!");
+  static_assert(!detail::use_relocating_swap<int>::value, "int is swapped by relocation!");
+  static_assert(detail::use_relocating_swap<std::exception_ptr>::value, "std::exception_ptr is not swapped by relocation!");
+  {  // Does swap actually swap, in every combination of value and error?
+    result<Text<true>> a(Text<true>("niall")), b(Text<true>("douglas"));
+    swap(a, b);
+    BOOST_CHECK(*a.value().s == "douglas");
+    BOOST_CHECK(*b.value().s == "niall");
+    a = std::errc::not_enough_memory;
+    swap(a, b);
+    BOOST_CHECK(*a.value().s == "niall");
+    BOOST_CHECK(b.error() == std::errc::not_enough_memory);
+    swap(a, b);
+    BOOST_CHECK(a.error() == std::errc::not_enough_memory);
+    BOOST_CHECK(*b.value().s == "niall");
+    b = std::errc::invalid_argument;
+    swap(a, b);
+    BOOST_CHECK(a.error() == std::errc::invalid_argument);
+    BOOST_CHECK(b.error() == std::errc::not_enough_memory);
+    BOOST_CHECK(!a.has_lost_consistency());
+    BOOST_CHECK(!b.has_lost_consistency());
+  }
+  {  // Does it swap the whole of an outcome?
+    outcome<Text<true>> a(Text<true>("niall")), b(std::make_exception_ptr(std::runtime_error("douglas")));
+    swap(a, b);
+    BOOST_CHECK(b.value().s != nullptr && *b.value().s == "niall");
+    BOOST_CHECK(a.has_exception());
+  }
+
+  // Sort arrays of results, a tenth of which are errors, with and without swapping by relocation
+  static constexpr size_t count = 200000;
+  std::mt19937 rand(78);
+  std::vector<std::string> strings(count);
+  for(auto &i : strings)
+  {
+    i = std::to_string(rand());
+  }
+  auto make = [&](auto *type) {
+    using T = std::decay_t<decltype(*type)>;
+    std::vector<result<T>> ret;
+    ret.reserve(count);
+    for(size_t n = 0; n < count; n++)
+    {
+      if(n % 10 == 0)
+      {
+        ret.emplace_back(std::error_code(static_cast<int>(n % 7) + 1, std::generic_category()));
+      }
+      else
+      {
+        ret.emplace_back(T(strings[n]));
+      }
+    }
+    return ret;
+  };
+  auto elementwise = make(static_cast<Text<false> *>(nullptr));
+  auto relocating = make(static_cast<Text<true> *>(nullptr));
+  auto stdstrings = make(static_cast<std::string *>(nullptr));
+  double elementwise_ns = sort_results(elementwise), relocating_ns = sort_results(relocating), stdstrings_ns = sort_results(stdstrings);
+  std::cout << "Sorting " << count << " results took " << elementwise_ns << " ns/result swapping elementwise, " << relocating_ns << " ns/result swapping by relocation (" << (elementwise_ns / relocating_ns)
+            << "x), and " << stdstrings_ns << " ns/result for std::string which is " << (detail::use_relocating_swap<std::string>::value ? "" : "not ") << "swapped by relocation." << std::endl;
+  for(size_t n = 0; n < count; n++)
+  {
+    BOOST_REQUIRE(elementwise[n].has_value() == relocating[n].has_value());
+    BOOST_REQUIRE(elementwise[n].has_value() == stdstrings[n].has_value());
+    if(elementwise[n].has_value())
+    {
+      BOOST_REQUIRE(*elementwise[n].value().s == *relocating[n].value().s);
+      BOOST_REQUIRE(*elementwise[n].value().s == stdstrings[n].value());
+    }
+    else
+    {
+      BOOST_REQUIRE(elementwise[n].error() == relocating[n].error());
+    }
+  }
+}
@@ -0,0 +1,323 @@
+/* Unit testing for outcomes
+(C) 2019 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file Licence.txt or copy at
+          http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/outcome/result.hpp"
+#include "../../include/outcome/when_all.hpp"
+#include "quickcpplib/boost/test/unit_test.hpp"
+
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace when_all_test
+{
+  // Copies never throw, moves throw if asked to
+  struct fragile
+  {
+    int v;
+    bool explode{false};
+    fragile(int _v, bool _explode = false)
+        : v(_v)
+        , explode(_explode)
+    {
+    }
+    fragile(const fragile &o) noexcept
+        : v(o.v)
+        , explode(o.explode)
+    {
+    }
+    fragile(fragile &&o)
+        : v(o.v)
+        , explode(o.explode)
+    {
+      if(explode)
+      {
+        throw std::runtime_error("fragile");
+      }
+    }
+    fragile &operator=(const fragile &) = default;
+  };
+}  // namespace when_all_test
+
+#if OUTCOME_HAVE_COROUTINES
+namespace when_all_test
+{
+  struct task
+  {
+    struct promise_type
+    {
+      task get_return_object() { return {}; }
+      OUTCOME_COROUTINE_NAMESPACE::suspend_never initial_suspend() noexcept { return {}; }
+      OUTCOME_COROUTINE_NAMESPACE::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() {}
+      void unhandled_exception() { std::terminate(); }
+    };
+  };
+  template <class Slots, class Out> inline task await_all(Slots &slots, Out &out, bool &done)
+  {
+    out = co_await OUTCOME_V2_NAMESPACE::co_when_all(slots.begin(), slots.end());
+    done = true;
+  }
+  template <class Slots, class Out> inline task await_any(Slots &slots, Out &out, bool &done)
+  {
+    out = co_await OUTCOME_V2_NAMESPACE::co_when_any(slots.begin(), slots.end());
+    done = true;
+  }
+  // An awaitable whose result throws
+  struct throwing_awaitable
+  {
+    bool await_ready() const noexcept { return true; }
+    void await_suspend(OUTCOME_COROUTINE_NAMESPACE::coroutine_handle<> /*unused*/) noexcept {}
+    OUTCOME_V2_NAMESPACE::result<int> await_resume() { throw std::runtime_error("source"); }
+  };
+  template <class Awaitables> inline task await_all_catching(Awaitables &awaitables, bool &threw)
+  {
+    try
+    {
+      (void) co_await OUTCOME_V2_NAMESPACE::co_when_all(awaitables.begin(), awaitables.end());
+    }
+    catch(const std::runtime_error & /*unused*/)
+    {
+      threw = true;
+    }
+  }
+}  // namespace when_all_test
+#endif
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works / result / when_all, "Tests that when_all and when_any decide on the first failure or success")
+{
+  using namespace OUTCOME_V2_NAMESPACE;
+  const auto einval = make_error_code(std::errc::invalid_argument);
+  // Groups fed by threads
+  {
+    when_all_group<result<std::string>> group(100);
+    std::vector<std::thread> threads;
+    for(size_t t = 0; t < 4; t++)
+    {
+      threads.emplace_back([&, t] {
+        auto producer = group.get_producer();
+        for(size_t i = t; i < 100; i += 4)
+        {
+          producer.set(i, std::to_string(i));
+        }
+      });
+    }
+    auto &r = group.wait();
+    BOOST_REQUIRE(r.has_value());
+    BOOST_REQUIRE(r.value().size() == 100);
+    BOOST_CHECK(r.value()[0] == "0");
+    BOOST_CHECK(r.value()[99] == "99");
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+  }
+  {
+    when_all_group<result<int>> group(3);
+    auto producer = group.get_producer();
+    producer.set(0, 0);
+    BOOST_CHECK(!group.ready());
+    producer.set(2, einval);
+    BOOST_REQUIRE(group.ready());
+    BOOST_CHECK(group.cancelled());
+    BOOST_CHECK(group.index() == 2);
+    BOOST_CHECK(group.wait().error() == einval);
+    producer.discard();
+  }
+  {
+    when_any_group<result<int>> group(3);
+    auto producer = group.get_producer();
+    producer.set(0, einval);
+    BOOST_CHECK(!group.ready());
+    producer.set(1, 5);
+    BOOST_REQUIRE(group.ready());
+    BOOST_CHECK(group.index() == 1);
+    BOOST_CHECK(group.wait().value() == 5);
+    producer.set(2, 6);  // discarded
+    BOOST_CHECK(group.wait().value() == 5);
+  }
+  {
+    when_any_group<result<int>> group(2);
+    auto producer = group.get_producer();
+    producer.set(1, einval);
+    producer.set(0, make_error_code(std::errc::not_enough_memory));
+    BOOST_REQUIRE(group.ready());
+    BOOST_CHECK(group.index() == 0);
+    BOOST_CHECK(group.wait().error() == std::errc::not_enough_memory);
+  }
+  {
+    // Empty, and void values
+    when_all_group<result<int>> empty(0);
+    BOOST_REQUIRE(empty.ready());
+    BOOST_CHECK(empty.wait().value().empty());
+    when_all_group<result<void>> group(2);
+    group.get_producer().set(0, success());
+    group.get_producer().set(1, success());
+    BOOST_CHECK(group.wait().has_value());
+  }
+  {
+    // Dropping the group before its producers report must neither crash nor leak
+    auto *group = new when_all_group<result<std::string>>(2);
+    auto producer = group->get_producer();
+    producer.set(0, std::string(100, 'a'));
+    delete group;
+    BOOST_CHECK(producer.cancelled());
+    producer.set(1, std::string(100, 'b'));
+  }
+  {
+    // A when_any with nothing to wait upon could never be decided
+    BOOST_CHECK_THROW(when_any_group<result<int>>(0), std::invalid_argument);
+    std::vector<result_slot<int>> none;
+    BOOST_CHECK_THROW(when_any(none.begin(), none.end()), std::invalid_argument);
+  }
+
+  {
+    // Making the result of the group throws, so it is decided by that exception
+    using when_all_test::fragile;
+    when_all_group<result<fragile>> group(2);
+    auto producer = group.get_producer();
+    const fragile f0(0), f1(1, true);
+    producer.set(0, f0);
+    producer.set(1, f1);
+    BOOST_REQUIRE(group.ready());
+    BOOST_CHECK_THROW(group.wait(), std::runtime_error);
+    BOOST_CHECK_THROW(group.take(), std::runtime_error);
+    BOOST_CHECK_THROW(group.try_get(), std::runtime_error);
+  }
+  {
+    // As it is if constructing a result throws, which set() also rethrows
+    using when_all_test::fragile;
+    when_any_group<result<fragile>> group(2);
+    auto producer = group.get_producer();
+    BOOST_CHECK_THROW(producer.set(0, fragile(0, true)), std::runtime_error);
+    BOOST_REQUIRE(group.ready());
+    BOOST_CHECK_THROW(group.wait(), std::runtime_error);
+    producer.set(1, fragile(1));  // discarded
+  }
+  {
+    // Or if a producer reports one
+    when_all_group<result<int>> group(2);
+    auto producer = group.get_producer();
+    producer.set_exception(std::make_exception_ptr(std::logic_error("producer")));
+    BOOST_REQUIRE(group.ready());
+    BOOST_CHECK_THROW(group.wait(), std::logic_error);
+    producer.set(1, 5);  // discarded
+    BOOST_CHECK_THROW(group.wait(), std::logic_error);
+  }
+
+  // Blocking waits upon futures and slots
+  {
+    std::vector<std::promise<result<int>>> promises(10);
+    std::vector<std::future<result<int>>> futures;
+    for(auto &p : promises)
+    {
+      futures.push_back(p.get_future());
+    }
+    std::thread producer([&] {
+      for(size_t i = 0; i < promises.size(); i++)
+      {
+        promises[i].set_value(static_cast<int>(i));
+      }
+    });
+    auto r = when_all(futures.begin(), futures.end());
+    producer.join();
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value().size() == 10);
+    BOOST_CHECK(r.value()[9] == 9);
+  }
+  {
+    // A source which throws must not leak the group
+    std::vector<std::future<result<int>>> futures;
+    {
+      std::promise<result<int>> p0, p1;
+      futures.push_back(p0.get_future());
+      futures.push_back(p1.get_future());
+      p1.set_value(1);
+    }
+    BOOST_CHECK_THROW(when_all(futures.begin(), futures.end()), std::future_error);
+  }
+  {
+    std::vector<result_slot<int>> slots(10);
+    slots[7].emplace_error(einval);
+    auto r = when_all(slots.begin(), slots.end());
+    BOOST_CHECK(r.error() == einval);
+    slots[3].emplace_value(3);
+    auto r2 = when_any(slots.begin(), slots.end());
+    BOOST_CHECK(r2.value() == 3);
+  }
+
+#if OUTCOME_HAVE_COROUTINES
+  // Coroutine awaiting of slots
+  {
+    std::vector<result_slot<int>> slots(5);
+    result<std::vector<int>> out{std::vector<int>{}};
+    bool done = false;
+    when_all_test::await_all(slots, out, done);
+    BOOST_CHECK(!done);
+    std::thread producer([&] {
+      for(size_t i = 0; i < slots.size(); i++)
+      {
+        slots[i].emplace_value(static_cast<int>(i) * 2);
+      }
+    });
+    producer.join();
+    BOOST_REQUIRE(done);
+    BOOST_REQUIRE(out.has_value());
+    BOOST_CHECK(out.value().size() == 5);
+    BOOST_CHECK(out.value()[4] == 8);
+  }
+  {
+    std::vector<result_slot<int>> slots(5);
+    result<std::vector<int>> out{std::vector<int>{}};
+    bool done = false;
+    when_all_test::await_all(slots, out, done);
+    slots[2].emplace_error(einval);
+    BOOST_REQUIRE(done);
+    BOOST_CHECK(out.error() == einval);
+    // The remainder must still complete, their results being discarded
+    for(size_t i : {0, 1, 3, 4})
+    {
+      slots[i].emplace_value(1);
+    }
+  }
+  {
+    std::vector<result_slot<int>> slots(3);
+    result<int> out{0};
+    bool done = false;
+    slots[1].emplace_value(42);
+    when_all_test::await_any(slots, out, done);
+    BOOST_REQUIRE(done);
+    BOOST_CHECK(out.value() == 42);
+    slots[0].emplace_value(1);
+    slots[2].emplace_value(1);
+  }
+  {
+    // An awaitable which throws resumes the awaiting coroutine, which rethrows
+    std::vector<when_all_test::throwing_awaitable> awaitables(3);
+    bool threw = false;
+    when_all_test::await_all_catching(awaitables, threw);
+    BOOST_CHECK(threw);
+  }
+#endif
+}